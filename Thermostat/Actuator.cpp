@@ -88,6 +88,31 @@ void Actuator::actuate(Actuator::Actions const &actions)
     }
 }
 
+bool Actuator::transition(Actuator::Pattern const pattern)
+{
+    if (_patterned && (pattern == _pattern)) return false;
+
+    Actuator::Pattern const changes = _patterned? (pattern ^ _pattern) : ~Actuator::Pattern(0);
+
+    _actuateTime = micros(); // Update actuation time to now.
+
+    for (std::size_t index = 0; index < _outputs.size(); index++)
+    {
+        if (!(changes & (Actuator::Pattern(1) << index))) continue;
+        if (!_outputs[index]) continue; // If not ours, skip the pin.
+        _outputs[index]->setConfiguration({Pin::Mode::Output, static_cast<Pin::Value>((pattern >> index) & 1)});
+    }
+
+    _pattern = pattern;
+    _patterned = true;
+    return true;
+}
+
+Actuator::Pattern Actuator::pattern() const
+{
+    return _pattern;
+}
+
 int Actuator::Event::execute(Scheduler::Time const time)
 {
     // The following done to suppress unused variable warnings.
@@ -120,10 +145,18 @@ Actuator::Event::~Event()
 Actuator::Actuator(Pin::Arrangement const &pins, Scheduler::Time const actuateTimeout):
 pinout(pins),
 _pins(Pin::MakeSet(pins)),
+_pattern(0),
+_patterned(false),
 _actuateTimeout(actuateTimeout),
 // The following will force the instance to be ready as soon as it's initialized.
 _actuateTime(std::numeric_limits<Scheduler::Time>::max() - (actuateTimeout - 1))
 {
+    for (std::size_t index = 0; (index < pinout.size()) && (index < (sizeof(Actuator::Pattern) * 8)); index++)
+    {
+        Pin::Set::const_iterator const pin = _pins.find(pinout[index]);
+        _outputs.push_back((pin != _pins.end())? pin->second : nullptr);
+    }
+
     _scheduler.addDelegate(std::static_pointer_cast<SchedulerDelegate>(std::static_pointer_cast<Actuator>(self())));
 }
 #ifdef RESTORE_max_P2
@@ -133,6 +166,9 @@ _actuateTime(std::numeric_limits<Scheduler::Time>::max() - (actuateTimeout - 1))
 Actuator::Actuator(Actuator const &actuator):
 pinout(actuator.pinout),
 _pins(actuator._pins),
+_outputs(actuator._outputs),
+_pattern(actuator._pattern),
+_patterned(actuator._patterned),
 _actuateTimeout(actuator._actuateTimeout),
 _actuateTime(actuator._actuateTime)
 {
@@ -13,6 +13,7 @@
 #include <vector>
 #include <utility>
 #include <limits>
+#include <cstdint>
 #include "Development.hpp"
 #include "Pin.hpp"
 #include "Scheduler.hpp"
@@ -53,10 +54,22 @@ public:
     
     typedef std::vector<Action> Actions;
 
+    // A Pattern holds the output level of every pin in the pinout at once, with
+    // bit i being the level of pinout[i]; pinouts of up to 32 pins are covered.
+    typedef uint32_t Pattern;
+
     Pin::Arrangement const pinout;
     
     virtual Status status() const;
     virtual void actuate(Actions const &actions);
+
+    // Drives every pin in the pinout to its level in the pattern, immediately.
+    // Only pins whose level changed are written, and nothing is written (nor is
+    // the actuation timeout restarted) if the pattern is already in effect.
+    // Unlike actuate(...), transitions never allocate, which suits a control
+    // loop applying its decision every cycle; returns whether anything changed.
+    virtual bool transition(Pattern const pattern);
+    Pattern pattern() const;
     
     Actuator(Pin::Arrangement const &pins, Scheduler::Time const actuateTimeout = 0);
     Actuator(Actuator const &actuator);
@@ -81,6 +94,11 @@ protected:
     };
     
     Pin::Set _pins;
+
+    // The pinout's pins in pinout order, resolved once, for transitions.
+    std::vector<std::shared_ptr<Pin>> _outputs;
+    Pattern _pattern;
+    bool _patterned;    // Whether a transition has set the pattern yet.
     
     Scheduler::Time const _actuateTimeout;
     Scheduler::Time _actuateTime;
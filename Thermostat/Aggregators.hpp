@@ -0,0 +1,394 @@
+//
+//  Aggregators.hpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef Aggregators_hpp
+#define Aggregators_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include "Development.hpp"
+
+// NOTE: The aggregators below are updated one value at a time, and keep all
+// of their state in fixed-size members; updates never allocate, and take at
+// most O(log Window) time.
+
+// =============================================================================
+// ExponentialAverage : This class keeps an exponential moving average; every
+// update moves the average by alpha (0, 1] of the way towards the new value.
+// =============================================================================
+template<typename NumericType>
+class ExponentialAverage
+{
+public:
+
+    NumericType value() const
+    {
+        return _value;
+    }
+
+    bool primed() const
+    {
+        return _primed;
+    }
+
+    NumericType alpha() const
+    {
+        return _alpha;
+    }
+
+    void setAlpha(NumericType const alpha)
+    {
+        _alpha = alpha;
+    }
+
+    NumericType update(NumericType const value)
+    {
+        // The first value seeds the average, rather than pulling it from zero.
+        _value = _primed? _value + _alpha * (value - _value) : value;
+        _primed = true;
+        return _value;
+    }
+
+    void clear()
+    {
+        _value = NumericType();
+        _primed = false;
+    }
+
+    ExponentialAverage(NumericType const alpha = 0.25):
+    _alpha(alpha),
+    _value(),
+    _primed(false)
+    {
+
+    }
+
+protected:
+
+    NumericType _alpha;
+    NumericType _value;
+    bool _primed;
+};
+
+// =============================================================================
+// MovingMedian : This class keeps the median of the last Window values. Values
+// live in a ring, split across a max-heap of the lower half and a min-heap of
+// the upper half, each holding ring slots; every slot knows where it is in its
+// heap, so the oldest value is replaced in place rather than searched for.
+// =============================================================================
+template<typename NumericType, std::size_t Window>
+class MovingMedian
+{
+    static_assert(Window > 0, "A moving median needs a window of at least one value.");
+
+public:
+
+    std::size_t size() const
+    {
+        return _size;
+    }
+
+    bool full() const
+    {
+        return _size == Window;
+    }
+
+    // The median of the values in the window, or zero if there's none.
+    NumericType value() const
+    {
+        if (!_size) return NumericType();
+
+        if (_count[Low] > _count[High]) return _values[_heaps[Low][0]];
+
+        return (_values[_heaps[Low][0]] + _values[_heaps[High][0]]) / 2;
+    }
+
+    void update(NumericType const value)
+    {
+        std::size_t const slot = _next;
+        _next = (_next + 1) % Window;
+
+        _values[slot] = value;
+
+        if (_size < Window) {
+            _size++;
+            _push(((!_count[Low]) || !(_values[_heaps[Low][0]] < value))? Low : High, slot);
+            _balance();
+        } else {
+            // The oldest value's slot is overwritten, then put back in order.
+            Heap const heap = _heap[slot];
+            _siftDown(heap, _siftUp(heap, _position[slot]));
+            _order();
+        }
+    }
+
+    void clear()
+    {
+        _size = 0;
+        _next = 0;
+        _count[Low] = 0;
+        _count[High] = 0;
+    }
+
+    MovingMedian():
+    _values(),
+    _size(0),
+    _next(0)
+    {
+        _count[Low] = 0;
+        _count[High] = 0;
+    }
+
+protected:
+
+    enum Heap
+    {
+        Low,    // Max-heap of the lower half.
+        High    // Min-heap of the upper half.
+    };
+
+    NumericType _values[Window];    // The ring of values, by slot.
+    std::size_t _heaps[2][Window];  // The slots in each heap.
+    std::size_t _count[2];          // The number of slots in each heap.
+    std::size_t _position[Window];  // Each slot's position within its heap.
+    Heap _heap[Window];             // Each slot's heap.
+    std::size_t _size;
+    std::size_t _next;              // The next (oldest) slot to write to.
+
+    // Whether a is to be above b in the heap; the greater for the lower half.
+    bool _above(Heap const heap, std::size_t const a, std::size_t const b) const
+    {
+        return (heap == Low)? (_values[_heaps[heap][b]] < _values[_heaps[heap][a]]) :
+                              (_values[_heaps[heap][a]] < _values[_heaps[heap][b]]);
+    }
+
+    void _place(Heap const heap, std::size_t const position, std::size_t const slot)
+    {
+        _heaps[heap][position] = slot;
+        _position[slot] = position;
+        _heap[slot] = heap;
+    }
+
+    void _swap(Heap const heap, std::size_t const a, std::size_t const b)
+    {
+        std::size_t const slot = _heaps[heap][a];
+        _place(heap, a, _heaps[heap][b]);
+        _place(heap, b, slot);
+    }
+
+    std::size_t _siftUp(Heap const heap, std::size_t position)
+    {
+        while (position && _above(heap, position, (position - 1) / 2))
+        {
+            _swap(heap, position, (position - 1) / 2);
+            position = (position - 1) / 2;
+        }
+        return position;
+    }
+
+    std::size_t _siftDown(Heap const heap, std::size_t position)
+    {
+        for (;;)
+        {
+            std::size_t top = position;
+            std::size_t const left = 2 * position + 1;
+            std::size_t const right = left + 1;
+
+            if ((left < _count[heap]) && _above(heap, left, top)) top = left;
+            if ((right < _count[heap]) && _above(heap, right, top)) top = right;
+            if (top == position) return position;
+
+            _swap(heap, position, top);
+            position = top;
+        }
+    }
+
+    void _push(Heap const heap, std::size_t const slot)
+    {
+        _place(heap, _count[heap]++, slot);
+        _siftUp(heap, _count[heap] - 1);
+    }
+
+    std::size_t _pop(Heap const heap)
+    {
+        std::size_t const slot = _heaps[heap][0];
+        _place(heap, 0, _heaps[heap][--_count[heap]]);
+        _siftDown(heap, 0);
+        return slot;
+    }
+
+    // Keeps the lower half as large as the upper half, or one larger.
+    void _balance()
+    {
+        if (_count[Low] > (_count[High] + 1)) _push(High, _pop(Low));
+        else
+        if (_count[High] > _count[Low]) _push(Low, _pop(High));
+    }
+
+    // Restores every lower value being at most every upper value, which only
+    // a replaced value can upset; it'd be at the top of its heap if it did.
+    void _order()
+    {
+        if (!_count[High]) return;
+
+        std::size_t const low = _heaps[Low][0];
+        std::size_t const high = _heaps[High][0];
+        if (!(_values[high] < _values[low])) return;
+
+        _place(Low, 0, high);
+        _place(High, 0, low);
+        _siftDown(Low, 0);
+        _siftDown(High, 0);
+    }
+};
+
+// =============================================================================
+// OutlierFilter : This class rejects values further from the window's median
+// than threshold times its median absolute deviation (MAD), scaled to match a
+// standard deviation, replacing them with the median (a Hampel filter).
+// NOTE: The MAD is approximated by the median of each value's deviation from
+// the median at the time it arrived, keeping updates at O(log Window).
+// Rejected values still enter the window, so a lasting change is accepted
+// once it makes up enough of the window, rather than being rejected forever.
+// =============================================================================
+template<typename NumericType, std::size_t Window>
+class OutlierFilter
+{
+public:
+
+    // The median of the last Window values, outliers included.
+    NumericType median() const
+    {
+        return _values.value();
+    }
+
+    bool rejected() const
+    {
+        return _rejected;
+    }
+
+    uint32_t rejections() const
+    {
+        return _rejections;
+    }
+
+    // Returns the value given, or the median, if the value is an outlier.
+    NumericType update(NumericType const value)
+    {
+        NumericType const median = _values.value();
+        NumericType const deviation = (value < median)? median - value : value - median;
+
+        // Values are only judged once there's a full window to judge them by.
+        _rejected = false;
+        if (_values.full())
+        {
+            NumericType limit = _threshold * _deviations.value() * _Consistency;
+            if (limit < _minimumDeviation) limit = _minimumDeviation;
+            _rejected = limit < deviation;
+        }
+
+        _values.update(value);
+        _deviations.update(_values.size() > 1? deviation : NumericType());
+
+        if (!_rejected) return value;
+
+        _rejections++;
+        return median;
+    }
+
+    void clear()
+    {
+        _values.clear();
+        _deviations.clear();
+        _rejected = false;
+    }
+
+    // Deviations at or below minimumDeviation are never rejected, so that
+    // steady values (with a MAD of 0) don't reject the slightest change.
+    OutlierFilter(NumericType const threshold = 3, NumericType const minimumDeviation = 0):
+    _threshold(threshold),
+    _minimumDeviation(minimumDeviation),
+    _rejected(false),
+    _rejections(0)
+    {
+
+    }
+
+protected:
+
+    // Scales a MAD to match a standard deviation; a constant, so that fixed
+    // point filters needn't convert it every update.
+    static constexpr NumericType _Consistency = NumericType(1.4826f);
+
+    MovingMedian<NumericType, Window> _values;
+    MovingMedian<NumericType, Window> _deviations;
+    NumericType _threshold;
+    NumericType _minimumDeviation;
+    bool _rejected;
+    uint32_t _rejections;
+};
+
+template<typename NumericType, std::size_t Window>
+constexpr NumericType OutlierFilter<NumericType, Window>::_Consistency;
+
+// =============================================================================
+// ReadingFilter : This class smooths noisy readings; outliers are rejected,
+// then the remaining readings are averaged exponentially.
+// =============================================================================
+template<typename NumericType, std::size_t Window>
+class ReadingFilter
+{
+public:
+
+    NumericType value() const
+    {
+        return _average.value();
+    }
+
+    NumericType median() const
+    {
+        return _outliers.median();
+    }
+
+    bool primed() const
+    {
+        return _average.primed();
+    }
+
+    OutlierFilter<NumericType, Window> const &outliers() const
+    {
+        return _outliers;
+    }
+
+    NumericType update(NumericType const value)
+    {
+        return _average.update(_outliers.update(value));
+    }
+
+    void clear()
+    {
+        _outliers.clear();
+        _average.clear();
+    }
+
+    ReadingFilter(NumericType const alpha = 0.25,
+                  NumericType const threshold = 3,
+                  NumericType const minimumDeviation = 0):
+    _outliers(threshold, minimumDeviation),
+    _average(alpha)
+    {
+
+    }
+
+protected:
+
+    OutlierFilter<NumericType, Window> _outliers;
+    ExponentialAverage<NumericType> _average;
+};
+
+#endif /* Aggregators_hpp */
@@ -0,0 +1,248 @@
+//
+//  AggregatorsTester.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "Development.hpp"
+
+#if ! defined(MJB_ARDUINO_LIB_API)
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <random>
+#include <vector>
+#include "Aggregators.hpp"
+#include "FixedPoint.hpp"
+#include "Thermostat.hpp"
+#include "Testing.hpp"
+
+static Scheduler::Time now = 1000;
+
+Scheduler::Time micros()
+{
+    return now;
+}
+
+typedef Thermometer::TemperatureUnit TemperatureUnit;
+
+// The median of the values, by sorting them; the mean of the middle two when
+// there's an even number of them, as MovingMedian has it.
+template<typename NumericType>
+static NumericType Median(std::deque<NumericType> const &window)
+{
+    std::vector<NumericType> values(window.begin(), window.end());
+    std::sort(values.begin(), values.end());
+
+    std::size_t const middle = values.size() / 2;
+    return (values.size() % 2)? values[middle] : (values[middle - 1] + values[middle]) / 2;
+}
+
+// Whether the moving median matches the sorted window's, value after value,
+// across refills following a clear; the values are few, so ties are many.
+template<typename NumericType, std::size_t Window>
+static bool Matches(std::mt19937 &random, std::size_t const updates)
+{
+    MovingMedian<NumericType, Window> median;
+    std::deque<NumericType> window;
+    bool matched = (median.value() == NumericType()) && !median.size();
+
+    for (std::size_t index = 0; index < updates; index++)
+    {
+        if (index == (updates / 2))
+        {
+            median.clear();
+            window.clear();
+        }
+
+        NumericType const value = NumericType(static_cast<int>(random() % 41) - 20) / 4;
+        median.update(value);
+        window.push_back(value);
+        if (window.size() > Window) window.pop_front();
+
+        matched = matched && (median.size() == window.size()) && (median.full() == (window.size() == Window)) &&
+                  (median.value() == Median(window));
+    }
+
+    return matched;
+}
+
+// Reads the temperature it's set to every time it's sensed.
+class Scripted : public Thermometer
+{
+public:
+
+    TemperatureUnit reading = TemperatureUnit(70, TemperatureUnit::Scale::Fahrenheit);
+
+    Sensor::Data sense()
+    {
+        _temperature = reading;
+        _humidity = 40;
+        _recordReading();
+        return Sensor::Data();
+    }
+
+    Scripted():
+    Thermometer({})
+    {
+
+    }
+};
+
+int main(int argc, const char * argv[])
+{
+    std::mt19937 random(38);
+
+    // Moving medians match a brute force window of the last values, whether
+    // the window's odd or even, in float and fixed point.
+    MJB_CHECK((Matches<float, 3>(random, 1000)));
+    MJB_CHECK((Matches<float, 2>(random, 1000)));
+    MJB_CHECK((Matches<float, 5>(random, 10000)));
+    MJB_CHECK((Matches<float, 8>(random, 10000)));
+    MJB_CHECK((Matches<float, 31>(random, 10000)));
+    MJB_CHECK((Matches<FixedPoint, 5>(random, 10000)));
+    MJB_CHECK((Matches<FixedPoint, 8>(random, 10000)));
+
+    // Exponential averages are seeded by their first value, then move alpha
+    // of the way towards every new one.
+    ExponentialAverage<float> average(0.25f);
+    MJB_CHECK(!average.primed());
+    MJB_CHECK(average.update(8) == 8);
+    MJB_CHECK(average.primed());
+    MJB_CHECK(average.update(16) == 10);
+    MJB_CHECK(average.update(2) == 8);
+    average.clear();
+    MJB_CHECK(!average.primed() && (average.update(4) == 4));
+
+    // Outliers are judged once the window's full, against its median and
+    // deviation; a spike is rejected and replaced by the median, and counted.
+    OutlierFilter<float, 5> outliers(3, 0.5f);
+    float const steady[] = {20.0f, 20.2f, 19.8f, 20.1f, 19.9f};
+
+    MJB_CHECK(outliers.update(30) == 30); // Not judged; the window's empty.
+    MJB_CHECK(!outliers.rejected());
+    outliers.clear();
+
+    bool accepted = true;
+    for (float const value : steady) accepted = accepted && (outliers.update(value) == value) && !outliers.rejected();
+    MJB_CHECK(accepted);
+
+    MJB_CHECK(outliers.update(20.3f) == 20.3f);
+    MJB_CHECK(!outliers.rejected());
+    float const median = outliers.median();
+    MJB_CHECK(outliers.update(35) == median);
+    MJB_CHECK(outliers.rejected() && (outliers.rejections() == 1));
+    MJB_CHECK(outliers.update(20) == 20);
+    MJB_CHECK(!outliers.rejected());
+
+    // Steady values, with no deviation at all, don't reject changes within the
+    // minimum deviation; lasting changes are accepted once they make up most
+    // of the window.
+    OutlierFilter<float, 5> level(3, 0.5f);
+    for (unsigned index = 0; index < 5; index++) level.update(20);
+    MJB_CHECK((level.update(20.5f) == 20.5f) && !level.rejected());
+    MJB_CHECK((level.update(20) == 20) && !level.rejected());
+
+    std::size_t const rejections = level.rejections();
+    std::size_t changed = 0;
+    while ((changed < 5) && (level.update(25) != 25)) changed++;
+    MJB_CHECK((changed > 0) && (changed < 5));
+    MJB_CHECK(level.rejections() == (rejections + changed));
+
+    // Reading filters average what the outlier filter lets through; spikes
+    // leave the average be.
+    ReadingFilter<float, 5> filter(0.5f, 3, 0.5f);
+    ExponentialAverage<float> expected(0.5f);
+    std::normal_distribution<float> noise(0, 0.1f);
+    bool tracked = true, spiked = false;
+
+    for (std::size_t index = 0; index < 1000; index++)
+    {
+        bool const spike = (index > 10) && !(index % 50);
+        float const value = 20 + noise(random) + (spike? 10 : 0);
+        float const median = filter.median();
+        float const smoothed = filter.update(value);
+
+        tracked = tracked && (filter.outliers().rejected() == spike) &&
+                  (smoothed == expected.update(spike? median : value)) &&
+                  (std::fabs(smoothed - 20) < 0.5f);
+        spiked = spiked || spike;
+    }
+
+    MJB_CHECK(tracked && spiked);
+    MJB_CHECK(filter.primed());
+    filter.clear();
+    MJB_CHECK(!filter.primed());
+
+    // Controlling by smoothed samples, a single spiking reading doesn't set
+    // the thermostat cooling, as the latest samples' mean does.
+    for (Thermostat::Aggregation const aggregation : {Thermostat::Aggregation::Mean, Thermostat::Aggregation::Smoothed})
+    {
+        std::shared_ptr<Scripted> const thermometer = std::make_shared<Scripted>();
+        Thermostat thermostat({14, 12, 13}, {thermometer}, 5000000);
+        thermostat.setAggregation(aggregation);
+        thermostat.setMode(Thermostat::Mode::Cool);
+        thermostat.setTargetTemperature(TemperatureUnit(75, TemperatureUnit::Scale::Fahrenheit));
+        thermostat.setTargetTemperatureThreshold(std::make_pair(1, TemperatureUnit::Scale::Fahrenheit));
+
+        for (unsigned cycle = 0; cycle < 10; cycle++) Scheduler::UpdateInstances(now += 5000000);
+        MJB_CHECK(thermostat.status() == Thermostat::Status::Standby);
+
+        thermometer->reading = TemperatureUnit(90, TemperatureUnit::Scale::Fahrenheit);
+        Scheduler::UpdateInstances(now += 5000000);
+        thermometer->reading = TemperatureUnit(70, TemperatureUnit::Scale::Fahrenheit);
+
+        bool const smoothed = (aggregation == Thermostat::Aggregation::Smoothed);
+        MJB_CHECK(thermostat.status() == (smoothed? Thermostat::Status::Standby : Thermostat::Status::Cooling));
+        MJB_CHECK(std::fabs(static_cast<float>(thermostat.smoothedTemperature().value(TemperatureUnit::Scale::Fahrenheit)) - 70) < 0.1f);
+
+        // A lasting change is acted on all the same, if a few cycles later.
+        thermometer->reading = TemperatureUnit(90, TemperatureUnit::Scale::Fahrenheit);
+        for (unsigned cycle = 0; cycle < 10; cycle++) Scheduler::UpdateInstances(now += 5000000);
+        MJB_CHECK(thermostat.status() == Thermostat::Status::Cooling);
+    }
+
+    // Update time for each aggregator, over a typical window.
+    if (Testing::Benchmarking(argc, argv))
+    {
+        std::size_t const updates = 10000000;
+        std::vector<float> values(4096);
+        for (float &value : values) value = 20 + noise(random);
+
+        MovingMedian<float, 5> median;
+        ReadingFilter<float, 5> readings(0.5f, 3, 0.5f);
+        float checksum = 0;
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (std::size_t index = 0; index < updates; index++)
+        {
+            median.update(values[index % 4096]);
+            checksum += median.value();
+        }
+        double const medians = Testing::Seconds(start);
+
+        start = std::chrono::steady_clock::now();
+        for (std::size_t index = 0; index < updates; index++)
+        {
+            checksum += readings.update(values[index % 4096]);
+        }
+        double const filters = Testing::Seconds(start);
+
+        std::fprintf(stderr, "MovingMedian<5>: %.1f ns/update, ReadingFilter<5>: %.1f ns/update (%g)\n",
+                     medians * 1e9 / updates, filters * 1e9 / updates, checksum);
+    }
+
+    return Testing::Result("AggregatorsTester");
+}
+
+#else
+
+int main()
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,117 @@
+//
+//  AllocationTester.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "Development.hpp"
+
+#if ! defined(MJB_ARDUINO_LIB_API)
+
+#include <cstdlib>
+#include <new>
+#include "DHT22.hpp"
+#include "Thermostat.hpp"
+#include "Testing.hpp"
+
+// Every allocation made by the program is counted, so that a stretch of code
+// can be checked to make none.
+static std::size_t allocations = 0;
+
+void *operator new(std::size_t size)
+{
+    allocations++;
+    if (void * const memory = std::malloc(size? size : 1)) return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+static Scheduler::Time now = 0;
+
+Scheduler::Time micros()
+{
+    return now += 10;
+}
+
+// Exposes the publishing of a sensed frame.
+struct Probe : DHT22
+{
+    using DHT22::_publish;
+
+    Probe(Pin::Identifier const identifier):
+    DHT22(identifier)
+    {
+
+    }
+};
+
+// Reads the same temperature and humidity every time it's sensed.
+class Steady : public Thermometer
+{
+public:
+
+    Sensor::Data sense()
+    {
+        _temperature = Thermometer::TemperatureUnit(21.5, Thermometer::TemperatureUnit::Scale::Celsius);
+        _humidity = 40;
+        _recordReading();
+        return Sensor::Data();
+    }
+
+    Steady():
+    Thermometer({})
+    {
+
+    }
+};
+
+int main(int argc, const char * argv[])
+{
+    // The following done to suppress unused variable warnings.
+    (void) argc;
+    (void) argv;
+
+    // Sensing, and publishing what's sensed, allocates nothing.
+    Probe sensor(1);
+    Sensor::Byte const bytes[] = {0x02, 0x8C, 0x00, 0xE5, 0x73}; // 65.2%, 22.9C
+    Sensor::View const frame(bytes, sizeof(bytes));
+    std::size_t const count = 100;
+
+    std::size_t start = allocations;
+    for (std::size_t reading = 0; reading < count; reading++)
+    {
+        MJB_CHECK(sensor.sense().empty()); // Host pins never answer.
+        MJB_CHECK(sensor._publish(frame));
+        now += 2000000; // Past the sensor's cool down.
+    }
+    MJB_CHECK(allocations == start);
+    MJB_CHECK(sensor.health().readings == count);
+
+    // Neither does a thermostat's control cycle, once its status is settled,
+    // though setting it up does (as counted, which goes to show it's counting).
+    start = allocations;
+    std::shared_ptr<Steady> const thermometer = std::make_shared<Steady>();
+    Thermostat thermostat({3, 4, 5}, {thermometer, std::make_shared<Steady>()});
+    thermostat.setMode(Thermostat::Mode::Auto);
+    MJB_CHECK(allocations > start);
+
+    for (std::size_t cycle = 0; cycle < 4; cycle++) thermostat.update(now += 300000000);
+    uint32_t const version = thermostat.snapshot()->version();
+    uint32_t const sequence = thermometer->sample().sequence;
+
+    start = allocations;
+    for (std::size_t cycle = 0; cycle < count; cycle++) thermostat.update(now += 300000000);
+    MJB_CHECK(allocations == start);
+    MJB_CHECK(thermostat.snapshot()->version() == version);
+    MJB_CHECK(thermometer->sample().sequence - sequence == count);
+
+    return Testing::Result("AllocationTester");
+}
+
+#endif
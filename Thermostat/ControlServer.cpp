@@ -0,0 +1,682 @@
+//
+//  ControlServer.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "ControlServer.hpp"
+
+#if defined(MJB_LINUX_EPOLL)
+
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <strings.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+constexpr std::size_t ControlServer::_HeadLimit;
+constexpr std::size_t ControlServer::_BodyLimit;
+constexpr std::size_t ControlServer::_OutputLimit;
+constexpr std::size_t ControlServer::_ReadSize;
+constexpr int ControlServer::_EventsMax;
+
+
+// =============================================================================
+// ControlServer : Implementation
+// =============================================================================
+bool ControlServer::add(ControlServer::Zone const zone, Thermostat &thermostat)
+{
+    return _zones.emplace(zone, &thermostat).second;
+}
+
+bool ControlServer::remove(ControlServer::Zone const zone)
+{
+    return _zones.erase(zone);
+}
+
+bool ControlServer::listen(uint16_t const port, char const * const address)
+{
+    if (listening() || (_poll < 0)) return false;
+
+    int const listener = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listener < 0) return false;
+
+    int const enable = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    sockaddr_in socketAddress;
+    std::memset(&socketAddress, 0, sizeof(socketAddress));
+    socketAddress.sin_family = AF_INET;
+    socketAddress.sin_port = htons(port);
+    socketAddress.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = nullptr; // The listener's the only one without a connection.
+
+    if ((address && (inet_pton(AF_INET, address, &socketAddress.sin_addr) != 1)) ||
+        (bind(listener, reinterpret_cast<sockaddr const *>(&socketAddress), sizeof(socketAddress)) < 0) ||
+        (::listen(listener, SOMAXCONN) < 0) ||
+        (epoll_ctl(_poll, EPOLL_CTL_ADD, listener, &event) < 0))
+    {
+        close(listener);
+        return false;
+    }
+
+    _listener = listener;
+    return true;
+}
+
+bool ControlServer::listening() const
+{
+    return _listener >= 0;
+}
+
+std::size_t ControlServer::serve(int const timeout)
+{
+    if (_poll < 0) return 0;
+
+    epoll_event events[ControlServer::_EventsMax];
+    int const ready = epoll_wait(_poll, events, ControlServer::_EventsMax, timeout);
+    if (ready <= 0) return 0;
+
+    _refreshDate();
+
+    std::size_t answered = 0;
+
+    for (int index = 0; index < ready; index++)
+    {
+        if (!events[index].data.ptr)
+        {
+            _accept();
+            continue;
+        }
+
+        // Connections are only ever closed while handling their own event,
+        // and appear once per wait, so the rest of the events stay valid.
+        ControlServer::Connection &connection = *static_cast<ControlServer::Connection *>(events[index].data.ptr);
+        uint32_t const flags = events[index].events;
+
+        if (flags & EPOLLERR)
+        {
+            _close(connection);
+            continue;
+        }
+
+        if ((flags & EPOLLOUT) && !_send(connection)) continue;
+
+        if ((flags & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)) || connection.stalled)
+        {
+            answered += _receive(connection);
+        }
+    }
+
+    return answered;
+}
+
+std::size_t ControlServer::connections() const
+{
+    return _connections.size();
+}
+
+uint64_t ControlServer::requests() const
+{
+    return _requests;
+}
+
+void ControlServer::_accept()
+{
+    for (;;)
+    {
+        int const descriptor = accept4(_listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+        if (descriptor < 0)
+        {
+            if (errno == EINTR) continue;
+            return; // Either none are left, or none can be taken now.
+        }
+
+        if (_connections.size() >= _connectionsLimit)
+        {
+            close(descriptor);
+            continue;
+        }
+
+        // Responses are written whole, so there's nothing to gain by waiting.
+        int const enable = 1;
+        setsockopt(descriptor, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+        std::unique_ptr<ControlServer::Connection> connection(new ControlServer::Connection());
+        connection->descriptor = descriptor;
+        connection->written = 0;
+        connection->closing = false;
+        connection->stalled = false;
+
+        epoll_event event;
+        event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        event.data.ptr = connection.get();
+
+        if (epoll_ctl(_poll, EPOLL_CTL_ADD, descriptor, &event) < 0)
+        {
+            close(descriptor);
+            continue;
+        }
+
+        _connections.emplace(descriptor, std::move(connection));
+    }
+}
+
+void ControlServer::_close(ControlServer::Connection &connection)
+{
+    int const descriptor = connection.descriptor;
+
+    // Closing the descriptor removes it from the poll as well.
+    close(descriptor);
+    _connections.erase(descriptor);
+}
+
+std::size_t ControlServer::_receive(ControlServer::Connection &connection)
+{
+    std::size_t answered = 0;
+    char buffer[ControlServer::_ReadSize];
+
+    for (;;)
+    {
+        // What was left unanswered for the output to catch up goes first.
+        answered += _process(connection);
+
+        while (!connection.closing && !connection.stalled)
+        {
+            ssize_t const received = recv(connection.descriptor, buffer, sizeof(buffer), 0);
+
+            if (received > 0)
+            {
+                connection.input.append(buffer, static_cast<std::size_t>(received));
+                answered += _process(connection);
+                continue;
+            }
+
+            if (!received)
+            {
+                // The client's done sending; what it's asked for is still sent.
+                connection.closing = true;
+                break;
+            }
+
+            if (errno == EINTR) continue;
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) break;
+
+            _close(connection);
+            return answered;
+        }
+
+        if (!_send(connection)) return answered;
+
+        // Stalled connections carry on as soon as their output's all sent;
+        // otherwise, the poll tells when the socket can take more of it.
+        if (!connection.stalled || !connection.output.empty()) return answered;
+    }
+}
+
+std::size_t ControlServer::_process(ControlServer::Connection &connection)
+{
+    std::size_t answered = 0;
+    std::size_t offset = 0;
+
+    while (!connection.closing && (offset < connection.input.size()))
+    {
+        if ((connection.output.size() - connection.written) >= ControlServer::_OutputLimit) break;
+
+        ControlServer::Request request;
+        long const size = _parse(connection, connection.input.data() + offset, connection.input.size() - offset, request);
+
+        if (!size) break;
+
+        answered++;
+        if (size < 0) break;
+
+        _answer(connection, request);
+        offset += static_cast<std::size_t>(size);
+    }
+
+    connection.input.erase(0, offset);
+    connection.stalled = !connection.closing && ((connection.output.size() - connection.written) >= ControlServer::_OutputLimit);
+
+    return answered;
+}
+
+bool ControlServer::_send(ControlServer::Connection &connection)
+{
+    while (connection.written < connection.output.size())
+    {
+        ssize_t const sent = send(connection.descriptor,
+                                  connection.output.data() + connection.written,
+                                  connection.output.size() - connection.written,
+                                  MSG_NOSIGNAL);
+
+        if (sent >= 0)
+        {
+            connection.written += static_cast<std::size_t>(sent);
+            continue;
+        }
+
+        if (errno == EINTR) continue;
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) return true;
+
+        _close(connection);
+        return false;
+    }
+
+    connection.output.clear();
+    connection.written = 0;
+
+    if (connection.closing)
+    {
+        _close(connection);
+        return false;
+    }
+
+    return true;
+}
+
+long ControlServer::_parse(ControlServer::Connection &connection,
+                           char const * const data,
+                           std::size_t const size,
+                           ControlServer::Request &request)
+{
+    std::size_t const searched = (size < ControlServer::_HeadLimit)? size : ControlServer::_HeadLimit;
+    char const * const headEnd = static_cast<char const *>(memmem(data, searched, "\r\n\r\n", 4));
+
+    if (!headEnd)
+    {
+        if (size < ControlServer::_HeadLimit) return 0;
+
+        _respond(connection, "431 Request Header Fields Too Large", "text/plain", "Request too large!", 18, false);
+        return -1;
+    }
+
+    std::memset(&request, 0, sizeof(request));
+
+    // The request line: method, target and version, split by single spaces.
+    char const * const lineEnd = static_cast<char const *>(std::memchr(data, '\r', headEnd - data + 2));
+    char const * const methodEnd = static_cast<char const *>(std::memchr(data, ' ', lineEnd - data));
+    char const * const targetEnd = methodEnd? static_cast<char const *>(std::memchr(methodEnd + 1, ' ', lineEnd - methodEnd - 1)) : nullptr;
+
+    if (!targetEnd || (methodEnd == data) || (targetEnd == (methodEnd + 1)) ||
+        ((lineEnd - targetEnd - 1) != 8) || std::strncmp(targetEnd + 1, "HTTP/1.", 7) ||
+        ((targetEnd[8] != '0') && (targetEnd[8] != '1')))
+    {
+        _respond(connection, "400 Bad Request", "text/plain", "Bad request!", 12, false);
+        return -1;
+    }
+
+    request.method = data;
+    request.methodSize = methodEnd - data;
+    request.path = methodEnd + 1;
+
+    char const * const queryStart = static_cast<char const *>(std::memchr(request.path, '?', targetEnd - request.path));
+    request.pathSize = (queryStart? queryStart : targetEnd) - request.path;
+
+    if (queryStart)
+    {
+        request.query = queryStart + 1;
+        request.querySize = targetEnd - request.query;
+    }
+
+    // Connections are kept alive by default as of HTTP/1.1 only.
+    request.keepAlive = (targetEnd[8] == '1');
+
+    std::size_t contentLength = 0;
+
+    for (char const *line = lineEnd + 2; line < (headEnd + 2);)
+    {
+        char const * const end = static_cast<char const *>(std::memchr(line, '\r', headEnd + 2 - line));
+        char const * const colon = static_cast<char const *>(std::memchr(line, ':', end - line));
+
+        if (!colon)
+        {
+            _respond(connection, "400 Bad Request", "text/plain", "Bad request!", 12, false);
+            return -1;
+        }
+
+        char const *value = colon + 1;
+        char const *valueEnd = end;
+        while ((value < valueEnd) && ((*value == ' ') || (*value == '\t'))) value++;
+        while ((valueEnd > value) && ((valueEnd[-1] == ' ') || (valueEnd[-1] == '\t'))) valueEnd--;
+
+        std::size_t const nameSize = colon - line;
+        std::size_t const valueSize = valueEnd - value;
+
+        if (ControlServer::_Equals(line, nameSize, "connection"))
+        {
+            if (ControlServer::_Equals(value, valueSize, "close")) request.keepAlive = false;
+            else
+            if (ControlServer::_Equals(value, valueSize, "keep-alive")) request.keepAlive = true;
+        }
+        else
+        if (ControlServer::_Equals(line, nameSize, "if-none-match"))
+        {
+            request.ifNoneMatch = value;
+            request.ifNoneMatchSize = valueSize;
+        }
+        else
+        if (ControlServer::_Equals(line, nameSize, "content-length"))
+        {
+            char *parsedEnd = nullptr;
+            unsigned long const length = valueSize? std::strtoul(value, &parsedEnd, 10) : 0;
+
+            if ((parsedEnd != valueEnd) || (*value == '-'))
+            {
+                _respond(connection, "400 Bad Request", "text/plain", "Bad request!", 12, false);
+                return -1;
+            }
+
+            if (length > ControlServer::_BodyLimit)
+            {
+                _respond(connection, "413 Payload Too Large", "text/plain", "Request too large!", 18, false);
+                return -1;
+            }
+
+            contentLength = length;
+        }
+        else
+        if (ControlServer::_Equals(line, nameSize, "transfer-encoding"))
+        {
+            _respond(connection, "501 Not Implemented", "text/plain", "Chunked requests aren't supported!", 34, false);
+            return -1;
+        }
+
+        line = end + 2;
+    }
+
+    std::size_t const headSize = (headEnd - data) + 4;
+    if (size < (headSize + contentLength)) return 0;
+
+    request.body = data + headSize;
+    request.bodySize = contentLength;
+
+    return static_cast<long>(headSize + contentLength);
+}
+
+void ControlServer::_answer(ControlServer::Connection &connection, ControlServer::Request const &request)
+{
+    _requests++;
+
+    bool const get = ControlServer::_Equals(request.method, request.methodSize, "GET");
+    bool const head = !get && ControlServer::_Equals(request.method, request.methodSize, "HEAD");
+    bool const post = !get && !head && ControlServer::_Equals(request.method, request.methodSize, "POST");
+
+    bool const status = ControlServer::_Equals(request.path, request.pathSize, "/status");
+    bool const control = !status && ControlServer::_Equals(request.path, request.pathSize, "/control");
+
+    if (!status && !control)
+    {
+        _respond(connection, "404 Not Found", "text/plain", "Not Found!", 10, request.keepAlive, nullptr, head);
+        return;
+    }
+
+    // HEAD only describes /control's interface; commands aren't submitted
+    // by requests answered without bodies.
+    if ((status && !get && !head) || (control && !get && !post && !(head && !request.querySize)))
+    {
+        _respond(connection, "405 Method Not Allowed", "text/plain", "Method not allowed!", 19, request.keepAlive, nullptr, head);
+        return;
+    }
+
+    ControlServer::Zone zone = 0;
+    std::string argument;
+
+    if (ControlServer::_Argument(request, "zone", argument))
+    {
+        char *parsedEnd = nullptr;
+        unsigned long const parsed = std::strtoul(argument.c_str(), &parsedEnd, 10);
+
+        if (argument.empty() || *parsedEnd || (argument[0] == '-') || (parsed > ~ControlServer::Zone(0)))
+        {
+            _respond(connection, "400 Bad Request", "text/plain", "Invalid zone!", 13, request.keepAlive, nullptr, head);
+            return;
+        }
+
+        zone = static_cast<ControlServer::Zone>(parsed);
+    }
+
+    std::unordered_map<ControlServer::Zone, Thermostat *>::const_iterator const found = _zones.find(zone);
+
+    if (found == _zones.end())
+    {
+        _respond(connection, "404 Not Found", "text/plain", "Unknown zone!", 13, request.keepAlive, nullptr, head);
+        return;
+    }
+
+    if (status) _status(connection, request, *found->second, head);
+    else _control(connection, request, *found->second, head);
+}
+
+void ControlServer::_status(ControlServer::Connection &connection,
+                            ControlServer::Request const &request,
+                            Thermostat const &thermostat,
+                            bool const head)
+{
+    // Served as published by the thermostat's last cycle; nothing is sensed.
+    std::shared_ptr<Thermostat::Snapshot const> const snapshot = thermostat.snapshot();
+
+    if (request.ifNoneMatch && ControlServer::_Matches(request.ifNoneMatch, request.ifNoneMatchSize, snapshot->etag()))
+    {
+        _respond(connection, "304 Not Modified", nullptr, nullptr, 0, request.keepAlive, snapshot->etag(), true);
+        return;
+    }
+
+    _respond(connection, "200 OK", "application/json", snapshot->data(), snapshot->size(), request.keepAlive, snapshot->etag(), head);
+}
+
+void ControlServer::_control(ControlServer::Connection &connection,
+                             ControlServer::Request const &request,
+                             Thermostat &thermostat,
+                             bool const head)
+{
+    bool const form = request.bodySize && ControlServer::_Equals(request.method, request.methodSize, "POST");
+
+    if (!request.querySize && !form)
+    {
+        _respond(connection, "200 OK", "text/plain", "Thermostat's controller interface.", 34, request.keepAlive, nullptr, head);
+        return;
+    }
+
+    // Arguments are taken as the ESP8266's /control handler takes them.
+    std::string mode, temperature, type;
+    ControlServer::_Argument(request, "mode", mode);
+    ControlServer::_Argument(request, "temp", temperature);
+    ControlServer::_Argument(request, "type", type);
+
+    Thermostat::Command const command =
+        Thermostat::Command::Parse(mode.c_str(), temperature.c_str(), type.c_str(), thermostat.mode());
+
+    uint32_t const submitted = thermostat.submit(command);
+
+    if (!submitted)
+    {
+        _respond(connection, "400 Bad Request", "text/plain", "Invalid or too many commands!", 29, request.keepAlive, nullptr, head);
+        return;
+    }
+
+    char statusData[Thermostat::Snapshot::Capacity];
+    std::size_t const statusSize = thermostat.snapshot()->write(statusData, sizeof(statusData), submitted);
+
+    _respond(connection, "200 OK", "application/json", statusData, statusSize, request.keepAlive, nullptr, head);
+}
+
+void ControlServer::_respond(ControlServer::Connection &connection,
+                             char const * const status,
+                             char const * const type,
+                             char const * const body,
+                             std::size_t const bodySize,
+                             bool const keepAlive,
+                             char const * const etag,
+                             bool const head)
+{
+    std::string &output = connection.output;
+
+    output += "HTTP/1.1 ";
+    output += status;
+    output += "\r\nDate: ";
+    output += _date;
+
+    if (type)
+    {
+        output += "\r\nContent-Type: ";
+        output += type;
+    }
+
+    // Not modified responses describe the client's copy, so they go without.
+    if (std::strncmp(status, "304", 3))
+    {
+        output += "\r\nContent-Length: ";
+        output += std::to_string(bodySize);
+    }
+
+    if (etag)
+    {
+        output += "\r\nETag: ";
+        output += etag;
+        output += "\r\nCache-Control: no-cache";
+    }
+
+    output += keepAlive? "\r\nConnection: keep-alive\r\n\r\n" : "\r\nConnection: close\r\n\r\n";
+
+    if (!head && bodySize) output.append(body, bodySize);
+
+    if (!keepAlive) connection.closing = true;
+}
+
+void ControlServer::_refreshDate()
+{
+    time_t const now = time(nullptr);
+    if (now == _dateTime) return;
+
+    struct tm universal;
+    if (!gmtime_r(&now, &universal)) return;
+
+    std::strftime(_date, sizeof(_date), "%a, %d %b %Y %H:%M:%S GMT", &universal);
+    _dateTime = now;
+}
+
+bool ControlServer::_Argument(ControlServer::Request const &request, char const * const name, std::string &value)
+{
+    bool const form = ControlServer::_Equals(request.method, request.methodSize, "POST") &&
+                      ControlServer::_Argument(request.body, request.bodySize, name, value);
+
+    return form || ControlServer::_Argument(request.query, request.querySize, name, value);
+}
+
+bool ControlServer::_Argument(char const *data, std::size_t const size, char const * const name, std::string &value)
+{
+    std::size_t const nameSize = std::strlen(name);
+    char const * const end = data + size;
+    bool found = false;
+
+    while (data && (data < end))
+    {
+        char const *pairEnd = static_cast<char const *>(std::memchr(data, '&', end - data));
+        if (!pairEnd) pairEnd = end;
+
+        char const *equals = static_cast<char const *>(std::memchr(data, '=', pairEnd - data));
+        if (!equals) equals = pairEnd;
+
+        if (((equals - data) == static_cast<long>(nameSize)) && !std::memcmp(data, name, nameSize))
+        {
+            value = ControlServer::_Decode(equals + ((equals < pairEnd)? 1 : 0), pairEnd - equals - ((equals < pairEnd)? 1 : 0));
+            found = true;
+        }
+
+        data = pairEnd + 1;
+    }
+
+    return found;
+}
+
+std::string ControlServer::_Decode(char const *data, std::size_t const size)
+{
+    std::string decoded;
+    decoded.reserve(size);
+
+    for (std::size_t index = 0; index < size; index++)
+    {
+        if ((data[index] == '%') && ((index + 2) < size) && isxdigit(data[index + 1]) && isxdigit(data[index + 2]))
+        {
+            char const hex[3] = {data[index + 1], data[index + 2], '\0'};
+            decoded += static_cast<char>(std::strtoul(hex, nullptr, 16));
+            index += 2;
+        }
+        else decoded += (data[index] == '+')? ' ' : data[index];
+    }
+
+    return decoded;
+}
+
+bool ControlServer::_Matches(char const *value, std::size_t const size, char const * const etag)
+{
+    char const * const end = value + size;
+    std::size_t const etagSize = std::strlen(etag);
+
+    while (value < end)
+    {
+        char const *tagEnd = static_cast<char const *>(std::memchr(value, ',', end - value));
+        if (!tagEnd) tagEnd = end;
+
+        char const *tag = value;
+        char const *tagLast = tagEnd;
+        while ((tag < tagLast) && ((*tag == ' ') || (*tag == '\t'))) tag++;
+        while ((tagLast > tag) && ((tagLast[-1] == ' ') || (tagLast[-1] == '\t'))) tagLast--;
+
+        // Tags are compared weakly, as they are for If-None-Match.
+        if (((tagLast - tag) >= 2) && (tag[0] == 'W') && (tag[1] == '/')) tag += 2;
+
+        if (((tagLast - tag) == 1) && (*tag == '*')) return true;
+        if ((static_cast<std::size_t>(tagLast - tag) == etagSize) && !std::memcmp(tag, etag, etagSize)) return true;
+
+        value = tagEnd + 1;
+    }
+
+    return false;
+}
+
+bool ControlServer::_Equals(char const * const data, std::size_t const size, char const * const literal)
+{
+    return (std::strlen(literal) == size) && !strncasecmp(data, literal, size);
+}
+
+
+// =============================================================================
+// ControlServer : Constructors & Destructor
+// =============================================================================
+ControlServer::ControlServer(std::size_t const connectionsLimit):
+_listener(-1),
+_poll(epoll_create1(EPOLL_CLOEXEC)),
+_connectionsLimit(connectionsLimit),
+_requests(0),
+_dateTime(0)
+{
+    _date[0] = '\0';
+    _refreshDate();
+}
+
+ControlServer::~ControlServer()
+{
+    for (std::pair<int const, std::unique_ptr<ControlServer::Connection>> const &connection : _connections)
+    {
+        close(connection.first);
+    }
+
+    if (_listener >= 0) close(_listener);
+    if (_poll >= 0) close(_poll);
+}
+
+#endif
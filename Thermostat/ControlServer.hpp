@@ -0,0 +1,158 @@
+//
+//  ControlServer.hpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef ControlServer_hpp
+#define ControlServer_hpp
+
+#include "Development.hpp"
+
+#if defined(MJB_LINUX_EPOLL)
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "Thermostat.hpp"
+
+// =============================================================================
+// ControlServer : This class serves the process' thermostats over HTTP/1.1, as
+// the ESP8266's web server serves its one, each addressed by the zone it was
+// added as (zone 0 if none's asked for):
+//  GET /status?zone=N answers the zone's status snapshot, or 304 if it's the
+//  one the client has, per If-None-Match (see Thermostat::Snapshot).
+//  GET|POST /control?zone=N&mode=M&temp=T&type=I submits a command changing
+//  the settings given (see Thermostat::Command), answering with the snapshot
+//  and the command's id, or 400 if it's rejected.
+// HEAD is answered as GET is, headers only, but for commands, which it can't
+// submit.
+// The server is single threaded: serve() runs a nonblocking epoll loop, and is
+// called from the thread's run loop between scheduler updates, as the ESP8266
+// calls handleClient(). Connections are kept alive, and requests pipelined on
+// them answered in order, in as few writes as the socket takes.
+// NOTE: Commands are submitted on serve()'s thread, which must be the one that
+// updates the thermostats (see Thermostat::submit); snapshots may be served of
+// thermostats updated anywhere.
+// =============================================================================
+class ControlServer
+{
+public:
+    typedef uint32_t Zone;
+
+    // Returns false if the zone's already served.
+    bool add(Zone const zone, Thermostat &thermostat);
+    bool remove(Zone const zone);
+
+    // Listens on the port of the address given, or of all the host's.
+    bool listen(uint16_t const port, char const * const address = nullptr);
+    bool listening() const;
+
+    // Accepts, reads and answers whatever's ready, waiting up to the timeout
+    // (in milliseconds, -1 being forever) for something to be; returns the
+    // requests answered.
+    std::size_t serve(int const timeout = 0);
+
+    std::size_t connections() const;
+    uint64_t requests() const;
+
+    // Connections beyond the limit are closed as soon as they're accepted.
+    ControlServer(std::size_t const connectionsLimit = 1024);
+    ~ControlServer();
+
+protected:
+
+    struct Connection
+    {
+        int descriptor;
+        std::string input;
+        std::string output;
+        std::size_t written;    // The bytes of the output already sent.
+        bool closing;           // Closed once the output's sent.
+        bool stalled;           // Not read from until the output's caught up.
+    };
+
+    struct Request
+    {
+        char const *method;
+        std::size_t methodSize;
+        char const *path;
+        std::size_t pathSize;
+        char const *query;
+        std::size_t querySize;
+        char const *body;
+        std::size_t bodySize;
+        char const *ifNoneMatch;
+        std::size_t ifNoneMatchSize;
+        bool keepAlive;
+    };
+
+    // Requests' heads, and responses waiting to be sent, are held to these;
+    // connections past the latter aren't read until they've caught up.
+    static constexpr std::size_t _HeadLimit = 8192;
+    static constexpr std::size_t _BodyLimit = 8192;
+    static constexpr std::size_t _OutputLimit = 1 << 20;
+    static constexpr std::size_t _ReadSize = 1 << 16;
+    static constexpr int _EventsMax = 256;
+
+    int _listener;
+    int _poll;
+    std::size_t const _connectionsLimit;
+
+    std::unordered_map<Zone, Thermostat *> _zones;
+    std::unordered_map<int, std::unique_ptr<Connection>> _connections;
+
+    uint64_t _requests;
+
+    // The Date header's value, formatted once a second.
+    time_t _dateTime;
+    char _date[32];
+
+    void _accept();
+    void _close(Connection &connection);
+
+    // Reads what's arrived and answers the requests complete, then sends
+    // what it can; returns the requests answered.
+    std::size_t _receive(Connection &connection);
+    std::size_t _process(Connection &connection);
+    bool _send(Connection &connection);
+
+    // Parses the request at the start of the data, returning its size, or 0
+    // if it's not all there yet; malformed requests are answered, closing
+    // the connection, and returned as -1.
+    long _parse(Connection &connection, char const * const data, std::size_t const size, Request &request);
+
+    void _answer(Connection &connection, Request const &request);
+    void _status(Connection &connection, Request const &request, Thermostat const &thermostat, bool const head);
+    void _control(Connection &connection, Request const &request, Thermostat &thermostat, bool const head);
+
+    void _respond(Connection &connection,
+                  char const * const status,
+                  char const * const type,
+                  char const * const body,
+                  std::size_t const bodySize,
+                  bool const keepAlive,
+                  char const * const etag = nullptr,
+                  bool const head = false);
+
+    void _refreshDate();
+
+    // Finds the request's argument, in its query or form (which prevails), the
+    // last of the name holding; returns false if there's none.
+    static bool _Argument(Request const &request, char const * const name, std::string &value);
+    static bool _Argument(char const *data, std::size_t const size, char const * const name, std::string &value);
+    static std::string _Decode(char const *data, std::size_t const size);
+
+    // Whether the header's value names the entity tag, per If-None-Match.
+    static bool _Matches(char const *value, std::size_t const size, char const * const etag);
+    static bool _Equals(char const * const data, std::size_t const size, char const * const literal);
+};
+
+#endif
+
+#endif /* ControlServer_hpp */
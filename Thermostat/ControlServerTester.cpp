@@ -0,0 +1,439 @@
+//
+//  ControlServerTester.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "Development.hpp"
+
+#if defined(MJB_LINUX_EPOLL)
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "ControlServer.hpp"
+#include "Testing.hpp"
+
+// Thermostats are only updated on the server's thread, though they read the
+// clock from it.
+Scheduler::Time micros()
+{
+    return static_cast<Scheduler::Time>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+typedef Thermometer::TemperatureUnit TemperatureUnit;
+
+// Reads 70F, at once, every time it's sensed.
+class Fixed : public Thermometer
+{
+public:
+
+    Sensor::Data sense()
+    {
+        _temperature = TemperatureUnit(70, TemperatureUnit::Scale::Fahrenheit);
+        _humidity = 40;
+        _recordReading();
+        return Sensor::Data();
+    }
+
+    Fixed():
+    Thermometer({})
+    {
+
+    }
+};
+
+// Serves zones thermostats on a thread of its own, which updates them, until
+// stopped; the port it's listening on is known once it is, or 0 if it can't.
+class Server
+{
+public:
+
+    uint16_t port()
+    {
+        return _port.get();
+    }
+
+    void stop()
+    {
+        _serving = false;
+        _thread.join();
+    }
+
+    Server(std::size_t const zones):
+    _serving(true),
+    _thread([this, zones]() {
+        std::vector<std::unique_ptr<Thermostat>> thermostats;
+        ControlServer server(4096);
+
+        for (std::size_t zone = 0; zone < zones; zone++)
+        {
+            Pin::Identifier const pin = static_cast<Pin::Identifier>(1000 + (3 * zone));
+            thermostats.emplace_back(new Thermostat(Pin::Arrangement({pin, pin + 1, pin + 2}),
+                                                    Thermostat::Thermometers({std::make_shared<Fixed>()}),
+                                                    5000000));
+            server.add(static_cast<ControlServer::Zone>(zone), *thermostats.back());
+        }
+
+        uint16_t port = 18090;
+        while ((port < 18100) && !server.listen(port, "127.0.0.1")) port++;
+
+        bool const listening = server.listening();
+        _listening.set_value(listening? port : 0);
+        if (!listening) return;
+
+        while (_serving)
+        {
+            Scheduler::UpdateInstances(micros());
+            server.serve(1);
+        }
+    }),
+    _port(_listening.get_future())
+    {
+
+    }
+
+protected:
+
+    std::atomic<bool> _serving;
+    std::promise<uint16_t> _listening;
+    std::thread _thread;
+    std::future<uint16_t> _port;
+};
+
+static int Connect(uint16_t const port)
+{
+    int const descriptor = socket(AF_INET, SOCK_STREAM, 0);
+
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+
+    if (connect(descriptor, reinterpret_cast<sockaddr const *>(&address), sizeof(address)) < 0)
+    {
+        close(descriptor);
+        return -1;
+    }
+
+    int const enable = 1;
+    setsockopt(descriptor, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+    // Checks give up on an answer, rather than hang, if it never comes.
+    timeval const timeout = {2, 0};
+    setsockopt(descriptor, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    return descriptor;
+}
+
+struct Reply
+{
+    int status;
+    std::string head;
+    std::string body;
+
+    std::string header(char const * const name) const
+    {
+        std::string const field = std::string("\r\n") + name + ": ";
+        std::size_t const start = head.find(field);
+        if (start == std::string::npos) return std::string();
+
+        std::size_t const value = start + field.size();
+        return head.substr(value, head.find("\r\n", value) - value);
+    }
+};
+
+// Takes the response at the start of the input off it, returning false if
+// it's not all there yet; responses to HEAD have no body, whatever their
+// length.
+static bool Parse(std::string &input, Reply &reply, bool const head = false)
+{
+    std::size_t const headEnd = input.find("\r\n\r\n");
+    if ((headEnd == std::string::npos) || (input.size() < 12)) return false;
+
+    reply.status = std::atoi(input.c_str() + 9);
+    reply.head = input.substr(0, headEnd);
+
+    std::string const length = reply.header("Content-Length");
+    std::size_t const bodySize = (head || length.empty())? 0 : std::strtoul(length.c_str(), nullptr, 10);
+    if (input.size() < (headEnd + 4 + bodySize)) return false;
+
+    reply.body = input.substr(headEnd + 4, bodySize);
+    input.erase(0, headEnd + 4 + bodySize);
+    return true;
+}
+
+static bool Receive(int const descriptor, std::string &input, Reply &reply, bool const head = false)
+{
+    char buffer[4096];
+
+    while (!Parse(input, reply, head))
+    {
+        ssize_t const received = recv(descriptor, buffer, sizeof(buffer), 0);
+        if (received <= 0) return false;
+        input.append(buffer, received);
+    }
+
+    return true;
+}
+
+static bool Send(int const descriptor, std::string const &data)
+{
+    for (std::size_t sent = 0; sent < data.size();)
+    {
+        ssize_t const written = send(descriptor, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (written <= 0) return false;
+        sent += written;
+    }
+
+    return true;
+}
+
+static Reply Exchange(int const descriptor, std::string const &request)
+{
+    std::string input;
+    Reply reply = {0, std::string(), std::string()};
+    if (!Send(descriptor, request) || !Receive(descriptor, input, reply)) reply.status = 0;
+    return reply;
+}
+
+static std::string Get(std::string const &target, std::string const &headers = std::string())
+{
+    return "GET " + target + " HTTP/1.1\r\nHost: localhost\r\n" + headers + "\r\n";
+}
+
+static bool EndsWith(std::string const &text, std::string const &ending)
+{
+    return (text.size() >= ending.size()) && !text.compare(text.size() - ending.size(), ending.size(), ending);
+}
+
+// Polls the zone's status until the command's applied, for up to a second.
+static Reply Applied(int const descriptor, std::string const &zone, uint32_t const command)
+{
+    std::string const applied = "\"applied\":" + std::to_string(command) + "}";
+    Reply reply = {0, std::string(), std::string()};
+
+    for (unsigned attempt = 0; attempt < 100; attempt++)
+    {
+        reply = Exchange(descriptor, Get("/status?zone=" + zone));
+        if (reply.body.find(applied) != std::string::npos) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    return reply;
+}
+
+// Keeps depth requests in flight on each connection, for the seconds given,
+// asking for the statuses of zones in turn, as of the entity tags given, if
+// any; returns the requests answered per second.
+static double Load(uint16_t const port,
+                   std::size_t const connections,
+                   std::size_t const depth,
+                   std::size_t const zones,
+                   std::vector<std::string> const &etags,
+                   double const seconds)
+{
+    int const poll = epoll_create1(0);
+    std::vector<int> descriptors;
+    std::vector<std::string> requests, inputs(connections);
+
+    for (std::size_t connection = 0; connection < connections; connection++)
+    {
+        std::size_t const zone = connection % zones;
+        requests.push_back(Get("/status?zone=" + std::to_string(zone),
+                               etags.empty()? std::string() : ("If-None-Match: " + etags[zone] + "\r\n")));
+
+        int const descriptor = Connect(port);
+        descriptors.push_back(descriptor);
+
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.u64 = connection;
+        epoll_ctl(poll, EPOLL_CTL_ADD, descriptor, &event);
+
+        std::string pipelined;
+        for (std::size_t request = 0; request < depth; request++) pipelined += requests.back();
+        Send(descriptor, pipelined);
+    }
+
+    uint64_t answered = 0;
+    char buffer[1 << 16];
+    epoll_event events[256];
+
+    std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+    while (Testing::Seconds(start) < seconds)
+    {
+        int const ready = epoll_wait(poll, events, 256, 100);
+
+        for (int index = 0; index < ready; index++)
+        {
+            std::size_t const connection = events[index].data.u64;
+            ssize_t const received = recv(descriptors[connection], buffer, sizeof(buffer), MSG_DONTWAIT);
+            if (received <= 0) continue;
+
+            std::string &input = inputs[connection];
+            input.append(buffer, received);
+
+            // As many requests are sent as were answered, keeping the depth.
+            std::string refill;
+            Reply reply;
+            while (Parse(input, reply))
+            {
+                refill += requests[connection];
+                answered++;
+            }
+
+            if (!refill.empty()) Send(descriptors[connection], refill);
+        }
+    }
+
+    double const rate = answered / Testing::Seconds(start);
+
+    for (int const descriptor : descriptors) close(descriptor);
+    close(poll);
+
+    return rate;
+}
+
+int main(int argc, const char * argv[])
+{
+    std::size_t const zones = 100;
+    Server server(zones);
+    uint16_t const port = server.port();
+    MJB_CHECK(port);
+
+    // The thermostats' first cycles are let through, so statuses hold still.
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    int const client = port? Connect(port) : -1;
+    MJB_CHECK(client >= 0);
+
+    if (client >= 0)
+    {
+        // Statuses are served with their entity tags, and not at all to those
+        // holding them already.
+        Reply const status = Exchange(client, Get("/status"));
+        MJB_CHECK(status.status == 200);
+        MJB_CHECK(status.header("Content-Type") == "application/json");
+        MJB_CHECK(!status.body.compare(0, 16, "{\"temperature\": "));
+
+        std::string const etag = status.header("ETag");
+        MJB_CHECK(etag.size() == 10);
+
+        Reply const unchanged = Exchange(client, Get("/status", "If-None-Match: " + etag + "\r\n"));
+        MJB_CHECK(unchanged.status == 304);
+        MJB_CHECK(unchanged.body.empty());
+
+        MJB_CHECK(Exchange(client, Get("/status?zone=100")).status == 404);
+        MJB_CHECK(Exchange(client, Get("/status?zone=one")).status == 400);
+        MJB_CHECK(Exchange(client, Get("/settings")).status == 404);
+        MJB_CHECK(Exchange(client, "DELETE /status HTTP/1.1\r\nHost: localhost\r\n\r\n").status == 405);
+
+        // Commands are answered with the status and the command's id, and
+        // applied on the zone's next update.
+        Reply const heat = Exchange(client, Get("/control?zone=1&mode=heat&temp=75F&type=HI"));
+        MJB_CHECK(heat.status == 200);
+        MJB_CHECK(EndsWith(heat.body, "\"command\":{\"applied\":0,\"submitted\":1}}"));
+
+        Reply const heated = Applied(client, "1", 1);
+        MJB_CHECK(heated.body.find("\"target\":297.04") != std::string::npos);
+        MJB_CHECK(heated.body.find("\"measurement\":1") != std::string::npos);
+        MJB_CHECK(heated.body.find("\"mode\":1") != std::string::npos);
+
+        MJB_CHECK(Exchange(client, Get("/control?zone=1&temp=120F")).status == 400);
+        MJB_CHECK(Exchange(client, Get("/control?zone=1&mode=heat&temp=75")).status == 200);
+
+        // Forms are taken, over the query.
+        std::string const form = "mode=cool&temp=22.5C";
+        Reply const cool = Exchange(client, "POST /control?zone=2&mode=heat HTTP/1.1\r\nHost: localhost\r\n"
+                                            "Content-Type: application/x-www-form-urlencoded\r\n"
+                                            "Content-Length: " + std::to_string(form.size()) + "\r\n\r\n" + form);
+        MJB_CHECK(cool.status == 200);
+        MJB_CHECK(EndsWith(cool.body, "\"submitted\":1}}"));
+
+        Reply const cooled = Applied(client, "2", 1);
+        MJB_CHECK(cooled.body.find("\"target\":295.65") != std::string::npos);
+        MJB_CHECK(cooled.body.find("\"mode\":2") != std::string::npos);
+
+        // Pipelined requests are answered in order.
+        std::string input;
+        Reply first = {0, std::string(), std::string()}, second = {0, std::string(), std::string()};
+        MJB_CHECK(Send(client, Get("/status?zone=3") + Get("/control?zone=3&mode=auto")));
+        MJB_CHECK(Receive(client, input, first) && Receive(client, input, second));
+        MJB_CHECK((first.status == 200) && !first.header("ETag").empty());
+        MJB_CHECK((second.status == 200) && EndsWith(second.body, "\"submitted\":1}}"));
+
+        // HEAD is answered as GET is, without bodies, errors and all, but
+        // can't submit commands; the responses following are read as sent.
+        std::string const head = "HEAD /status?zone=4 HTTP/1.1\r\nHost: localhost\r\n\r\n"
+                                 "HEAD /status?zone=one HTTP/1.1\r\nHost: localhost\r\n\r\n"
+                                 "HEAD /status?zone=100 HTTP/1.1\r\nHost: localhost\r\n\r\n"
+                                 "HEAD /control?zone=4&mode=auto HTTP/1.1\r\nHost: localhost\r\n\r\n"
+                                 "HEAD /control HTTP/1.1\r\nHost: localhost\r\n\r\n";
+        Reply heads[5], got = {0, std::string(), std::string()};
+        MJB_CHECK(Send(client, head + Get("/status?zone=4")));
+
+        bool received = true;
+        for (Reply &reply : heads) received = received && Receive(client, input, reply, true);
+        MJB_CHECK(received && Receive(client, input, got) && input.empty());
+
+        MJB_CHECK((heads[0].status == 200) && heads[0].body.empty());
+        MJB_CHECK((heads[1].status == 400) && (heads[2].status == 404) && (heads[3].status == 405));
+        MJB_CHECK((heads[4].status == 200) && (heads[4].header("Content-Length") == "34"));
+        MJB_CHECK((got.status == 200) && (got.header("ETag") == heads[0].header("ETag")));
+        MJB_CHECK(got.header("Content-Length") == heads[0].header("Content-Length"));
+        MJB_CHECK(got.body.find("\"mode\":3") == std::string::npos);
+
+        close(client);
+    }
+
+    // Requests answered per second, over keep-alive connections to every
+    // zone, one request in flight on each, then pipelined, then conditional;
+    // the load's generated here, sharing the host's cores with the server.
+    if (port && Testing::Benchmarking(argc, argv))
+    {
+        std::size_t const connections = 50;
+        std::vector<std::string> etags;
+
+        int const descriptor = Connect(port);
+        for (std::size_t zone = 0; zone < zones; zone++)
+        {
+            etags.push_back(Exchange(descriptor, Get("/status?zone=" + std::to_string(zone))).header("ETag"));
+        }
+        close(descriptor);
+
+        std::fprintf(stderr, "ControlServer: %zu connections, 1 in flight: %.0fk req/s\n",
+                     connections, Load(port, connections, 1, zones, {}, 2) / 1e3);
+        std::fprintf(stderr, "ControlServer: %zu connections, 16 pipelined: %.0fk req/s\n",
+                     connections, Load(port, connections, 16, zones, {}, 2) / 1e3);
+        std::fprintf(stderr, "ControlServer: %zu connections, 16 pipelined, 304s: %.0fk req/s\n",
+                     connections, Load(port, connections, 16, zones, etags, 2) / 1e3);
+    }
+
+    server.stop();
+
+    return Testing::Result("ControlServerTester");
+}
+
+#else
+
+int main()
+{
+    return 0;
+}
+
+#endif
@@ -21,6 +21,13 @@ void delayMicroseconds(unsigned long time)
 // DHT22 Implementation
 // ================================================================
 Sensor::Data DHT22::sense() {
+
+    // Asynchronous reads publish their results when they complete.
+    if (acquisition() == DHT22::Acquisition::Asynchronous)
+    {
+        acquire();
+        return Sensor::Data();
+    }
     
     // Assure all pins are ready to use (data line).
     // If the sensor isn't ready, return empty data.
@@ -36,7 +43,7 @@ Sensor::Data DHT22::sense() {
     Sensor::Data data(5); // Buffer for data (40-bit)
     
     // Prepare data pin for operation.
-    Pin &dataPin = *(_pins[pinout[DHT22::Pinout::Data]]);
+    Pin &dataPin = _dataPin();
     dataPin.setMode(Pin::Mode::Output);
 
     Sensor::sense(); // Prevent interrptions by causing timeout.
@@ -55,17 +62,14 @@ Sensor::Data DHT22::sense() {
     // Await response from the DHT22, 80us down followed by 80us up
     // ============================================================
     dataPin.setMode(Pin::Mode::Input);
-    delayMicroseconds(40); // Wait a bit for the sensor to reply.
-    
-    
-    // NOTE: POLING CAN BEGIN HERE WITH BLOCKING WAITS.
-    // Wait till output high signal is pulled down by MCU.
-    // This needs to be protected for potential hangs.
-    // while (dataPin.state()) continue;
-    
-    
-    // Check for low, if up return nothing.
-    if (dataPin.value()) {
+
+    // Every wait below is bounded by its phase's deadline, so a missing or
+    // stuck sensor costs at most the response and transfer timeouts.
+    Scheduler::Time time = micros();
+    Scheduler::Time const responseDeadline = time + DHT22_RESPONSE_TIMEOUT;
+
+    // Wait for the sensor to pull the line down, replying.
+    if (!_await(dataPin, 0, responseDeadline, time)) {
 #if defined(MJB_DEBUG_LOGGING_DHT22)
         MJB_DEBUG_LOG("[DHT22 <");
         MJB_DEBUG_LOG_FORMAT((unsigned long) this, MJB_DEBUG_LOG_HEX);
@@ -73,15 +77,10 @@ Sensor::Data DHT22::sense() {
 #endif
         return Sensor::Data();
     }
-    delayMicroseconds(80);
-    
-    // Wait for the MCU to repeat the down part of down-up signal.
-    // This needs to be protected for potential hangs.
-    // while (!dataPin.state()) continue;
-    
-    
-    // Check for high, if low, return nothing.
-    if (!dataPin.value()) {
+
+    // Wait for the up, then the down marking the start of the first bit.
+    if (!_await(dataPin, 1, responseDeadline, time) ||
+        !_await(dataPin, 0, responseDeadline, time)) {
 #if defined(MJB_DEBUG_LOGGING_DHT22)
         MJB_DEBUG_LOG("[DHT22 <");
         MJB_DEBUG_LOG_FORMAT((unsigned long) this, MJB_DEBUG_LOG_HEX);
@@ -89,50 +88,88 @@ Sensor::Data DHT22::sense() {
 #endif
         return Sensor::Data();
     }
-    delayMicroseconds(40);
-    
-    // Wait for the MCU to repeat the up part of down-up signal.
-    // This needs to be protected for potential hangs.
-    //while (dataPin.state()) continue;
+
+    Scheduler::Time const transferDeadline = time + DHT22_TRANSFER_TIMEOUT;
     
     // Get 40 bits of data from the sensor.
-    for (Sensor::Byte &byte : data)
+    DHT22Decoder::PulseWidth widths[DHT22Decoder::FrameBits];
+    std::size_t bits = 0;
+    for (; bits < DHT22Decoder::FrameBits; bits++)
     {
-        // Each byte has 8 bits, loop 8 times for each byte.
-        for (Sensor::Byte bit = 0; bit < 8; bit++)
-        {
-            // Wait for high signal signifying next bit started.
-            // WARNING: This needs to be protected for potential hangs.
-            while (!dataPin.value()) continue; // NOTE: BLOCKING WAIT
-            unsigned short const timeA = micros();
-
-            // Wait for low signal, signifying start of next bit.
-            // WARNING: This needs to be protected for potential hangs.
-            while (dataPin.value()) continue; // NOTE: BLOCKING WAIT
-            unsigned short const timeB = micros();
-            
-            // If high signal lasted > ~30us, it's a 1, 0 otherwise.
-            byte = (byte << 1) | (timeB - timeA > 50);
-        }
+        // Wait for high signal signifying next bit started.
+        Scheduler::Time rise;
+        if (!_await(dataPin, 1, transferDeadline, rise)) break;
+
+        // Wait for low signal, signifying start of next bit.
+        Scheduler::Time fall;
+        if (!_await(dataPin, 0, transferDeadline, fall)) break;
+
+        Scheduler::Time const duration = fall - rise;
+        widths[bits] = (duration > 0xFFFF)? 0xFFFF : static_cast<DHT22Decoder::PulseWidth>(duration);
     }
 
-    uint16_t const hRaw = ((static_cast<uint16_t>(data[0]) << 8) | data[1]);
+    if (bits != DHT22Decoder::FrameBits) {
+#if defined(MJB_DEBUG_LOGGING_DHT22)
+        MJB_DEBUG_LOG("[DHT22 <");
+        MJB_DEBUG_LOG_FORMAT((unsigned long) this, MJB_DEBUG_LOG_HEX);
+        MJB_DEBUG_LOG_LINE(">] ERROR: Incomplete reply from sensor!");
+#endif
+        return Sensor::Data();
+    }
 
-    // Humidity (percentage) is in unsigned scalar format, x10 scaled.
-    float const humidity = static_cast<float>(hRaw) / 10;
+    DHT22Decoder::Pack(widths, data.data());
 
-    // Temperature (Celcius) is in signed-magnitude format, x10 scaled.
-    uint16_t const tRaw = ((static_cast<uint16_t>(data[2]) << 8) | data[3]);
+    _publish(data);
     
-    // Temperature (Celcius) must be converted from signed-magnitude to two's complement.
-    float const temperature = static_cast<float>((tRaw & 0x7FFF) * ((tRaw & 0x8000)? -1 : 1)) / 10;
+    return data;
+}
+
+DHT22::Acquisition DHT22::acquisition() const
+{
+    return _acquisition;
+}
+
+void DHT22::setAcquisition(DHT22::Acquisition const acquisition)
+{
+    _acquisition = acquisition;
+}
+
+bool DHT22::acquire()
+{
+    // Only one read at a time, and only once the sensor has cooled down.
+    if (acquiring() || (status() != Actuator::Status::Ready)) return false;
+
+    return _reader.start(micros());
+}
+
+bool DHT22::acquiring() const
+{
+    return _reader.phase() != DHT22::Reader::Phase::Idle;
+}
+
+bool DHT22::pending() const
+{
+    return acquiring();
+}
+
+Pin &DHT22::_dataPin()
+{
+    return *(_pins[pinout[DHT22::Pinout::Data]]);
+}
+
+bool DHT22::_publish(Sensor::View const data)
+{
+    if (data.size() != 5) return false; // We require exactly 5 bytes of data.
+
+    float const humidity = DHT22Decoder::Humidity(data.data());
+    float const temperature = DHT22Decoder::Temperature(data.data());
 
 #if defined(MJB_DEBUG_LOGGING_DHT22)
     MJB_DEBUG_LOG("[DHT22 <");
     MJB_DEBUG_LOG_FORMAT((unsigned long) this, MJB_DEBUG_LOG_HEX);
     MJB_DEBUG_LOG(">] All Data: ");
 
-    for (Sensor::Byte &byte : data)
+    for (Sensor::Byte const byte : data)
     {
         MJB_DEBUG_LOG_FORMAT(byte, MJB_DEBUG_LOG_BIN);
         MJB_DEBUG_LOG(" ");
@@ -147,7 +184,7 @@ Sensor::Data DHT22::sense() {
     MJB_DEBUG_LOG(" ");
     MJB_DEBUG_LOG_FORMAT(data[1], MJB_DEBUG_LOG_BIN);
     MJB_DEBUG_LOG(" = ");
-    MJB_DEBUG_LOG(hRaw);
+    MJB_DEBUG_LOG(((static_cast<uint16_t>(data[0]) << 8) | data[1]));
     MJB_DEBUG_LOG(" | normalized = ");
     MJB_DEBUG_LOG_LINE_FORMAT(humidity, MJB_DEBUG_LOG_DEC);
     
@@ -159,7 +196,7 @@ Sensor::Data DHT22::sense() {
     MJB_DEBUG_LOG_FORMAT(data[3], MJB_DEBUG_LOG_BIN);
     MJB_DEBUG_LOG(" = ");
     
-    MJB_DEBUG_LOG(tRaw);
+    MJB_DEBUG_LOG(((static_cast<uint16_t>(data[2]) << 8) | data[3]));
     MJB_DEBUG_LOG(" | normalized = ");
     MJB_DEBUG_LOG_LINE_FORMAT(temperature, MJB_DEBUG_LOG_DEC);
     
@@ -171,7 +208,9 @@ Sensor::Data DHT22::sense() {
     MJB_DEBUG_LOG_LINE((unsigned short) data[4]);
 #endif
     
-    if (_validData(data)) // Update cached values only if valid data received.
+    bool const valid = _validData(data);
+
+    if (valid) // Update cached values only if valid data received.
     {
 #if defined(MJB_DEBUG_LOGGING_DHT22)
         MJB_DEBUG_LOG("[DHT22 <");
@@ -186,37 +225,204 @@ Sensor::Data DHT22::sense() {
 #endif
         _temperature = Thermometer::TemperatureUnit(temperature, Thermometer::TemperatureUnit::Scale::Celsius);
         _humidity = humidity;
+        _recordReading();
     }
-#if defined(MJB_DEBUG_LOGGING_DHT22)
     else
     {
+#if defined(MJB_DEBUG_LOGGING_DHT22)
         MJB_DEBUG_LOG("[DHT22 <");
         MJB_DEBUG_LOG_FORMAT((unsigned long) this, MJB_DEBUG_LOG_HEX);
         MJB_DEBUG_LOG_LINE(">] ERROR: Data is corrupted!");
-    }
 #endif
-    
-    return data;
+        _recordChecksumFailure();
+    }
+
+    return valid;
 }
 
-bool DHT22::DHT22::_validData(Sensor::Data const &data)
+bool DHT22::_validData(Sensor::View const data)
 {
     if (data.size() != 5) return false; // We require exactly 5 bytes of data.
 
-    // The 5th (checksum) byte must equal to the sum of the first four bytes.
-    return data[4] == static_cast<Sensor::Byte>(data[0] + data[1] + data[2] + data[3]);
+    return DHT22Decoder::Valid(data.data());
+}
+
+// ================================================================
+// DHT22::Reader Implementation
+// ================================================================
+DHT22::Reader::Phase DHT22::Reader::phase() const
+{
+    return _phase;
+}
+
+bool DHT22::Reader::start(Scheduler::Time const time)
+{
+    if (phase() != DHT22::Reader::Phase::Idle) return false;
+
+    _phase = DHT22::Reader::Phase::Wake;
+    setExecuteTime(time); // Not scheduled at this point, won't reprioritize.
+    setExecuteTimeInterval(0);
+
+    if (!_sensor._scheduler.enqueue(std::static_pointer_cast<Scheduler::Event>(self())))
+    {
+        _phase = DHT22::Reader::Phase::Idle;
+        return false;
+    }
+    return true;
+}
+
+int DHT22::Reader::execute(Scheduler::Time const time)
+{
+    Pin &dataPin = _sensor._dataPin();
+
+    // NOTE: Phases awaiting the sensor run every cycle until their edges have
+    // arrived; the edges carry their own timestamps, so polling isn't timing
+    // sensitive, and the deadlines below bound how long we'll keep trying.
+    switch (phase())
+    {
+        case Wake: {
+            // Pull down for 1000us to wake the DHT22, as in a blocking read.
+            dataPin.setMode(Pin::Mode::Output);
+            _sensor.Sensor::sense(); // Prevent interrptions by causing timeout.
+            dataPin.setValue(0);
+
+            _phase = DHT22::Reader::Phase::Release;
+            setExecuteTimeInterval(DHT22_WAKE_TIME);
+        }   break;
+
+        case Release: {
+            // Pull up, then listen; the sensor replies within microseconds.
+            dataPin.setValue(1);
+            dataPin.setMode(Pin::Mode::Input);
+
+            if (!dataPin.setCapturing(true)) {
+#if defined(MJB_DEBUG_LOGGING_DHT22)
+                MJB_DEBUG_LOG("[DHT22 <");
+                MJB_DEBUG_LOG_FORMAT((unsigned long) &_sensor, MJB_DEBUG_LOG_HEX);
+                MJB_DEBUG_LOG_LINE(">] ERROR: Unable to capture data line!");
+#endif
+                _finish();
+                return 1;
+            }
+
+            _releaseTime = time;
+            _phase = DHT22::Reader::Phase::Response;
+            setExecuteTimeInterval(0);
+        }   break;
+
+        case Response: {
+            // The response is 3 edges; down, up, then down for the first bit.
+            if (dataPin.capturedEdges() >= 3) {
+                _phase = DHT22::Reader::Phase::Transfer;
+            } else
+            if ((time - _releaseTime) > DHT22_RESPONSE_TIMEOUT) {
+#if defined(MJB_DEBUG_LOGGING_DHT22)
+                MJB_DEBUG_LOG("[DHT22 <");
+                MJB_DEBUG_LOG_FORMAT((unsigned long) &_sensor, MJB_DEBUG_LOG_HEX);
+                MJB_DEBUG_LOG_LINE(">] WARNING: No reply from sensor!");
+#endif
+                _sensor._recordTimeout();
+                _finish();
+                return 1;
+            }
+        }   break;
+
+        case Transfer: {
+            // Each of the 40 bits is an up edge followed by a down edge.
+            if (dataPin.capturedEdges() >= (3 + 80)) {
+                Sensor::Data data(5);
+                bool const decoded = _decode(dataPin, data);
+                if (!decoded) _sensor._recordChecksumFailure(); // Malformed frame.
+                _finish();
+                return (decoded && _sensor._publish(data))? 0 : 1;
+            }
+
+            if ((time - _releaseTime) > (DHT22_RESPONSE_TIMEOUT + DHT22_TRANSFER_TIMEOUT)) {
+#if defined(MJB_DEBUG_LOGGING_DHT22)
+                MJB_DEBUG_LOG("[DHT22 <");
+                MJB_DEBUG_LOG_FORMAT((unsigned long) &_sensor, MJB_DEBUG_LOG_HEX);
+                MJB_DEBUG_LOG_LINE(">] ERROR: Incomplete reply from sensor!");
+#endif
+                _sensor._recordTimeout();
+                _finish();
+                return 1;
+            }
+        }   break;
+
+        default: break;
+    }
+
+    return 0;
 }
 
+bool DHT22::Reader::finished() const
+{
+    return phase() == DHT22::Reader::Phase::Idle;
+}
+
+void DHT22::Reader::_finish()
+{
+    _sensor._dataPin().setCapturing(false);
+    _phase = DHT22::Reader::Phase::Idle;
+}
+
+bool DHT22::Reader::_decode(Pin &dataPin, Sensor::Data &data)
+{
+    Pin::Edge edge;
+
+    // Verify the response signal was down, up, then down.
+    for (Pin::Value const expected : {0, 1, 0})
+    {
+        if (!dataPin.nextEdge(edge) || ((edge.value != 0) != (expected != 0))) return false;
+    }
+
+    DHT22Decoder::PulseWidth widths[DHT22Decoder::FrameBits];
+    for (DHT22Decoder::PulseWidth &width : widths)
+    {
+        Pin::Edge rise, fall;
+        if (!dataPin.nextEdge(rise) || !rise.value) return false;
+        if (!dataPin.nextEdge(fall) || fall.value) return false;
+
+        Scheduler::Time const duration = fall.time - rise.time;
+        width = (duration > 0xFFFF)? 0xFFFF : static_cast<DHT22Decoder::PulseWidth>(duration);
+    }
+
+    DHT22Decoder::Pack(widths, data.data());
+
+    return true;
+}
+
+DHT22::Reader::Reader(DHT22 &sensor):
+_sensor(sensor),
+_phase(DHT22::Reader::Phase::Idle),
+_releaseTime(0)
+{
+    
+}
+
+DHT22::Reader::~Reader()
+{
+    
+}
+
+
+// ================================================================
+// DHT22 Constructors & Destructor
+// ================================================================
 DHT22::DHT22(Pin::Identifier const dataPin):
 Thermometer({dataPin},
             DHT22_TIMEOUT,
             std::make_pair(Thermometer::TemperatureUnit(-40, Thermometer::TemperatureUnit::Scale::Celsius),
-                           Thermometer::TemperatureUnit(80, Thermometer::TemperatureUnit::Scale::Celsius)))
+                           Thermometer::TemperatureUnit(80, Thermometer::TemperatureUnit::Scale::Celsius))),
+_acquisition(DHT22::Acquisition::Blocking),
+_reader(*this)
 {
     
 }
 
 DHT22::~DHT22()
 {
-    
+    // The reader must not be left behind in the scheduler.
+    if (acquiring()) _reader.unschedule();
+    _dataPin().setCapturing(false);
 }
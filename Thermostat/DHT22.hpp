@@ -18,6 +18,7 @@
 #include "Thermometer.hpp"
 #include "Temperature.hpp"
 #include "Scheduler.hpp"
+#include "DHT22Decoder.hpp"
 
 
 #if defined(MJB_ARDUINO_LIB_API)
@@ -31,6 +32,13 @@
 // The value defined below represents the 2-second wait.
 #define DHT22_TIMEOUT 2000000 // In microseconds
 
+// The following bound each phase of an asynchronous read, in microseconds.
+// The wake pulse is driven by us, the sensor must then reply (80us low, 80us
+// high) shortly after the line is released, and the 40 bits take under 5ms.
+#define DHT22_WAKE_TIME 1000
+#define DHT22_RESPONSE_TIMEOUT 1000
+#define DHT22_TRANSFER_TIMEOUT 6000
+
 class DHT22 : public Thermometer
 {
 public:
@@ -39,19 +47,82 @@ public:
     {
         Data
     };
+
+    enum Acquisition
+    {
+        Blocking,       // Sense reads the sensor in place, blocking for ~5ms.
+        Asynchronous    // Sense starts a read driven by the Actuator's scheduler.
+    };
     
     // Sense is a blocking method since the sensor must retrive
     // information in microseconds and delays could corrupt the data.
     // NOTE: It takes approximately 5ms to retrieve the data,
     // but the specs say we must wait ~2 seconds before retrying.
+    // NOTE: When acquiring asynchronously, sense starts a read and returns
+    // empty data; cached values are updated once the read has completed.
     Sensor::Data sense();
+
+    Acquisition acquisition() const;
+    void setAcquisition(Acquisition const acquisition);
+
+    // Starts an asynchronous read unless one's already underway or the sensor
+    // is still cooling down. The data line's edges are captured as they happen
+    // and decoded once the frame is complete, so nothing else is held up.
+    bool acquire();
+    bool acquiring() const;
+
+    // Readings are pending while an asynchronous read is underway.
+    bool pending() const;
     
     DHT22(Pin::Identifier const dataPin);
     virtual ~DHT22();
     
 protected:
-    
-    bool _validData(Sensor::Data const &data);
+
+    // =========================================================================
+    // Reader: A Daemon stepping through a DHT22 transaction one phase at a time,
+    // rescheduling itself in between rather than waiting on the data line.
+    // =========================================================================
+    class Reader : public Scheduler::Daemon
+    {
+    public:
+
+        enum Phase
+        {
+            Idle,
+            Wake,       // Pull the data line down to wake the sensor.
+            Release,    // Release the data line and begin capturing edges.
+            Response,   // Await the sensor's response signal.
+            Transfer    // Await the 40-bit frame.
+        };
+
+        Phase phase() const;
+
+        bool start(Scheduler::Time const time);
+
+        int execute(Scheduler::Time const time);
+        bool finished() const;
+
+        Reader(DHT22 &sensor);
+        virtual ~Reader();
+
+    protected:
+
+        DHT22 &_sensor;
+        Phase _phase;
+        Scheduler::Time _releaseTime;
+
+        void _finish();
+        bool _decode(Pin &dataPin, Sensor::Data &data);
+    };
+
+    Acquisition _acquisition;
+    Reader _reader;
+
+    Pin &_dataPin();
+
+    bool _publish(Sensor::View const data);
+    bool _validData(Sensor::View const data);
     
 };
 
@@ -0,0 +1,92 @@
+//
+//  DHT22Decoder.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "DHT22Decoder.hpp"
+
+// ================================================================
+// DHT22Decoder Implementation
+// ================================================================
+void DHT22Decoder::Pack(DHT22Decoder::PulseWidth const * const widths, DHT22Decoder::Byte * const bytes)
+{
+    for (std::size_t byte = 0; byte < DHT22Decoder::FrameBytes; byte++)
+    {
+        bytes[byte] = DHT22Decoder::_PackByte(widths + (byte * 8));
+    }
+}
+
+void DHT22Decoder::Decode(DHT22Decoder::PulseWidth const * const widths,
+                          std::size_t const count,
+                          DHT22Decoder::Frames const &frames)
+{
+    DHT22Decoder::Byte bytes[DHT22Decoder::FrameBytes];
+
+    for (std::size_t frame = 0; frame < count; frame++)
+    {
+        DHT22Decoder::Pack(widths + (frame * DHT22Decoder::FrameBits), bytes);
+
+        frames.humidity[frame] = DHT22Decoder::Humidity(bytes);
+        frames.temperature[frame] = DHT22Decoder::Temperature(bytes);
+        frames.valid[frame] = DHT22Decoder::Valid(bytes);
+    }
+}
+
+bool DHT22Decoder::Valid(DHT22Decoder::Byte const * const bytes)
+{
+    // The 5th (checksum) byte must equal to the sum of the first four bytes.
+    return bytes[4] == static_cast<DHT22Decoder::Byte>(bytes[0] + bytes[1] + bytes[2] + bytes[3]);
+}
+
+float DHT22Decoder::Humidity(DHT22Decoder::Byte const * const bytes)
+{
+    uint16_t const hRaw = ((static_cast<uint16_t>(bytes[0]) << 8) | bytes[1]);
+
+    // Humidity (percentage) is in unsigned scalar format, x10 scaled.
+    return static_cast<float>(hRaw) / 10;
+}
+
+float DHT22Decoder::Temperature(DHT22Decoder::Byte const * const bytes)
+{
+    // Temperature (Celcius) is in signed-magnitude format, x10 scaled.
+    uint16_t const tRaw = ((static_cast<uint16_t>(bytes[2]) << 8) | bytes[3]);
+
+    // Temperature (Celcius) must be converted from signed-magnitude to two's complement.
+    return static_cast<float>((tRaw & 0x7FFF) * ((tRaw & 0x8000)? -1 : 1)) / 10;
+}
+
+DHT22Decoder::Byte DHT22Decoder::_PackByte(DHT22Decoder::PulseWidth const * const widths)
+{
+#if defined(__SSE2__)
+    // Classify all eight of the byte's pulses at once. The lanes are reversed
+    // first so that the earliest pulse ends up as the most significant bit.
+    __m128i pulses = _mm_loadu_si128(reinterpret_cast<__m128i const *>(widths));
+    pulses = _mm_shufflelo_epi16(pulses, _MM_SHUFFLE(0, 1, 2, 3));
+    pulses = _mm_shufflehi_epi16(pulses, _MM_SHUFFLE(0, 1, 2, 3));
+    pulses = _mm_shuffle_epi32(pulses, _MM_SHUFFLE(1, 0, 3, 2));
+
+    // NOTE: SSE2 only compares signed words, so an unsigned saturating
+    // subtraction is used instead; only widths above the threshold remain.
+    __m128i const zeros = _mm_cmpeq_epi16(_mm_subs_epu16(pulses, _mm_set1_epi16(DHT22Decoder::OneThreshold)),
+                                          _mm_setzero_si128());
+
+    // Narrow each word to a byte and gather their sign bits; these are the
+    // zero bits, hence the complement.
+    return static_cast<DHT22Decoder::Byte>(~_mm_movemask_epi8(_mm_packs_epi16(zeros, zeros)));
+#else
+    return DHT22Decoder::_PackByteScalar(widths);
+#endif
+}
+
+DHT22Decoder::Byte DHT22Decoder::_PackByteScalar(DHT22Decoder::PulseWidth const * const widths)
+{
+    DHT22Decoder::Byte byte = 0;
+    for (std::size_t bit = 0; bit < 8; bit++)
+    {
+        byte = (byte << 1) | (widths[bit] > DHT22Decoder::OneThreshold);
+    }
+    return byte;
+}
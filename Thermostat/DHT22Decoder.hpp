@@ -0,0 +1,69 @@
+//
+//  DHT22Decoder.hpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef DHT22Decoder_hpp
+#define DHT22Decoder_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include "Development.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// =============================================================================
+// DHT22Decoder : This class turns the high-pulse widths of DHT22 frames into
+// readings. It's independent of any sensor instance so that captured frames
+// can be decoded in bulk, such as when replaying recordings offline.
+// =============================================================================
+class DHT22Decoder
+{
+public:
+
+    // PulseWidth denotes the duration of a bit's high signal, in microseconds.
+    typedef uint16_t PulseWidth;
+    typedef uint8_t Byte;
+
+    static std::size_t const FrameBytes = 5;
+    static std::size_t const FrameBits = FrameBytes * 8;
+
+    // If high signal lasted > ~30us, it's a 1, 0 otherwise.
+    static PulseWidth const OneThreshold = 50;
+
+    // Frames holds decoded readings as a struct-of-arrays, one element per
+    // frame in each array. Readings of invalid frames are decoded regardless.
+    struct Frames
+    {
+        float *humidity;    // Relative humidity, percentage.
+        float *temperature; // Temperature, Celsius.
+        uint8_t *valid;     // Non-zero if the frame's checksum matches.
+    };
+
+    // Classifies a frame's FrameBits pulse widths into its FrameBytes bytes.
+    static void Pack(PulseWidth const * const widths, Byte * const bytes);
+
+    // Decodes count frames, their widths laid out one frame after another.
+    static void Decode(PulseWidth const * const widths,
+                       std::size_t const count,
+                       Frames const &frames);
+
+    static bool Valid(Byte const * const bytes);
+    static float Humidity(Byte const * const bytes);
+    static float Temperature(Byte const * const bytes);
+
+protected:
+
+    static Byte _PackByte(PulseWidth const * const widths);
+
+    // Classifies one pulse at a time; the reference the vectorized path is
+    // checked against, and what's used without it.
+    static Byte _PackByteScalar(PulseWidth const * const widths);
+};
+
+#endif /* DHT22Decoder_hpp */
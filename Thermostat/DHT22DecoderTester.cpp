@@ -0,0 +1,118 @@
+//
+//  DHT22DecoderTester.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "Development.hpp"
+
+#if ! defined(MJB_ARDUINO_LIB_API)
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include "DHT22Decoder.hpp"
+#include "Testing.hpp"
+
+// Exposes the scalar classifier, which the vectorized one must agree with.
+struct Decoder : DHT22Decoder
+{
+    using DHT22Decoder::_PackByteScalar;
+};
+
+// Encodes the bytes as a sensor would send them, with some jitter.
+static void Encode(DHT22Decoder::Byte const * const bytes, DHT22Decoder::PulseWidth * const widths, std::mt19937 &random)
+{
+    for (std::size_t bit = 0; bit < DHT22Decoder::FrameBits; bit++)
+    {
+        bool const one = (bytes[bit / 8] >> (7 - (bit % 8))) & 1;
+        widths[bit] = static_cast<DHT22Decoder::PulseWidth>((one? 68 : 24) + (random() % 8));
+    }
+}
+
+int main(int argc, const char * argv[])
+{
+    std::mt19937 random(28);
+
+    // The vectorized classifier matches the scalar one on any widths, those
+    // around the threshold and at the extremes of the range included.
+    std::vector<DHT22Decoder::PulseWidth> const edges = {0, 1, 49, 50, 51, 52, 0x7FFF, 0x8000, 0x8032, 0xFFFF};
+    unsigned mismatches = 0;
+
+    for (std::size_t trial = 0; trial < 200000; trial++)
+    {
+        DHT22Decoder::PulseWidth widths[8];
+        for (DHT22Decoder::PulseWidth &width : widths)
+        {
+            width = (trial % 2)? edges[random() % edges.size()] : static_cast<DHT22Decoder::PulseWidth>(random());
+        }
+
+        DHT22Decoder::Byte bytes[DHT22Decoder::FrameBytes];
+        DHT22Decoder::PulseWidth frame[DHT22Decoder::FrameBits];
+        for (std::size_t bit = 0; bit < DHT22Decoder::FrameBits; bit++) frame[bit] = widths[bit % 8];
+        DHT22Decoder::Pack(frame, bytes);
+
+        if (bytes[0] != Decoder::_PackByteScalar(widths)) mismatches++;
+    }
+
+    MJB_CHECK(!mismatches);
+
+    // Frames decode to the readings they were encoded from; negative
+    // temperatures are in signed magnitude.
+    DHT22Decoder::Byte const reading[DHT22Decoder::FrameBytes] = {0x02, 0x8C, 0x80, 0x65, 0x73}; // 65.2%, -10.1C
+    DHT22Decoder::PulseWidth widths[2 * DHT22Decoder::FrameBits];
+    Encode(reading, widths, random);
+
+    DHT22Decoder::Byte corrupt[DHT22Decoder::FrameBytes] = {0x02, 0x8C, 0x80, 0x65, 0x74};
+    Encode(corrupt, widths + DHT22Decoder::FrameBits, random);
+
+    float humidity[2], temperature[2];
+    uint8_t valid[2];
+    DHT22Decoder::Decode(widths, 2, {humidity, temperature, valid});
+
+    MJB_CHECK(std::fabs(humidity[0] - 65.2f) < 1e-4f);
+    MJB_CHECK(std::fabs(temperature[0] + 10.1f) < 1e-4f);
+    MJB_CHECK(valid[0]);
+    MJB_CHECK(!valid[1]);
+
+    if (Testing::Benchmarking(argc, argv))
+    {
+        std::size_t const count = 1 << 20;
+        std::vector<DHT22Decoder::PulseWidth> frames(count * DHT22Decoder::FrameBits);
+
+        for (std::size_t frame = 0; frame < count; frame++)
+        {
+            DHT22Decoder::Byte bytes[DHT22Decoder::FrameBytes];
+            for (std::size_t byte = 0; byte < 4; byte++) bytes[byte] = static_cast<DHT22Decoder::Byte>(random());
+            bytes[4] = static_cast<DHT22Decoder::Byte>(bytes[0] + bytes[1] + bytes[2] + bytes[3]);
+            Encode(bytes, frames.data() + (frame * DHT22Decoder::FrameBits), random);
+        }
+
+        std::vector<float> humidities(count), temperatures(count);
+        std::vector<uint8_t> valids(count);
+        DHT22Decoder::Frames const decoded = {humidities.data(), temperatures.data(), valids.data()};
+
+        std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+        std::size_t const rounds = 8;
+        for (std::size_t round = 0; round < rounds; round++) DHT22Decoder::Decode(frames.data(), count, decoded);
+        double const seconds = Testing::Seconds(start);
+
+        std::size_t validFrames = 0;
+        for (uint8_t const flag : valids) validFrames += flag;
+        MJB_CHECK(validFrames == count);
+
+        std::fprintf(stderr, "DHT22Decoder::Decode: %.1fM frames/s (%s)\n", (rounds * count) / seconds / 1e6,
+#if defined(__SSE2__)
+                     "SSE2"
+#else
+                     "scalar"
+#endif
+                     );
+    }
+
+    return Testing::Result("DHT22DecoderTester");
+}
+
+#endif
@@ -0,0 +1,256 @@
+//
+//  DHT22Tester.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "Development.hpp"
+
+#if ! defined(MJB_ARDUINO_LIB_API)
+
+#include <cmath>
+#include "DHT22.hpp"
+#include "Testing.hpp"
+
+static Scheduler::Time now = 0;
+
+Scheduler::Time micros()
+{
+    return now;
+}
+
+// Exposes the reader's phase and the data line, on which the test plays the
+// sensor's part by recording the edges it would have driven.
+struct Probe : DHT22
+{
+    using DHT22::Reader;
+    using DHT22::_dataPin;
+
+    Reader::Phase phase() const
+    {
+        return _reader.phase();
+    }
+
+    Probe(Pin::Identifier const dataPin):
+    DHT22(dataPin)
+    {
+        setAcquisition(DHT22::Acquisition::Asynchronous);
+    }
+};
+
+// Counts the cycles it's run, every one of them, on its own scheduler.
+struct Ticker : Scheduler::Daemon
+{
+    std::size_t ticks = 0;
+
+    int execute(Scheduler::Time const time)
+    {
+        // The following done to suppress unused variable warnings.
+        (void) time;
+        ticks++;
+        return 0;
+    }
+
+    Ticker():
+    Scheduler::Daemon(0, 0)
+    {
+
+    }
+};
+
+// The response's edges, down, up, then down for the first bit, from the time.
+static void Respond(Pin &pin, Scheduler::Time &time)
+{
+    pin.recordEdge(0, time += 20);
+    pin.recordEdge(1, time += 80);
+    pin.recordEdge(0, time += 80);
+}
+
+// The edges of the frame's bits, from the first up to the last, from the time;
+// ones are held high 70us, zeros 26us, as the sensor does.
+static void Transfer(Pin &pin, DHT22Decoder::Byte const (&frame)[DHT22Decoder::FrameBytes],
+                     std::size_t const first, std::size_t const last, Scheduler::Time &time)
+{
+    for (std::size_t bit = first; bit < last; bit++)
+    {
+        bool const one = (frame[bit / 8] >> (7 - (bit % 8))) & 1;
+        pin.recordEdge(1, time += 50);
+        pin.recordEdge(0, time += one? 70 : 26);
+    }
+}
+
+// Runs the schedulers at the time, as the main loop would.
+static void Update(Scheduler::Time const time)
+{
+    Scheduler::UpdateInstances(now = time);
+}
+
+int main(int argc, const char * argv[])
+{
+    // 45.6% and 23.4C, its checksum the low byte of the others' sum.
+    DHT22Decoder::Byte const frame[DHT22Decoder::FrameBytes] = {0x01, 0xC8, 0x00, 0xEA, 0xB3};
+    DHT22Decoder::Byte corrupted[DHT22Decoder::FrameBytes] = {0x01, 0xC8, 0x00, 0xEA, 0xB4};
+
+    std::shared_ptr<Probe> const sensor = std::make_shared<Probe>(4);
+    Pin &pin = sensor->_dataPin();
+
+    Scheduler scheduler;
+    std::shared_ptr<Ticker> const ticker = std::make_shared<Ticker>();
+    MJB_CHECK(scheduler.enqueue(ticker));
+
+    // Sensing starts a read and returns at once; the reader wakes the sensor,
+    // releases the line, and awaits the response, then the frame, a phase
+    // each cycle, while everything else scheduled runs every cycle as well.
+    now = 10000;
+    MJB_CHECK(sensor->sense().empty());
+    MJB_CHECK(sensor->acquiring() && sensor->pending());
+    MJB_CHECK(sensor->phase() == Probe::Reader::Phase::Wake);
+    MJB_CHECK(!sensor->acquire());
+
+    Update(now);
+    MJB_CHECK(sensor->phase() == Probe::Reader::Phase::Release);
+    MJB_CHECK(!pin.capturing() && (pin.value() == 0));
+
+    Update(now + (DHT22_WAKE_TIME / 2));
+    MJB_CHECK(sensor->phase() == Probe::Reader::Phase::Release);
+
+    Update(now + (DHT22_WAKE_TIME / 2));
+    MJB_CHECK(sensor->phase() == Probe::Reader::Phase::Response);
+    MJB_CHECK(pin.capturing() && (pin.mode() == Pin::Mode::Input));
+
+    Scheduler::Time edge = now;
+    Update(now + 100);
+    MJB_CHECK(sensor->phase() == Probe::Reader::Phase::Response);
+
+    Respond(pin, edge);
+    Update(now + 100);
+    MJB_CHECK(sensor->phase() == Probe::Reader::Phase::Transfer);
+
+    Transfer(pin, frame, 0, 20, edge);
+    Update(now + 100);
+    MJB_CHECK(sensor->phase() == Probe::Reader::Phase::Transfer);
+
+    Transfer(pin, frame, 20, DHT22Decoder::FrameBits, edge);
+    Update(now + 100);
+    MJB_CHECK(!sensor->acquiring() && !pin.capturing());
+    MJB_CHECK(sensor->health().readings == 1);
+    MJB_CHECK(std::fabs(static_cast<float>(sensor->humidity()) - 45.6f) < 0.01f);
+    MJB_CHECK(std::fabs(static_cast<float>(sensor->temperature().value(Thermometer::TemperatureUnit::Scale::Celsius)) - 23.4f) < 0.02f);
+    MJB_CHECK(ticker->ticks == 7);
+
+    // Reads wait out the sensor's cooldown.
+    MJB_CHECK(!sensor->acquire());
+    now += DHT22_TIMEOUT + 1;
+
+    // A sensor that never responds is given up on past the response timeout,
+    // one that stops short of a frame past the transfer timeout; both are
+    // recorded as timeouts, and capture is stopped either way.
+    MJB_CHECK(sensor->acquire());
+    Update(now);
+    Update(now + DHT22_WAKE_TIME);
+    Scheduler::Time const released = now;
+
+    Update(released + DHT22_RESPONSE_TIMEOUT);
+    MJB_CHECK(sensor->phase() == Probe::Reader::Phase::Response);
+    Update(released + DHT22_RESPONSE_TIMEOUT + 1);
+    MJB_CHECK(!sensor->acquiring() && !pin.capturing());
+    MJB_CHECK(sensor->health().timeouts == 1);
+
+    now += DHT22_TIMEOUT + 1;
+    MJB_CHECK(sensor->acquire());
+    Update(now);
+    Update(now + DHT22_WAKE_TIME);
+    edge = now;
+    Respond(pin, edge);
+    Transfer(pin, frame, 0, DHT22Decoder::FrameBits - 1, edge);
+
+    Scheduler::Time const deadline = now + DHT22_RESPONSE_TIMEOUT + DHT22_TRANSFER_TIMEOUT;
+    Update(deadline);
+    MJB_CHECK(sensor->phase() == Probe::Reader::Phase::Transfer);
+    Update(deadline + 1);
+    MJB_CHECK(!sensor->acquiring() && !pin.capturing());
+    MJB_CHECK(sensor->health().timeouts == 2);
+    MJB_CHECK(sensor->health().readings == 1);
+
+    // Frames failing their checksum, or out of order, are recorded as such,
+    // and leave the last reading be.
+    now += DHT22_TIMEOUT + 1;
+    MJB_CHECK(sensor->acquire());
+    Update(now);
+    Update(now + DHT22_WAKE_TIME);
+    edge = now;
+    Respond(pin, edge);
+    Transfer(pin, corrupted, 0, DHT22Decoder::FrameBits, edge);
+    Update(now + 100);
+    Update(now + 100);
+    MJB_CHECK(!sensor->acquiring());
+    MJB_CHECK(sensor->health().checksumFailures == 1);
+
+    now += DHT22_TIMEOUT + 1;
+    MJB_CHECK(sensor->acquire());
+    Update(now);
+    Update(now + DHT22_WAKE_TIME);
+    edge = now;
+    pin.recordEdge(1, edge += 20);
+    Respond(pin, edge);
+    Transfer(pin, frame, 0, DHT22Decoder::FrameBits, edge);
+    Update(now + 100);
+    Update(now + 100);
+    MJB_CHECK(!sensor->acquiring());
+    MJB_CHECK(sensor->health().checksumFailures == 2);
+    MJB_CHECK(sensor->health().readings == 1);
+    MJB_CHECK(std::fabs(static_cast<float>(sensor->humidity()) - 45.6f) < 0.01f);
+
+    // Reads straddling the clock's overflow complete all the same.
+    now = ~static_cast<Scheduler::Time>(0) - (DHT22_WAKE_TIME / 2);
+    Update(now);
+    MJB_CHECK(sensor->acquire());
+    Update(now);
+    Update(now + DHT22_WAKE_TIME);
+    MJB_CHECK(sensor->phase() == Probe::Reader::Phase::Response);
+    edge = now;
+    Respond(pin, edge);
+    Update(now + 100);
+    Transfer(pin, frame, 0, DHT22Decoder::FrameBits, edge);
+    Update(now + 100);
+    MJB_CHECK(!sensor->acquiring());
+    MJB_CHECK(sensor->health().readings == 2);
+
+    // The processor time a read costs the cycles it's spread across.
+    if (Testing::Benchmarking(argc, argv))
+    {
+        std::size_t const reads = 100000;
+        now = 0;
+
+        std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+        for (std::size_t read = 0; read < reads; read++)
+        {
+            now += DHT22_TIMEOUT + 1;
+            sensor->acquire();
+            Update(now);
+            Update(now + DHT22_WAKE_TIME);
+            edge = now;
+            Respond(pin, edge);
+            Update(now + 100);
+            Transfer(pin, frame, 0, DHT22Decoder::FrameBits, edge);
+            Update(now + 100);
+        }
+        double const seconds = Testing::Seconds(start);
+
+        MJB_CHECK(sensor->health().readings == (2 + reads));
+        std::fprintf(stderr, "DHT22::Reader: %.2f us/read, across 4 cycles\n", seconds * 1e6 / reads);
+    }
+
+    return Testing::Result("DHT22Tester");
+}
+
+#else
+
+int main()
+{
+    return 0;
+}
+
+#endif
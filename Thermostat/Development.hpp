@@ -17,6 +17,24 @@
     #define MJB_HW_IO_PINS_AVAILABLE
 #elif defined(__linux__) || defined(__unix__) || defined(__MACH__) || defined(_WIN32)
     #define MJB_MULTITHREAD_CAPABLE
+    #if ! defined(_WIN32)
+        #define MJB_POSIX_API
+    #endif
+    // Define MJB_LINUX_GPIO_CHIP as the character device path of the GPIO chip
+    // (e.g. "/dev/gpiochip0") to back pin edge capture with kernel line events.
+    #if defined(__linux__) && defined(MJB_LINUX_GPIO_CHIP)
+        #define MJB_LINUX_GPIO_EVENTS
+    #endif
+    #if defined(__linux__)
+        #define MJB_LINUX_EPOLL
+    #endif
+#endif
+
+// Code executed from an interrupt must reside in IRAM on the ESP8266.
+#if defined(ESP8266)
+    #define MJB_INTERRUPT_HANDLER ICACHE_RAM_ATTR
+#else
+    #define MJB_INTERRUPT_HANDLER
 #endif
 
 #if defined(MJB_DEBUG_LOGGING)
@@ -29,6 +47,67 @@
         #define MJB_DEBUG_LOG_FORMAT(msg, format) Serial.print(msg, format)
         #define MJB_DEBUG_LOG_LINE(msg) Serial.println(msg)
         #define MJB_DEBUG_LOG_LINE_FORMAT(msg, format) Serial.println(msg, format)
+    #elif defined(MJB_MULTITHREAD_CAPABLE)
+        // Messages are logged from many threads at once (as ShardedRunner's
+        // shards), so each thread builds its lines apart, in a fixed buffer
+        // with its own format flags, and writes every one whole, under a lock,
+        // as it's ended; lines longer than the buffer are written in pieces.
+        #include <iostream>
+        #include <mutex>
+        #include <streambuf>
+        namespace MJBDebugLog
+        {
+            class Line : public std::streambuf
+            {
+            public:
+
+                void write()
+                {
+                    static std::mutex mutex;
+                    std::lock_guard<std::mutex> const lock(mutex);
+                    std::cout.write(pbase(), pptr() - pbase()).flush();
+                    setp(_buffer, _buffer + sizeof(_buffer));
+                }
+
+                Line()
+                {
+                    setp(_buffer, _buffer + sizeof(_buffer));
+                }
+
+            protected:
+
+                char _buffer[256];
+
+                int_type overflow(int_type const character)
+                {
+                    write();
+                    if (!traits_type::eq_int_type(character, traits_type::eof())) sputc(traits_type::to_char_type(character));
+                    return traits_type::not_eof(character);
+                }
+            };
+
+            inline std::ostream &Stream()
+            {
+                static thread_local Line line;
+                static thread_local std::ostream stream(&line);
+                return stream;
+            }
+
+            inline std::ostream &End(std::ostream &stream)
+            {
+                stream.put('\n');
+                static_cast<Line *>(stream.rdbuf())->write();
+                return stream;
+            }
+        }
+        #define MJB_DEBUG_LOG_HEX std::hex
+        #define MJB_DEBUG_LOG_BIN std::hex // No std::bin exists
+        #define MJB_DEBUG_LOG_OCT std::oct
+        #define MJB_DEBUG_LOG_DEC std::dec
+        #define MJB_DEBUG_LOG(msg) MJBDebugLog::Stream() << msg
+        #define MJB_DEBUG_LOG_FORMAT(msg, format) MJB_DEBUG_LOG(format << msg)
+        #define MJB_DEBUG_LOG_LINE(msg) MJB_DEBUG_LOG(msg) << MJBDebugLog::End
+        #define MJB_DEBUG_LOG_LINE_FORMAT(msg, format) MJB_DEBUG_LOG(format << msg) << MJBDebugLog::End
     #else
         #include <iostream>
         #define MJB_DEBUG_LOG_HEX std::hex
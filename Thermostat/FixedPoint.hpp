@@ -0,0 +1,139 @@
+//
+//  FixedPoint.hpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef FixedPoint_hpp
+#define FixedPoint_hpp
+
+#include <cstdint>
+#include <type_traits>
+#include "Development.hpp"
+
+// =============================================================================
+// FixedPoint : This class abstracts a signed number with two decimal places,
+// stored as an integer count of hundredths, for targets without an FPU. It's
+// meant as a NumericType for Temperature, where it holds centi-Kelvin; the
+// arithmetic is integer only, rounding to the nearest hundredth.
+// Conversions from floating point numbers are resolved at compile time for
+// constants, and only convert at runtime when given runtime values, as in
+// readings from sensors reporting floats; those convert in single precision,
+// never through double, which targets without an FPU emulate at greater cost
+// still, so values within a float's precision of a tie may round either way.
+// Conversions back are explicit.
+// =============================================================================
+class FixedPoint
+{
+public:
+    typedef int32_t Raw;
+
+    static constexpr Raw Scale = 100;
+
+    constexpr Raw raw() const
+    {
+        return _raw;
+    }
+
+    static constexpr FixedPoint FromRaw(Raw const raw)
+    {
+        return FixedPoint(raw, 0);
+    }
+
+    explicit constexpr operator float() const
+    {
+        return static_cast<float>(_raw) / Scale;
+    }
+
+    explicit constexpr operator double() const
+    {
+        return static_cast<double>(_raw) / Scale;
+    }
+
+    friend constexpr bool operator==(FixedPoint const a, FixedPoint const b) { return a._raw == b._raw; }
+    friend constexpr bool operator!=(FixedPoint const a, FixedPoint const b) { return a._raw != b._raw; }
+    friend constexpr bool operator<(FixedPoint const a, FixedPoint const b)  { return a._raw < b._raw; }
+    friend constexpr bool operator>(FixedPoint const a, FixedPoint const b)  { return a._raw > b._raw; }
+    friend constexpr bool operator<=(FixedPoint const a, FixedPoint const b) { return a._raw <= b._raw; }
+    friend constexpr bool operator>=(FixedPoint const a, FixedPoint const b) { return a._raw >= b._raw; }
+
+    constexpr FixedPoint operator-() const
+    {
+        return FromRaw(-_raw);
+    }
+
+    friend constexpr FixedPoint operator+(FixedPoint const a, FixedPoint const b)
+    {
+        return FromRaw(a._raw + b._raw);
+    }
+
+    friend constexpr FixedPoint operator-(FixedPoint const a, FixedPoint const b)
+    {
+        return FromRaw(a._raw - b._raw);
+    }
+
+    friend constexpr FixedPoint operator*(FixedPoint const a, FixedPoint const b)
+    {
+        return FromRaw(static_cast<Raw>(Divide(static_cast<int64_t>(a._raw) * b._raw, Scale)));
+    }
+
+    // NOTE: Division by zero results in zero, rather than a fault.
+    friend constexpr FixedPoint operator/(FixedPoint const a, FixedPoint const b)
+    {
+        return FromRaw(static_cast<Raw>(Divide(static_cast<int64_t>(a._raw) * Scale, b._raw)));
+    }
+
+    FixedPoint &operator+=(FixedPoint const other) { return *this = *this + other; }
+    FixedPoint &operator-=(FixedPoint const other) { return *this = *this - other; }
+    FixedPoint &operator*=(FixedPoint const other) { return *this = *this * other; }
+    FixedPoint &operator/=(FixedPoint const other) { return *this = *this / other; }
+
+    // Integer division, rounding half away from zero.
+    static constexpr int64_t Divide(int64_t const numerator, int64_t const denominator)
+    {
+        return (!denominator)? 0 :
+               (((numerator < 0) == (denominator < 0))? (numerator + denominator / 2) / denominator :
+                                                        (numerator - denominator / 2) / denominator);
+    }
+
+    constexpr FixedPoint():
+    _raw(0)
+    {
+
+    }
+
+    // Any arithmetic value converts implicitly, rounding to the nearest 0.01.
+    template<typename Arithmetic>
+    constexpr FixedPoint(Arithmetic const value,
+                         typename std::enable_if<std::is_arithmetic<Arithmetic>::value>::type * = nullptr):
+    _raw(std::is_integral<Arithmetic>::value? static_cast<Raw>(value) * Scale :
+         std::is_same<Arithmetic, float>::value? _Round(static_cast<float>(value) * Scale) :
+                                                 _Round(static_cast<double>(value) * Scale))
+    {
+
+    }
+
+protected:
+
+    Raw _raw;
+
+    constexpr FixedPoint(Raw const raw, int):
+    _raw(raw)
+    {
+
+    }
+
+    static constexpr Raw _Round(float const value)
+    {
+        return static_cast<Raw>((value < 0)? value - 0.5f : value + 0.5f);
+    }
+
+    static constexpr Raw _Round(double const value)
+    {
+        return static_cast<Raw>((value < 0)? value - 0.5 : value + 0.5);
+    }
+};
+
+#endif /* FixedPoint_hpp */
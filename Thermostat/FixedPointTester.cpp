@@ -0,0 +1,186 @@
+//
+//  FixedPointTester.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "Development.hpp"
+
+#if ! defined(MJB_ARDUINO_LIB_API)
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "FixedPoint.hpp"
+#include "Aggregators.hpp"
+#include "Thermometer.hpp"
+#include "Testing.hpp"
+
+Scheduler::Time micros()
+{
+    return 0;
+}
+
+// Constants round to the nearest hundredth, half away from zero, at compile
+// time, whatever their type.
+static_assert(FixedPoint(1.125).raw() == 113, "Halves round away from zero.");
+static_assert(FixedPoint(-1.125f).raw() == -113, "Halves round away from zero.");
+static_assert(FixedPoint(0.004f).raw() == 0, "Less than half rounds down.");
+static_assert(FixedPoint(273.15f).raw() == 27315, "Floats round to the nearest hundredth.");
+static_assert(FixedPoint(-40).raw() == -4000, "Integers convert exactly.");
+static_assert((FixedPoint(1.5) * FixedPoint(-0.03)).raw() == -5, "Products round half away from zero.");
+static_assert((FixedPoint(1) / FixedPoint(3)).raw() == 33, "Quotients round to the nearest hundredth.");
+static_assert((FixedPoint(2) / FixedPoint(3)).raw() == 67, "Quotients round to the nearest hundredth.");
+static_assert((FixedPoint(1) / FixedPoint()).raw() == 0, "Division by zero is zero.");
+
+// The heat index, by the same formula as Thermometer::Humiture, in double.
+static double Humiture(double const fahrenheit, double const humidity)
+{
+    double const t = fahrenheit;
+    double const h = humidity / 100;
+
+    if ((t < 70) || (t > 115) || (h < 0) || (h > 0.80)) return t;
+
+    return 0.363445176 + 0.988622465 * t + 4.777114035 * h - 0.114037667 * t * h -
+           0.000850208 * t * t - 0.020716198 * h * h + 0.000687678 * t * t * h + 0.000274954 * t * h * h;
+}
+
+// Rounds the exact result of a raw computation to the nearest hundredth.
+static int64_t Nearest(double const value)
+{
+    return static_cast<int64_t>((value < 0)? value - 0.5 : value + 0.5);
+}
+
+int main(int argc, const char * argv[])
+{
+    typedef Thermometer::TemperatureUnit TemperatureUnit;
+    std::mt19937 random(36);
+    unsigned mismatches = 0;
+
+    // Arithmetic on any values rounds exact results to the nearest hundredth,
+    // and runtime floats convert to the nearest hundredth too, but for ties
+    // within single precision.
+    std::uniform_int_distribution<int32_t> raw(-100000, 100000);
+    for (std::size_t index = 0; index < 100000; index++)
+    {
+        FixedPoint const a = FixedPoint::FromRaw(raw(random));
+        FixedPoint const b = FixedPoint::FromRaw(raw(random));
+
+        if ((a + b).raw() != (a.raw() + b.raw())) mismatches++;
+        if ((a - b).raw() != (a.raw() - b.raw())) mismatches++;
+        if ((a * b).raw() != Nearest(static_cast<double>(a.raw()) * b.raw() / 100)) mismatches++;
+        if (b.raw() && ((a / b).raw() != Nearest(static_cast<double>(a.raw()) * 100 / b.raw()))) mismatches++;
+
+        float const value = static_cast<float>(a.raw() + 0.25 * (index % 4)) / 100;
+        double const exact = static_cast<double>(value) * 100;
+        if (std::fabs(FixedPoint(value).raw() - exact) > (0.5 + std::fabs(exact) * FLT_EPSILON)) mismatches++;
+    }
+
+    MJB_CHECK(!mismatches);
+
+    // Fixed point temperatures convert between scales to within a hundredth
+    // of a degree.
+    typedef Temperature<FixedPoint> Fixed;
+    double deviation = 0;
+
+    for (int32_t centiKelvin = 20000; centiKelvin < 40000; centiKelvin += 7)
+    {
+        Fixed const temperature(FixedPoint::FromRaw(centiKelvin));
+        double const kelvin = centiKelvin / 100.0;
+
+        deviation = std::max(deviation, std::fabs(static_cast<double>(temperature.value(Fixed::Celsius)) - (kelvin - 273.15)));
+        deviation = std::max(deviation, std::fabs(static_cast<double>(temperature.value(Fixed::Fahrenheit)) - ((kelvin - 273.15) * 1.8 + 32)));
+        deviation = std::max(deviation, std::fabs(static_cast<double>(Fixed(temperature.value(Fixed::Fahrenheit), Fixed::Fahrenheit).value()) - kelvin));
+    }
+
+    MJB_CHECK(deviation <= 0.01);
+
+    // Heat indices agree with the formula's, in double, to within 0.01K (the
+    // temperature's resolution with fixed point), across the formula's range
+    // and beyond it, where they're the temperature itself.
+    deviation = 0;
+    for (int fahrenheit = 6000; fahrenheit <= 12000; fahrenheit += 13)
+    {
+        for (int humidity = 0; humidity <= 10000; humidity += 37)
+        {
+            TemperatureUnit const dryBulb(TemperatureUnit::value_type(fahrenheit / 100.0f), TemperatureUnit::Fahrenheit);
+            double const expected = Humiture(static_cast<double>(dryBulb.value(TemperatureUnit::Fahrenheit)), humidity / 100.0);
+
+            TemperatureUnit const humiture = Thermometer::Humiture(dryBulb, TemperatureUnit::value_type(humidity / 100.0f));
+            deviation = std::max(deviation, std::fabs(static_cast<double>(humiture.value()) - ((expected - 32) / 1.8 + 273.15)));
+        }
+    }
+
+    MJB_CHECK(deviation <= 0.01);
+
+    // Smoothing in fixed point tracks smoothing in float to within a couple of
+    // hundredths, noise within the minimum deviation kept and spikes rejected
+    // alike.
+    ReadingFilter<float, 5> floats(0.5f, 3, 0.5f);
+    ReadingFilter<FixedPoint, 5> fixeds(0.5, 3, 0.5);
+    std::uniform_real_distribution<float> noise(-0.2f, 0.2f);
+    std::size_t spikes = 0, rejections = 0;
+    deviation = 0;
+
+    for (std::size_t index = 0; index < 10000; index++)
+    {
+        bool const spike = (index % 97) == 96;
+        float const kelvin = 295 + noise(random) + (spike? 5 : 0);
+        float const smoothed = floats.update(kelvin);
+        deviation = std::max<double>(deviation, std::fabs(static_cast<float>(fixeds.update(kelvin)) - smoothed));
+
+        spikes += spike;
+        rejections += spike && floats.outliers().rejected() && fixeds.outliers().rejected();
+    }
+
+    MJB_CHECK(deviation <= 0.02);
+    MJB_CHECK(spikes && (rejections == spikes));
+    MJB_CHECK((floats.outliers().rejections() == spikes) && (fixeds.outliers().rejections() == spikes));
+
+    // The host's time for a sample's worth of arithmetic, in float and fixed
+    // point; on the ESP8266, which has no FPU, float runs in software.
+    if (Testing::Benchmarking(argc, argv))
+    {
+        std::size_t const samples = 10000000;
+        std::vector<float> readings(4096);
+        for (float &reading : readings) reading = 295 + noise(random);
+
+        ReadingFilter<float, 5> floatFilter(0.5f, 3, 0.5f);
+        ReadingFilter<FixedPoint, 5> fixedFilter(0.5, 3, 0.5);
+        double checksum = 0;
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (std::size_t index = 0; index < samples; index++)
+        {
+            float const kelvin = readings[index % 4096];
+            checksum += floatFilter.update(Temperature<float>(kelvin).value(Temperature<float>::Fahrenheit));
+        }
+        double const floats = Testing::Seconds(start);
+
+        start = std::chrono::steady_clock::now();
+        for (std::size_t index = 0; index < samples; index++)
+        {
+            FixedPoint const kelvin = readings[index % 4096];
+            checksum += static_cast<double>(fixedFilter.update(Fixed(kelvin).value(Fixed::Fahrenheit)));
+        }
+        double const fixed = Testing::Seconds(start);
+
+        std::fprintf(stderr, "Convert and filter: %.1f ns/sample float, %.1f ns/sample fixed point (%g)\n",
+                     floats * 1e9 / samples, fixed * 1e9 / samples, checksum);
+    }
+
+    return Testing::Result("FixedPointTester");
+}
+
+#else
+
+int main()
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,313 @@
+//
+//  History.hpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef History_hpp
+#define History_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include "Development.hpp"
+#include "Scheduler.hpp"
+#include "Thermometer.hpp"
+
+// =============================================================================
+// History : This class keeps the last Capacity control cycles of a thermostat,
+// in a ring of 6 byte records, overwriting the oldest once full. Records hold
+// the changes since the record before them, bit-packed as follows:
+//
+//   Bits    Field                       Unit        Range
+//   0-11    Time since the last cycle   1s          0 to 4095s (saturates)
+//   12-20   Temperature change          0.05K       -12.8K to +12.75K
+//   21-27   Humidity change             0.5%        -32% to +31.5%
+//   28-34   Humiture over temperature   0.25K       -16K to +15.75K (absolute)
+//   35-40   Target change               0.25K       -8K to +7.75K
+//   41-42   Mode
+//   43-44   Status
+//   45-47   Signal lines (Actuator::Pattern of the first three lines)
+//
+// Changes are encoded against the values as they'll be decoded, rather than
+// the values given, so rounding never accumulates; changes too large for a
+// record are carried into the next ones, which catch up within a few cycles.
+// The humiture is signed, as heat indices may be below the temperature, and
+// taken over the temperature as recorded, so it holds while that catches up.
+// Appends take constant time, and iterating decodes records in place; neither
+// allocates. Times are seconds since the first cycle recorded.
+// =============================================================================
+template<std::size_t Capacity>
+class History
+{
+    static_assert(Capacity > 0, "A history needs room for at least one record.");
+
+public:
+
+    static constexpr std::size_t RecordSize = 6;
+
+    struct Entry
+    {
+        uint32_t time;
+        Thermometer::TemperatureUnit temperature;
+        Thermometer::TemperatureUnit::value_type humidity;
+        Thermometer::TemperatureUnit humiture;
+        Thermometer::TemperatureUnit target;
+        uint8_t mode;
+        uint8_t status;
+        uint8_t pattern;
+    };
+
+    // =========================================================================
+    // Iterator : Decodes the records from the oldest on, one at a time.
+    // =========================================================================
+    class Iterator
+    {
+    public:
+
+        Entry operator*() const
+        {
+            return _history._entry(_state, _record);
+        }
+
+        Iterator &operator++()
+        {
+            if (++_index < _history._size) _advance();
+            return *this;
+        }
+
+        bool operator==(Iterator const &other) const
+        {
+            return _index == other._index;
+        }
+
+        bool operator!=(Iterator const &other) const
+        {
+            return _index != other._index;
+        }
+
+        Iterator(History const &history, std::size_t const index):
+        _history(history),
+        _index(index),
+        _state(history._base),
+        _record(0)
+        {
+            if (_index < _history._size) _advance();
+        }
+
+    protected:
+
+        History const &_history;
+        std::size_t _index;
+        typename History::State _state;
+        uint64_t _record;
+
+        void _advance()
+        {
+            _record = _history._load((_history._head + _index) % Capacity);
+            History::_Apply(_state, _record);
+        }
+    };
+
+    std::size_t size() const
+    {
+        return _size;
+    }
+
+    static constexpr std::size_t capacity()
+    {
+        return Capacity;
+    }
+
+    bool empty() const
+    {
+        return !_size;
+    }
+
+    Iterator begin() const
+    {
+        return Iterator(*this, 0);
+    }
+
+    Iterator end() const
+    {
+        return Iterator(*this, _size);
+    }
+
+    // The latest cycle recorded; only valid if the history isn't empty.
+    Entry back() const
+    {
+        return _entry(_last, _load((_head + _size - 1) % Capacity));
+    }
+
+    void append(Scheduler::Time const time,
+                Thermometer::TemperatureUnit const &temperature,
+                Thermometer::TemperatureUnit::value_type const humidity,
+                Thermometer::TemperatureUnit const &humiture,
+                Thermometer::TemperatureUnit const &target,
+                uint8_t const mode,
+                uint8_t const status,
+                uint8_t const pattern)
+    {
+        State const sample = {0,
+                              _Quantize(temperature.value(), 20),
+                              _Quantize(static_cast<float>(humidity), 2),
+                              _Quantize(target.value(), 4)};
+
+        uint64_t record = 0;
+
+        if (!_size)
+        {
+            // The first record starts the history off where the cycle was.
+            _base = _last = sample;
+            _time = time;
+            _remainder = 0;
+        }
+        else
+        {
+            // Time is kept in seconds, as Scheduler::Time wraps in about 71 minutes.
+            _remainder += static_cast<Scheduler::Time>(time - _time);
+            _time = time;
+
+            uint32_t const seconds = _remainder / 1000000;
+            _remainder %= 1000000;
+
+            record |= static_cast<uint64_t>(seconds < 4095? seconds : 4095);
+        }
+
+        record |= _Encode(_last.temperature, sample.temperature, 9) << 12;
+        record |= _Encode(_last.humidity, sample.humidity, 7) << 21;
+        record |= _Offset(static_cast<float>(humiture.value()) - (_last.temperature / 20.0f)) << 28;
+        record |= _Encode(_last.target, sample.target, 6) << 35;
+        record |= static_cast<uint64_t>(mode & 0x3) << 41;
+        record |= static_cast<uint64_t>(status & 0x3) << 43;
+        record |= static_cast<uint64_t>(pattern & 0x7) << 45;
+        _last.time += static_cast<uint32_t>(record & 0xFFF);
+
+        if (_size == Capacity)
+        {
+            // The oldest record is folded into the base before it's overwritten.
+            History::_Apply(_base, _load(_head));
+            _head = (_head + 1) % Capacity;
+            _size--;
+        }
+
+        _store((_head + _size) % Capacity, record);
+        _size++;
+    }
+
+    void clear()
+    {
+        _size = 0;
+        _head = 0;
+    }
+
+    History():
+    _head(0),
+    _size(0),
+    _time(0),
+    _remainder(0)
+    {
+        _base = _last = State();
+    }
+
+protected:
+
+    // The decoded values, in the records' own units.
+    struct State
+    {
+        uint32_t time;
+        int32_t temperature;    // 0.05K
+        int32_t humidity;       // 0.5%
+        int32_t target;         // 0.25K
+    };
+
+    uint8_t _records[Capacity][RecordSize];
+    std::size_t _head;          // The oldest record.
+    std::size_t _size;
+
+    State _base;                // The values before the oldest record.
+    State _last;                // The values after the latest record.
+    Scheduler::Time _time;      // The latest record's cycle time.
+    Scheduler::Time _remainder; // Microseconds not yet accounted for.
+
+    uint64_t _load(std::size_t const index) const
+    {
+        uint64_t record = 0;
+        for (std::size_t byte = 0; byte < RecordSize; byte++)
+        {
+            record |= static_cast<uint64_t>(_records[index][byte]) << (8 * byte);
+        }
+        return record;
+    }
+
+    void _store(std::size_t const index, uint64_t const record)
+    {
+        for (std::size_t byte = 0; byte < RecordSize; byte++)
+        {
+            _records[index][byte] = static_cast<uint8_t>(record >> (8 * byte));
+        }
+    }
+
+    Entry _entry(State const &state, uint64_t const record) const
+    {
+        Thermometer::TemperatureUnit const temperature(Thermometer::TemperatureUnit::value_type(state.temperature / 20.0f));
+
+        return {state.time,
+                temperature,
+                Thermometer::TemperatureUnit::value_type(state.humidity / 2.0f),
+                Thermometer::TemperatureUnit(Thermometer::TemperatureUnit::value_type((state.temperature / 20.0f) + (_Decode(record >> 28, 7) / 4.0f))),
+                Thermometer::TemperatureUnit(Thermometer::TemperatureUnit::value_type(state.target / 4.0f)),
+                static_cast<uint8_t>((record >> 41) & 0x3),
+                static_cast<uint8_t>((record >> 43) & 0x3),
+                static_cast<uint8_t>((record >> 45) & 0x7)};
+    }
+
+    static void _Apply(State &state, uint64_t const record)
+    {
+        state.time += static_cast<uint32_t>(record & 0xFFF);
+        state.temperature += _Decode(record >> 12, 9);
+        state.humidity += _Decode(record >> 21, 7);
+        state.target += _Decode(record >> 35, 6);
+    }
+
+    // Encodes the change from last to value in a field of the given width,
+    // moving last by as much as the field holds.
+    static uint64_t _Encode(int32_t &last, int32_t const value, unsigned const bits)
+    {
+        int32_t const limit = 1 << (bits - 1);
+        int32_t const change = _Clamp(value - last, -limit, limit - 1);
+        last += change;
+        return static_cast<uint64_t>(change) & ((uint64_t(1) << bits) - 1);
+    }
+
+    // Encodes the humiture's offset from the temperature, in 0.25K, saturating.
+    static uint64_t _Offset(float const offset)
+    {
+        return static_cast<uint64_t>(_Clamp(_Quantize(offset, 4), -64, 63)) & 0x7F;
+    }
+
+    static int32_t _Decode(uint64_t const field, unsigned const bits)
+    {
+        int32_t const value = static_cast<int32_t>(field & ((uint64_t(1) << bits) - 1));
+        return (value & (1 << (bits - 1)))? value - (1 << bits) : value;
+    }
+
+    template<typename NumericType>
+    static int32_t _Quantize(NumericType const value, int32_t const steps)
+    {
+        float const scaled = static_cast<float>(value) * steps;
+        return static_cast<int32_t>((scaled < 0)? scaled - 0.5f : scaled + 0.5f);
+    }
+
+    static int32_t _Clamp(int32_t const value, int32_t const minimum, int32_t const maximum)
+    {
+        return (value < minimum)? minimum : ((value > maximum)? maximum : value);
+    }
+};
+
+template<std::size_t Capacity>
+constexpr std::size_t History<Capacity>::RecordSize;
+
+#endif /* History_hpp */
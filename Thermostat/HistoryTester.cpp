@@ -0,0 +1,159 @@
+//
+//  HistoryTester.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "Development.hpp"
+
+#if ! defined(MJB_ARDUINO_LIB_API)
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "History.hpp"
+#include "Testing.hpp"
+
+Scheduler::Time micros()
+{
+    return 0;
+}
+
+typedef Thermometer::TemperatureUnit TemperatureUnit;
+
+static float Kelvin(TemperatureUnit const &temperature)
+{
+    return static_cast<float>(temperature.value());
+}
+
+// A cycle as appended, its time in microseconds since the first, unwrapped.
+struct Cycle
+{
+    uint64_t elapsed;
+    float temperature;
+    float humidity;
+    float humiture;
+    float target;
+    uint8_t mode;
+    uint8_t status;
+    uint8_t pattern;
+};
+
+// Whether the entry decodes the cycle, to within the records' units (and the
+// temperatures' own resolution), its time to the second.
+static bool Decodes(History<64>::Entry const &entry, Cycle const &cycle)
+{
+    return (entry.time == (cycle.elapsed / 1000000)) &&
+           (std::fabs(Kelvin(entry.temperature) - cycle.temperature) <= 0.025f + 0.01f) &&
+           (std::fabs(static_cast<float>(entry.humidity) - cycle.humidity) <= 0.25f + 0.01f) &&
+           (std::fabs(Kelvin(entry.humiture) - cycle.humiture) <= 0.125f + 0.025f + 0.01f) &&
+           (std::fabs(Kelvin(entry.target) - cycle.target) <= 0.125f + 0.01f) &&
+           (entry.mode == cycle.mode) && (entry.status == cycle.status) && (entry.pattern == cycle.pattern);
+}
+
+int main(int argc, const char * argv[])
+{
+    // The following done to suppress unused variable warnings.
+    (void) argc;
+    (void) argv;
+
+    History<4> history;
+    TemperatureUnit const target(295);
+
+    // Heat indices below the temperature, as the formula gives at 95F and
+    // 10%, are kept as such; those above it as well.
+    TemperatureUnit const temperature(TemperatureUnit(95, TemperatureUnit::Scale::Fahrenheit));
+    TemperatureUnit const below(Thermometer::Humiture(temperature, 10));
+    MJB_CHECK(Kelvin(below) < Kelvin(temperature));
+
+    history.append(0, temperature, 10, below, target, 1, 1, 4);
+    MJB_CHECK(std::fabs(Kelvin(history.back().humiture) - Kelvin(below)) <= 0.125f + 0.025f);
+
+    TemperatureUnit const above(Kelvin(temperature) + 5);
+    history.append(60000000, temperature, 10, above, target, 1, 1, 4);
+    MJB_CHECK(std::fabs(Kelvin(history.back().humiture) - Kelvin(above)) <= 0.125f + 0.025f);
+
+    // Offsets past the field's range saturate.
+    history.append(120000000, temperature, 10, TemperatureUnit(Kelvin(temperature) - 40), target, 1, 1, 4);
+    MJB_CHECK(std::fabs(Kelvin(history.back().humiture) - (Kelvin(temperature) - 16)) <= 0.025f);
+
+    // While a large temperature change is carried over a few records, the
+    // humiture recorded still holds.
+    TemperatureUnit const jump(Kelvin(temperature) + 30);
+    history.append(180000000, jump, 10, TemperatureUnit(Kelvin(jump) - 3), target, 1, 1, 4);
+    History<4>::Entry const entry = history.back();
+    MJB_CHECK(Kelvin(entry.temperature) < Kelvin(jump) - 10);
+    MJB_CHECK(std::fabs(Kelvin(entry.humiture) - (Kelvin(jump) - 3)) <= 0.125f + 0.025f);
+
+    // Entries iterate from the oldest on, and decode as the latest did.
+    std::size_t count = 0;
+    for (History<4>::Entry const &decoded : history)
+    {
+        count++;
+        if (count == 1) MJB_CHECK(Kelvin(decoded.humiture) < Kelvin(decoded.temperature));
+        if (count == 2) MJB_CHECK(Kelvin(decoded.humiture) > Kelvin(decoded.temperature));
+    }
+    MJB_CHECK(count == 4);
+
+    // Cycles wandering at random, at random intervals, decode as appended, to
+    // within the records' units, across many times the history's capacity
+    // (as the oldest records are folded into the base), and across the clock's
+    // overflow; settings and signal lines are kept exactly.
+    std::mt19937 random(44);
+    std::uniform_real_distribution<float> step(-1, 1);
+    History<64> walk;
+    std::vector<Cycle> cycles;
+    Scheduler::Time time = ~static_cast<Scheduler::Time>(0) - 30000000;
+    Cycle cycle = {0, 295, 40, 295, 294, 0, 0, 0};
+    bool decoded = true;
+
+    for (std::size_t index = 0; index < 1000; index++)
+    {
+        if (index)
+        {
+            Scheduler::Time const interval = 1 + (random() % 600000000);
+            time += interval;
+            cycle.elapsed += interval;
+        }
+
+        cycle.temperature += step(random);
+        cycle.humidity = std::min(100.0f, std::max(0.0f, cycle.humidity + 5 * step(random)));
+        cycle.humiture = cycle.temperature + 3 * step(random);
+        if (!(random() % 10)) cycle.target += 2 * step(random);
+        cycle.mode = random() % 4;
+        cycle.status = random() % 4;
+        cycle.pattern = random() % 8;
+
+        walk.append(time,
+                    TemperatureUnit(TemperatureUnit::value_type(cycle.temperature)),
+                    TemperatureUnit::value_type(cycle.humidity),
+                    TemperatureUnit(TemperatureUnit::value_type(cycle.humiture)),
+                    TemperatureUnit(TemperatureUnit::value_type(cycle.target)),
+                    cycle.mode,
+                    cycle.status,
+                    cycle.pattern);
+        cycles.push_back(cycle);
+
+        decoded = decoded && Decodes(walk.back(), cycle) && (walk.size() == std::min<std::size_t>(cycles.size(), 64));
+
+        std::size_t position = cycles.size() - walk.size();
+        for (History<64>::Entry const &entry : walk) decoded = decoded && Decodes(entry, cycles[position++]);
+    }
+
+    MJB_CHECK(decoded);
+    MJB_CHECK(cycles.back().elapsed > (2 * (uint64_t(~static_cast<Scheduler::Time>(0)) + 1)));
+
+    return Testing::Result("HistoryTester");
+}
+
+#else
+
+int main()
+{
+    return 0;
+}
+
+#endif
@@ -8,6 +8,14 @@
 
 #include "Pin.hpp"
 
+#if defined(MJB_LINUX_GPIO_EVENTS)
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+#endif
+
 // =============================================================================
 // Pin : Static Variables Declaration
 // =============================================================================
@@ -19,6 +27,73 @@ Pin::Set &Pin::_Reserved()
     return _reserved;
 }
 
+#if defined(MJB_MULTITHREAD_CAPABLE)
+std::mutex &Pin::_ReservedLock()
+{
+    static std::mutex _lock;
+    return _lock;
+}
+#endif
+
+
+// =============================================================================
+// Pin::EdgeBuffer : Implementation
+// =============================================================================
+bool MJB_INTERRUPT_HANDLER Pin::EdgeBuffer::push(Pin::Edge const &edge)
+{
+    Pin::EdgeBuffer::Index const head = _head.load(std::memory_order_relaxed);
+
+    // When full, drop the newest edge; the consumer is still reading the oldest.
+    if ((head - _tail.load(std::memory_order_acquire)) >= Pin::EdgeBuffer::Capacity)
+    {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    _edges[head & (Pin::EdgeBuffer::Capacity - 1)] = edge;
+
+    // Publish the edge only after it's been written to the buffer.
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool Pin::EdgeBuffer::pop(Pin::Edge &edge)
+{
+    Pin::EdgeBuffer::Index const tail = _tail.load(std::memory_order_relaxed);
+
+    if (tail == _head.load(std::memory_order_acquire)) return false; // Empty.
+
+    edge = _edges[tail & (Pin::EdgeBuffer::Capacity - 1)];
+
+    // Release the slot only after it's been read from the buffer.
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+Pin::EdgeBuffer::Index Pin::EdgeBuffer::size() const
+{
+    return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+}
+
+Pin::EdgeBuffer::Index Pin::EdgeBuffer::dropped() const
+{
+    return _dropped.load(std::memory_order_relaxed);
+}
+
+void Pin::EdgeBuffer::clear()
+{
+    _tail.store(_head.load(std::memory_order_acquire), std::memory_order_release);
+    _dropped.store(0, std::memory_order_relaxed);
+}
+
+Pin::EdgeBuffer::EdgeBuffer():
+_head(0),
+_tail(0),
+_dropped(0)
+{
+    
+}
+
 
 // =============================================================================
 // Pin : Implementation
@@ -120,6 +195,123 @@ void Pin::setConfiguration(Pin::Configuration const &configuration)
     setValue(configuration.value);
 }
 
+bool Pin::capturing() const
+{
+    return _capturing;
+}
+
+bool Pin::setCapturing(bool const capturing)
+{
+    if (capturing == this->capturing()) return true;
+
+    if (!capturing)
+    {
+        // NOTE: The buffer is kept around so remaining edges may be consumed.
+#if defined(MJB_ARDUINO_LIB_API) && defined(ESP8266)
+        detachInterrupt(digitalPinToInterrupt(identity()));
+#endif
+#if defined(MJB_LINUX_GPIO_EVENTS)
+        _collectEdgeEvents(); // Retrieve whatever the kernel captured so far.
+        close(_edgeEventDescriptor);
+        _edgeEventDescriptor = -1;
+#endif
+        _capturing = false;
+        return true;
+    }
+
+    if (!ready()) {
+#if defined(MJB_DEBUG_LOGGING_PIN)
+        MJB_DEBUG_LOG("[Pin <");
+        MJB_DEBUG_LOG_FORMAT((unsigned long) this, MJB_DEBUG_LOG_HEX);
+        MJB_DEBUG_LOG(">] ERROR: Failed to capture pin ");
+        MJB_DEBUG_LOG_FORMAT(identity(), MJB_DEBUG_LOG_DEC);
+        MJB_DEBUG_LOG_LINE(" edges; currently invalid!");
+#endif
+        return false;
+    }
+
+    if (_edges) _edges->clear(); // Safe; the producer is inactive right now.
+    else _edges.reset(new Pin::EdgeBuffer());
+
+#if defined(MJB_ARDUINO_LIB_API)
+#if defined(ESP8266)
+    attachInterruptArg(digitalPinToInterrupt(identity()), Pin::_EdgeInterrupt, this, CHANGE);
+#else
+    return false; // No interrupt argument support, edges can't be attributed.
+#endif
+#endif
+
+#if defined(MJB_LINUX_GPIO_EVENTS)
+    int const chip = open(MJB_LINUX_GPIO_CHIP, O_RDONLY | O_CLOEXEC);
+    if (chip < 0) return false;
+
+    struct gpioevent_request request;
+    std::memset(&request, 0, sizeof(request));
+    request.lineoffset = identity();
+    request.handleflags = GPIOHANDLE_REQUEST_INPUT;
+    request.eventflags = GPIOEVENT_REQUEST_BOTH_EDGES;
+    std::strncpy(request.consumer_label, "Thermostat", sizeof(request.consumer_label) - 1);
+
+    int const result = ioctl(chip, GPIO_GET_LINEEVENT_IOCTL, &request);
+    close(chip);
+
+    if (result < 0) return false;
+
+    // Events are drained lazily by the consumer, so never block on them.
+    fcntl(request.fd, F_SETFL, fcntl(request.fd, F_GETFL) | O_NONBLOCK);
+    _edgeEventDescriptor = request.fd;
+#endif
+
+    _capturing = true;
+    return true;
+}
+
+bool MJB_INTERRUPT_HANDLER Pin::recordEdge(Pin::Value const value, Scheduler::Time const time)
+{
+    // Edges seen once capture's disabled belong to no one's transaction.
+    return _capturing && _edges && _edges->push({value, time});
+}
+
+bool Pin::nextEdge(Pin::Edge &edge)
+{
+#if defined(MJB_LINUX_GPIO_EVENTS)
+    _collectEdgeEvents();
+#endif
+    return _edges && _edges->pop(edge);
+}
+
+Pin::EdgeBuffer::Index Pin::capturedEdges()
+{
+#if defined(MJB_LINUX_GPIO_EVENTS)
+    _collectEdgeEvents();
+#endif
+    return _edges? _edges->size() : 0;
+}
+
+#if defined(MJB_LINUX_GPIO_EVENTS)
+void Pin::_collectEdgeEvents()
+{
+    if (_edgeEventDescriptor < 0) return;
+
+    struct gpioevent_data event;
+    while (read(_edgeEventDescriptor, &event, sizeof(event)) == sizeof(event))
+    {
+        // NOTE: Kernel timestamps are in nanoseconds on their own clock; only
+        // differences between edges are meaningful, just as with micros().
+        recordEdge((event.id == GPIOEVENT_EVENT_RISING_EDGE)? 1 : 0,
+                   static_cast<Scheduler::Time>(event.timestamp / 1000));
+    }
+}
+#endif
+
+#if defined(MJB_ARDUINO_LIB_API)
+void MJB_INTERRUPT_HANDLER Pin::_EdgeInterrupt(void * const pin)
+{
+    Pin * const instance = static_cast<Pin *>(pin);
+    instance->recordEdge(digitalRead(instance->identity()), micros());
+}
+#endif
+
 Pin::Set Pin::MakeSet(Pin::Arrangement const &pins)
 {
     Pin::Set set;
@@ -134,6 +326,11 @@ bool Pin::_Reserve(std::shared_ptr<Pin> const &pin)
 {
     Pin::Identifier const identity = pin->identity();
 
+#if defined(MJB_MULTITHREAD_CAPABLE)
+    // Pins may be reserved on any thread, as by the shards of a ShardedRunner.
+    std::lock_guard<std::mutex> const lock(Pin::_ReservedLock());
+#endif
+
     // Note: Count is optimal here due to the fact _pins is a map log(n).
     if (!pin || Pin::_Reserved().count(identity) > 0) {
 #if defined(MJB_DEBUG_LOGGING_PIN)
@@ -163,13 +360,20 @@ bool Pin::_Release(std::shared_ptr<Pin> const &pin)
         return false;
     }
 
+#if defined(MJB_MULTITHREAD_CAPABLE)
+    std::lock_guard<std::mutex> const lock(Pin::_ReservedLock());
+#endif
     return Pin::_Reserved().erase(identity);
 }
 
 Pin::Pin(Pin::Identifier const identifier):
 _identity(identifier),
 _value(0),
-_mode(Pin::Mode::Auto) // Will be overwritten below; must not be invalid, otherwise setMode fails!
+_mode(Pin::Mode::Auto), // Will be overwritten below; must not be invalid, otherwise setMode fails!
+_capturing(false)
+#if defined(MJB_LINUX_GPIO_EVENTS)
+,_edgeEventDescriptor(-1)
+#endif
 {
 #if defined(MJB_HW_IO_PINS_AVAILABLE)
     setMode(Pin::_Reserve(std::static_pointer_cast<Pin>(self()))? Pin::Mode::Auto : Pin::Mode::Invalid);
@@ -179,13 +383,18 @@ _mode(Pin::Mode::Auto) // Will be overwritten below; must not be invalid, otherw
 Pin::Pin():
 _identity(0),
 _value(0),
-_mode(Pin::Mode::Invalid)
+_mode(Pin::Mode::Invalid),
+_capturing(false)
+#if defined(MJB_LINUX_GPIO_EVENTS)
+,_edgeEventDescriptor(-1)
+#endif
 {
     
 }
 
 Pin::~Pin()
 {
+    setCapturing(false); // The interrupt handler must not outlive the pin.
     setMode(Pin::_Release(std::static_pointer_cast<Pin>(self()))? Pin::Mode::Invalid : mode());
 }
 
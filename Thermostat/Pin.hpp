@@ -11,13 +11,21 @@
 
 #include <map>
 #include <vector>
+#include <atomic>
+#include <memory>
+#include <cstdint>
 #include "Development.hpp"
 #include "Accessible.hpp"
+#include "Scheduler.hpp"
 
 #if defined(MJB_ARDUINO_LIB_API)
 #include <Arduino.h>
 #endif
 
+#if defined(MJB_MULTITHREAD_CAPABLE)
+#include <mutex>
+#endif
+
 // =============================================================================
 // Pin : This class abstracts the I/O pins found on the development board. The
 // class keeps track of all pins available.
@@ -46,6 +54,49 @@ class Pin : public Accessible
       Value value;
     };
 
+    // Edge denotes a captured input transition: the level the pin settled on
+    // and the time, in microseconds, at which the transition was observed.
+    struct Edge
+    {
+      Value value;
+      Scheduler::Time time;
+    };
+
+    // =========================================================================
+    // EdgeBuffer: A single-producer, single-consumer, lock-free ring buffer of
+    // captured edges. The producer is the interrupt handler (or whichever
+    // backend observes the line), the consumer is the protocol decoder.
+    // =========================================================================
+    class EdgeBuffer
+    {
+    public:
+        typedef uint32_t Index;
+
+        // NOTE: Capacity must be a power of two so indices may wrap freely.
+        // A DHT22 frame is ~84 edges, so 128 holds a full frame comfortably.
+        static Index const Capacity = 128;
+
+        // Producer side; safe to call from an interrupt handler.
+        bool push(Edge const &edge);
+
+        // Consumer side; returns false if there's nothing to retrieve.
+        bool pop(Edge &edge);
+
+        Index size() const;
+        Index dropped() const;
+
+        // NOTE: Only safe while the producer is inactive (capture disabled).
+        void clear();
+
+        EdgeBuffer();
+
+    protected:
+        Edge _edges[Capacity];
+        std::atomic<Index> _head;    // Written by the producer only.
+        std::atomic<Index> _tail;    // Written by the consumer only.
+        std::atomic<Index> _dropped; // Edges lost due to a full buffer.
+    };
+
     Identifier identity() const;
 
     bool ready() const;
@@ -60,6 +111,19 @@ class Pin : public Accessible
     Configuration configuration() const;
     void setConfiguration(Configuration const &configuration);
 
+    // Edge capture records every input transition into the pin's EdgeBuffer,
+    // allowing signals to be decoded after the fact rather than by busy-waiting.
+    // On hardware the edges are recorded by an interrupt handler, on Linux by
+    // GPIO line events (see MJB_LINUX_GPIO_CHIP), otherwise only recordEdge(...)
+    // feeds the buffer, which serves as a simulated backend. Edges are only
+    // recorded while capturing, though those left once it's disabled remain.
+    bool capturing() const;
+    bool setCapturing(bool const capturing);
+
+    bool recordEdge(Value const value, Scheduler::Time const time);
+    bool nextEdge(Edge &edge);
+    EdgeBuffer::Index capturedEdges();
+
     static Set MakeSet(Arrangement const &pins);
 
     Pin(Identifier const identifier);
@@ -72,7 +136,25 @@ class Pin : public Accessible
     Value _value;
     Mode _mode;
 
+    // The buffer is only allocated once capture is first requested,
+    // since most pins (relays, for example) will never need one.
+    std::unique_ptr<EdgeBuffer> _edges;
+    bool _capturing;
+
+#if defined(MJB_LINUX_GPIO_EVENTS)
+    int _edgeEventDescriptor;
+
+    void _collectEdgeEvents();
+#endif
+
+#if defined(MJB_ARDUINO_LIB_API)
+    static void _EdgeInterrupt(void * const pin);
+#endif
+
     inline static Set &_Reserved();
+#if defined(MJB_MULTITHREAD_CAPABLE)
+    inline static std::mutex &_ReservedLock();
+#endif
 
     static bool _Reserve(std::shared_ptr<Pin> const &pin);
     static bool _Release(std::shared_ptr<Pin> const &pin);
@@ -0,0 +1,201 @@
+//
+//  PinTester.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "Development.hpp"
+
+#if ! defined(MJB_ARDUINO_LIB_API)
+
+#include <thread>
+#include "Pin.hpp"
+#include "Testing.hpp"
+
+Scheduler::Time micros()
+{
+    return 0;
+}
+
+// A buffer whose indices start wherever the test has them, so they may be
+// taken past their type's overflow.
+struct Buffer : Pin::EdgeBuffer
+{
+    Buffer(Pin::EdgeBuffer::Index const start)
+    {
+        _head = start;
+        _tail = start;
+    }
+};
+
+static Pin::Edge Edge(Scheduler::Time const time)
+{
+    return {static_cast<Pin::Value>(time % 2), time};
+}
+
+#if defined(MJB_MULTITHREAD_CAPABLE)
+// Pushes the edges from a thread of their own, waiting for room if paced, and
+// pops them here as they come; they must come in order.
+static bool Transfer(Pin::EdgeBuffer &buffer, Scheduler::Time const edges, bool const paced, Scheduler::Time &received)
+{
+    std::thread producer([&buffer, edges, paced]()
+    {
+        for (Scheduler::Time time = 0; time < edges; time++)
+        {
+            while (paced && (buffer.size() == Pin::EdgeBuffer::Capacity)) std::this_thread::yield();
+            buffer.push(Edge(time));
+        }
+    });
+
+    Pin::Edge edge;
+    Scheduler::Time last = 0;
+    bool ordered = true;
+    received = 0;
+
+    for (bool done = false; !done;)
+    {
+        done = (received + buffer.dropped()) >= edges;
+        while (buffer.pop(edge))
+        {
+            ordered = ordered && (!received || (edge.time > last)) && (edge.value == Edge(edge.time).value);
+            last = edge.time;
+            received++;
+        }
+
+        std::this_thread::yield(); // The producer may be sharing the core.
+    }
+
+    producer.join();
+    return ordered;
+}
+#endif
+
+int main(int argc, const char * argv[])
+{
+    Pin::EdgeBuffer::Index const Capacity = Pin::EdgeBuffer::Capacity;
+    Pin::Edge edge;
+
+    // A full buffer drops the newest edges, counting them, and keeps those it
+    // holds, which come out oldest first.
+    Pin::EdgeBuffer buffer;
+    MJB_CHECK(!buffer.pop(edge));
+
+    for (Scheduler::Time time = 0; time < Capacity; time++) MJB_CHECK(buffer.push(Edge(time)));
+    MJB_CHECK(!buffer.push(Edge(Capacity)));
+    MJB_CHECK(!buffer.push(Edge(Capacity + 1)));
+    MJB_CHECK(buffer.size() == Capacity);
+    MJB_CHECK(buffer.dropped() == 2);
+
+    bool ordered = true;
+    for (Scheduler::Time time = 0; time < Capacity; time++)
+    {
+        ordered = ordered && buffer.pop(edge) && (edge.time == time) && (edge.value == Edge(time).value);
+    }
+    MJB_CHECK(ordered);
+    MJB_CHECK(!buffer.pop(edge));
+    MJB_CHECK(!buffer.size());
+
+    // Slots are reused as they're freed, the indices running past the
+    // capacity, and past their own overflow, all the same.
+    for (Pin::EdgeBuffer::Index const start : {Pin::EdgeBuffer::Index(0), ~Pin::EdgeBuffer::Index(0) - (Capacity / 2)})
+    {
+        Buffer wrapping(start);
+        Scheduler::Time pushed = 0, popped = 0;
+        ordered = true;
+
+        for (unsigned round = 0; round < 10; round++)
+        {
+            while (wrapping.push(Edge(pushed))) pushed++;
+            ordered = ordered && (wrapping.size() == Capacity);
+
+            for (unsigned index = 0; index < (Capacity / 2) + round; index++)
+            {
+                ordered = ordered && wrapping.pop(edge) && (edge.time == popped++);
+            }
+        }
+
+        while (wrapping.pop(edge)) ordered = ordered && (edge.time == popped++);
+        MJB_CHECK(ordered);
+        MJB_CHECK(popped == pushed);
+        MJB_CHECK(pushed > (4 * Capacity));
+        MJB_CHECK(wrapping.dropped() == 10);
+    }
+
+    // Clearing empties the buffer and forgets what was dropped.
+    buffer.push(Edge(0));
+    buffer.clear();
+    MJB_CHECK(!buffer.size() && !buffer.dropped() && !buffer.pop(edge));
+
+    // Pins record edges only while capturing, which invalid pins can't; those
+    // left once capture's disabled remain, and are cleared when it resumes.
+    Pin invalid;
+    MJB_CHECK(!invalid.setCapturing(true));
+    MJB_CHECK(!invalid.recordEdge(1, 10));
+
+    std::shared_ptr<Pin> const pin = std::make_shared<Pin>(3);
+    MJB_CHECK(!pin->recordEdge(1, 10));
+    MJB_CHECK(!pin->capturedEdges());
+
+    MJB_CHECK(pin->setCapturing(true));
+    MJB_CHECK(pin->recordEdge(0, 10));
+    MJB_CHECK(pin->recordEdge(1, 90));
+    MJB_CHECK(pin->nextEdge(edge) && (edge.value == 0) && (edge.time == 10));
+
+    MJB_CHECK(pin->setCapturing(false));
+    MJB_CHECK(!pin->recordEdge(0, 170));
+    MJB_CHECK(pin->capturedEdges() == 1);
+    MJB_CHECK(pin->nextEdge(edge) && (edge.value == 1) && (edge.time == 90));
+    MJB_CHECK(!pin->nextEdge(edge));
+
+    pin->recordEdge(0, 250);
+    MJB_CHECK(pin->setCapturing(true));
+    MJB_CHECK(pin->recordEdge(1, 330));
+    MJB_CHECK(pin->capturedEdges() == 1);
+
+    for (unsigned index = 0; index < Capacity; index++) pin->recordEdge(0, 400 + index);
+    MJB_CHECK(pin->capturedEdges() == Capacity);
+    MJB_CHECK(!pin->recordEdge(1, 1000));
+    MJB_CHECK(pin->setCapturing(false));
+
+#if defined(MJB_MULTITHREAD_CAPABLE)
+    // Edges pushed by a producer on its own thread, as by an interrupt
+    // handler, reach the consumer in order; those it finds no room for are
+    // counted as dropped, never lost unaccounted.
+    Pin::EdgeBuffer shared;
+    Scheduler::Time received = 0;
+    MJB_CHECK(Transfer(shared, 1000000, false, received));
+    MJB_CHECK((received + shared.dropped()) == 1000000);
+
+    // Edges handed over as fast as the consumer takes them, none dropped.
+    if (Testing::Benchmarking(argc, argv))
+    {
+        Scheduler::Time const edges = 20000000;
+        Pin::EdgeBuffer paced;
+
+        std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+        MJB_CHECK(Transfer(paced, edges, true, received));
+        double const seconds = Testing::Seconds(start);
+
+        MJB_CHECK((received == edges) && !paced.dropped());
+        std::fprintf(stderr, "Pin::EdgeBuffer: %.1f ns/edge across threads, %.1f M edges/s\n",
+                     seconds * 1e9 / edges, edges / seconds / 1e6);
+    }
+#else
+    // The following done to suppress unused variable warnings.
+    (void) argc;
+    (void) argv;
+#endif
+
+    return Testing::Result("PinTester");
+}
+
+#else
+
+int main()
+{
+    return 0;
+}
+
+#endif
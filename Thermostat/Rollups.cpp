@@ -0,0 +1,411 @@
+//
+//  Rollups.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "Rollups.hpp"
+
+#include <algorithm>
+#include <limits>
+
+constexpr Rollups::Time Rollups::GapLimit;
+constexpr uint32_t Rollups::_NoIndex;
+
+
+// =============================================================================
+// Rollups::Aggregate : Implementation
+// =============================================================================
+uint32_t Rollups::Aggregate::count() const
+{
+    return _count;
+}
+
+float Rollups::Aggregate::mean() const
+{
+    return _mean;
+}
+
+float Rollups::Aggregate::variance() const
+{
+    return _count? (_m2 / _count) : 0;
+}
+
+float Rollups::Aggregate::minimum() const
+{
+    return _count? _minimum : 0;
+}
+
+float Rollups::Aggregate::maximum() const
+{
+    return _count? _maximum : 0;
+}
+
+uint32_t Rollups::Aggregate::duration(Thermostat::Status const status) const
+{
+    return (static_cast<unsigned>(status) < 4)? _durations[status] : 0;
+}
+
+uint32_t Rollups::Aggregate::duration() const
+{
+    return _durations[0] + _durations[1] + _durations[2] + _durations[3];
+}
+
+float Rollups::Aggregate::dutyCycle() const
+{
+    uint32_t const total = duration();
+    if (!total) return 0;
+
+    uint32_t const running = _durations[Thermostat::Status::Heating] + _durations[Thermostat::Status::Cooling];
+    return static_cast<float>(running) / total;
+}
+
+void Rollups::Aggregate::add(float const value)
+{
+    // Welford's update, a merge with an aggregate of a single value.
+    _count++;
+
+    float const delta = value - _mean;
+    _mean += delta / _count;
+    _m2 += delta * (value - _mean);
+
+    if (value < _minimum) _minimum = value;
+    if (value > _maximum) _maximum = value;
+}
+
+void Rollups::Aggregate::add(Thermostat::Status const status, uint32_t const seconds)
+{
+    if (static_cast<unsigned>(status) < 4) _durations[status] += seconds;
+}
+
+void Rollups::Aggregate::merge(Rollups::Aggregate const &other)
+{
+    for (unsigned status = 0; status < 4; status++)
+    {
+        _durations[status] += other._durations[status];
+    }
+
+    if (!other._count) return;
+
+    if (!_count)
+    {
+        _count = other._count;
+        _mean = other._mean;
+        _m2 = other._m2;
+        _minimum = other._minimum;
+        _maximum = other._maximum;
+        return;
+    }
+
+    // Chan et al.'s parallel form of Welford's algorithm.
+    uint32_t const count = _count + other._count;
+    float const delta = other._mean - _mean;
+
+    _mean += delta * (static_cast<float>(other._count) / count);
+    _m2 += other._m2 + (delta * delta) * (static_cast<float>(_count) * other._count / count);
+    _count = count;
+
+    if (other._minimum < _minimum) _minimum = other._minimum;
+    if (other._maximum > _maximum) _maximum = other._maximum;
+}
+
+Rollups::Aggregate::Aggregate():
+_count(0),
+_mean(0),
+_m2(0),
+_minimum(std::numeric_limits<float>::max()),
+_maximum(std::numeric_limits<float>::lowest()),
+_durations{0, 0, 0, 0}
+{
+
+}
+
+
+// =============================================================================
+// Rollups : Implementation
+// =============================================================================
+bool Rollups::record(Rollups::Time const time,
+                     Thermometer::TemperatureUnit const &temperature,
+                     Thermostat::Status const status)
+{
+    if (_recorded && (time < _last)) return false;
+
+    if (_recorded && ((time - _last) <= Rollups::GapLimit))
+    {
+        Thermostat::Status const lastStatus = _lastStatus;
+
+        // The time since the last cycle is split at minutes, the finest level.
+        for (Rollups::Time start = _last; start < time;)
+        {
+            Rollups::Time const end = std::min<Rollups::Time>(time, ((start / 60) + 1) * 60);
+            uint32_t const seconds = static_cast<uint32_t>(end - start);
+
+            _update(start, [lastStatus, seconds](Rollups::Aggregate &aggregate) {
+                aggregate.add(lastStatus, seconds);
+            });
+
+            start = end;
+        }
+    }
+
+    float const kelvin = static_cast<float>(temperature.value());
+
+    _update(time, [kelvin](Rollups::Aggregate &aggregate) {
+        aggregate.add(kelvin);
+    });
+
+    _recorded = true;
+    _last = time;
+    _lastStatus = status;
+
+    return true;
+}
+
+bool Rollups::record(Rollups::Time const time, Thermostat::CycleHistory::Entry const &entry)
+{
+    return record(time, entry.temperature, static_cast<Thermostat::Status>(entry.status));
+}
+
+Rollups::Aggregate Rollups::query(Rollups::Time const from, Rollups::Time const to) const
+{
+    Rollups::Aggregate aggregate;
+    _collect(Rollups::Level::Day, from / 60, to / 60, aggregate);
+    return aggregate;
+}
+
+Rollups::Aggregate Rollups::bucket(Rollups::Level const level, Rollups::Time const time) const
+{
+    Rollups::Aggregate aggregate;
+    _merge(level, (time / 60) / Rollups::_Width(level), aggregate);
+    return aggregate;
+}
+
+template<typename Update>
+void Rollups::_update(Rollups::Time const time, Update const &update)
+{
+    int64_t const minute = time / 60;
+
+    for (unsigned level = Rollups::Level::Minute; level < Rollups::Level::Day; level++)
+    {
+        Rollups::Level const ringLevel = static_cast<Rollups::Level>(level);
+        update(_bucket(ringLevel, static_cast<uint32_t>(minute / Rollups::_Width(ringLevel))).aggregate);
+    }
+
+    uint32_t const day = static_cast<uint32_t>(minute / Rollups::_Width(Rollups::Level::Day));
+    _advanceDays(day);
+
+    // Only the day's leaf, as the nodes above it are brought up to date once
+    // the day is over; until then, queries read the leaf itself.
+    update(_days[_dayCapacity + (day % _dayCapacity)]);
+}
+
+Rollups::Bucket &Rollups::_bucket(Rollups::Level const level, uint32_t const index)
+{
+    Rollups::Bucket &bucket = _rings[level][index % _rings[level].size()];
+
+    if (bucket.index != index)
+    {
+        bucket.index = index;
+        bucket.aggregate = Rollups::Aggregate();
+    }
+
+    if ((_newest[level] == Rollups::_NoIndex) || (index > _newest[level])) _newest[level] = index;
+
+    return bucket;
+}
+
+void Rollups::_advanceDays(uint32_t const day)
+{
+    uint32_t const newest = _newest[Rollups::Level::Day];
+    if ((newest != Rollups::_NoIndex) && (day <= newest)) return;
+
+    if (newest != Rollups::_NoIndex) _propagate(newest % _dayCapacity);
+
+    // Leaves are cleared as their days come around, and all of them after a
+    // gap as long as the tree.
+    uint32_t first = newest + 1;
+    if ((newest == Rollups::_NoIndex) || ((day - newest) >= _dayCapacity))
+    {
+        first = day - std::min<uint32_t>(day, static_cast<uint32_t>(_dayCapacity - 1));
+    }
+
+    for (uint32_t cleared = first; cleared <= day; cleared++)
+    {
+        _resetDay(cleared);
+    }
+
+    _newest[Rollups::Level::Day] = day;
+}
+
+void Rollups::_resetDay(uint32_t const day)
+{
+    std::size_t const slot = day % _dayCapacity;
+    _dayIndexes[slot] = day;
+
+    _days[_dayCapacity + slot] = Rollups::Aggregate();
+    _propagate(slot);
+}
+
+void Rollups::_propagate(std::size_t const slot)
+{
+    for (std::size_t node = (_dayCapacity + slot) >> 1; node; node >>= 1)
+    {
+        _days[node] = _days[2 * node];
+        _days[node].merge(_days[(2 * node) + 1]);
+    }
+}
+
+bool Rollups::_retained(Rollups::Level const level, int64_t const index) const
+{
+    if (_newest[level] == Rollups::_NoIndex) return true;
+
+    std::size_t const capacity = (level == Rollups::Level::Day)? _dayCapacity : _rings[level].size();
+    return (index + static_cast<int64_t>(capacity)) > static_cast<int64_t>(_newest[level]);
+}
+
+void Rollups::_collect(Rollups::Level const level,
+                       int64_t const from,
+                       int64_t const to,
+                       Rollups::Aggregate &aggregate) const
+{
+    if (from >= to) return;
+
+    if (level == Rollups::Level::Minute)
+    {
+        for (int64_t index = from; index < to; index++)
+        {
+            _merge(level, index, aggregate);
+        }
+        return;
+    }
+
+    // The level's whole buckets in the window, and the edges around them.
+    int64_t const width = Rollups::_Width(level);
+    int64_t const first = (from + width - 1) / width;
+    int64_t const last = to / width;
+
+    if (first >= last)
+    {
+        _collectEdge(level, from, to, aggregate);
+        return;
+    }
+
+    _collectEdge(level, from, first * width, aggregate);
+
+    if (level == Rollups::Level::Day)
+    {
+        _mergeDays(first, last, aggregate);
+    }
+    else
+    {
+        for (int64_t index = first; index < last; index++)
+        {
+            _merge(level, index, aggregate);
+        }
+    }
+
+    _collectEdge(level, last * width, to, aggregate);
+}
+
+void Rollups::_collectEdge(Rollups::Level const level,
+                           int64_t const from,
+                           int64_t const to,
+                           Rollups::Aggregate &aggregate) const
+{
+    if (from >= to) return;
+
+    // Edges lie within a single bucket of the level, which stands in for the
+    // finer ones once they've aged out.
+    Rollups::Level const finer = static_cast<Rollups::Level>(level - 1);
+
+    if (_retained(finer, from / Rollups::_Width(finer))) _collect(finer, from, to, aggregate);
+    else _merge(level, from / Rollups::_Width(level), aggregate);
+}
+
+void Rollups::_merge(Rollups::Level const level, int64_t const index, Rollups::Aggregate &aggregate) const
+{
+    if ((index < 0) || !_retained(level, index)) return;
+
+    if (level == Rollups::Level::Day)
+    {
+        std::size_t const slot = static_cast<std::size_t>(index) % _dayCapacity;
+        if (_dayIndexes[slot] == index) aggregate.merge(_days[_dayCapacity + slot]);
+        return;
+    }
+
+    Rollups::Bucket const &bucket = _rings[level][static_cast<std::size_t>(index) % _rings[level].size()];
+    if (bucket.index == index) aggregate.merge(bucket.aggregate);
+}
+
+void Rollups::_mergeDays(int64_t from, int64_t to, Rollups::Aggregate &aggregate) const
+{
+    uint32_t const newest = _newest[Rollups::Level::Day];
+    if (newest == Rollups::_NoIndex) return;
+
+    // Only the days the tree still holds, which are all of its leaves; the
+    // newest is read from its leaf, as the nodes above don't include it yet.
+    // Those after it are yet to come, their leaves still holding older days.
+    from = std::max<int64_t>(from, static_cast<int64_t>(newest) - static_cast<int64_t>(_dayCapacity) + 1);
+
+    if (to > newest)
+    {
+        if (from <= newest) aggregate.merge(_days[_dayCapacity + (newest % _dayCapacity)]);
+        to = newest;
+    }
+
+    if (from >= to) return;
+
+    std::size_t const start = static_cast<std::size_t>(from) % _dayCapacity;
+    std::size_t const count = static_cast<std::size_t>(to - from);
+
+    // The days' leaves may wrap around the end of the tree.
+    std::size_t const spans[2][2] = {
+        {start, std::min(start + count, _dayCapacity)},
+        {0, ((start + count) > _dayCapacity)? (start + count - _dayCapacity) : 0}
+    };
+
+    for (std::size_t const (&span)[2] : spans)
+    {
+        for (std::size_t left = span[0] + _dayCapacity, right = span[1] + _dayCapacity; left < right; left >>= 1, right >>= 1)
+        {
+            if (left & 1) aggregate.merge(_days[left++]);
+            if (right & 1) aggregate.merge(_days[--right]);
+        }
+    }
+}
+
+int64_t Rollups::_Width(Rollups::Level const level)
+{
+    static constexpr int64_t Widths[] = {1, 15, 60, 1440};
+    return Widths[level];
+}
+
+
+// =============================================================================
+// Rollups : Constructors & Destructor
+// =============================================================================
+Rollups::Rollups(std::size_t const minutes,
+                 std::size_t const quarterHours,
+                 std::size_t const hours,
+                 std::size_t const days):
+_days(2 * std::max<std::size_t>(days, 1)),
+_dayIndexes(std::max<std::size_t>(days, 1), Rollups::_NoIndex),
+_dayCapacity(std::max<std::size_t>(days, 1)),
+_recorded(false),
+_last(0),
+_lastStatus(Thermostat::Status::Standby)
+{
+    std::size_t const capacities[] = {minutes, quarterHours, hours};
+
+    for (unsigned level = Rollups::Level::Minute; level < Rollups::Level::Day; level++)
+    {
+        _rings[level].assign(std::max<std::size_t>(capacities[level], 1), {Rollups::_NoIndex, Rollups::Aggregate()});
+    }
+
+    for (uint32_t &newest : _newest)
+    {
+        newest = Rollups::_NoIndex;
+    }
+}
@@ -0,0 +1,143 @@
+//
+//  Rollups.hpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef Rollups_hpp
+#define Rollups_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Development.hpp"
+#include "Thermostat.hpp"
+
+// =============================================================================
+// Rollups : This class summarizes a zone's cycles as they're recorded, into
+// minute, quarter hour, hour and day buckets, each holding the temperature's
+// count, mean and variance (per Welford), extremes, and the time spent in each
+// Status; the interval between two cycles counts towards the earlier's status.
+// Every level keeps a ring of its latest buckets. Days are also kept as the
+// leaves of a segment tree, so that a window of any length is answered from
+// O(log n) buckets: the whole days in it through the tree, and its edges from
+// the finest buckets still around; where those have aged out, the window is
+// widened to the coarser bucket holding the edge.
+// NOTE: Times are in seconds (Unix time being best), and windows are resolved
+// to whole minutes. Cycles further apart than GapLimit count towards nothing.
+// =============================================================================
+class Rollups
+{
+public:
+    typedef int64_t Time;
+
+    enum Level
+    {
+        Minute,
+        QuarterHour,
+        Hour,
+        Day
+    };
+
+    static constexpr Time GapLimit = 3600;
+
+    // =========================================================================
+    // Aggregate : The summary of a bucket, or of a window.
+    // =========================================================================
+    class Aggregate
+    {
+    public:
+
+        uint32_t count() const;
+        float mean() const;
+        float variance() const;
+        float minimum() const;
+        float maximum() const;
+
+        // The seconds spent in the status, or in all of them.
+        uint32_t duration(Thermostat::Status const status) const;
+        uint32_t duration() const;
+
+        // The share of the time spent heating or cooling.
+        float dutyCycle() const;
+
+        void add(float const value);
+        void add(Thermostat::Status const status, uint32_t const seconds);
+        void merge(Aggregate const &other);
+
+        Aggregate();
+
+    protected:
+
+        uint32_t _count;
+        float _mean;
+        float _m2;          // The sum of squared differences from the mean.
+        float _minimum;
+        float _maximum;
+        uint32_t _durations[4];
+    };
+
+    // Returns false, recording nothing, if the cycle is older than the last.
+    bool record(Time const time,
+                Thermometer::TemperatureUnit const &temperature,
+                Thermostat::Status const status);
+    bool record(Time const time, Thermostat::CycleHistory::Entry const &entry);
+
+    // Summarizes the window from the first time up to the second.
+    Aggregate query(Time const from, Time const to) const;
+
+    // The bucket of the level holding the time, empty if it isn't kept.
+    Aggregate bucket(Level const level, Time const time) const;
+
+    // The buckets kept at each level; by default, six hours of minutes, four
+    // days of quarter hours, a month of hours, and over a year of days.
+    Rollups(std::size_t const minutes = 360,
+            std::size_t const quarterHours = 384,
+            std::size_t const hours = 744,
+            std::size_t const days = 512);
+
+protected:
+
+    struct Bucket
+    {
+        uint32_t index;     // The bucket's number since the epoch.
+        Aggregate aggregate;
+    };
+
+    static constexpr uint32_t _NoIndex = ~uint32_t(0);
+
+    // The rings of the three finer levels; days are in the tree.
+    std::vector<Bucket> _rings[Level::Day];
+    uint32_t _newest[Level::Day + 1];
+
+    // The day tree's nodes; node 1 is the root, leaves start at _dayCapacity.
+    // The nodes above the newest day's leaf are only updated once it's over.
+    std::vector<Aggregate> _days;
+    std::vector<uint32_t> _dayIndexes;
+    std::size_t const _dayCapacity;
+
+    bool _recorded;
+    Time _last;
+    Thermostat::Status _lastStatus;
+
+    template<typename Update>
+    void _update(Time const time, Update const &update);
+
+    Bucket &_bucket(Level const level, uint32_t const index);
+    void _advanceDays(uint32_t const day);
+    void _resetDay(uint32_t const day);
+    void _propagate(std::size_t const slot);
+
+    bool _retained(Level const level, int64_t const index) const;
+    void _collect(Level const level, int64_t const from, int64_t const to, Aggregate &aggregate) const;
+    void _collectEdge(Level const level, int64_t const from, int64_t const to, Aggregate &aggregate) const;
+    void _merge(Level const level, int64_t const index, Aggregate &aggregate) const;
+    void _mergeDays(int64_t from, int64_t to, Aggregate &aggregate) const;
+
+    // The width of a level's buckets, in minutes.
+    static int64_t _Width(Level const level);
+};
+
+#endif /* Rollups_hpp */
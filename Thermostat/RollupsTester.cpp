@@ -0,0 +1,221 @@
+//
+//  RollupsTester.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "Development.hpp"
+
+#if ! defined(MJB_ARDUINO_LIB_API)
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "Rollups.hpp"
+#include "Testing.hpp"
+
+Scheduler::Time micros()
+{
+    return 0;
+}
+
+struct Cycle
+{
+    Rollups::Time time;
+    float kelvin;
+    Thermostat::Status status;
+};
+
+// What a window holds, counted cycle by cycle.
+struct Expected
+{
+    uint32_t count = 0;
+    double sum = 0;
+    float minimum = 0;
+    float maximum = 0;
+    uint32_t durations[4] = {0, 0, 0, 0};
+};
+
+// Scans every cycle for those in the window, of minutes, from the first up to
+// the second; the time between two cycles is split at minutes, as recorded.
+static Expected Scan(std::vector<Cycle> const &cycles, int64_t const from, int64_t const to)
+{
+    Expected expected;
+
+    for (std::size_t index = 0; index < cycles.size(); index++)
+    {
+        Cycle const &cycle = cycles[index];
+        int64_t const minute = cycle.time / 60;
+
+        if ((minute >= from) && (minute < to))
+        {
+            expected.minimum = expected.count? std::min(expected.minimum, cycle.kelvin) : cycle.kelvin;
+            expected.maximum = expected.count? std::max(expected.maximum, cycle.kelvin) : cycle.kelvin;
+            expected.sum += cycle.kelvin;
+            expected.count++;
+        }
+
+        if (!index || ((cycle.time - cycles[index - 1].time) > Rollups::GapLimit)) continue;
+
+        Cycle const &last = cycles[index - 1];
+        for (Rollups::Time start = last.time; start < cycle.time;)
+        {
+            Rollups::Time const end = std::min<Rollups::Time>(cycle.time, ((start / 60) + 1) * 60);
+            if (((start / 60) >= from) && ((start / 60) < to)) expected.durations[last.status] += end - start;
+            start = end;
+        }
+    }
+
+    return expected;
+}
+
+static bool Matches(Rollups::Aggregate const &aggregate, Expected const &expected)
+{
+    bool matches = (aggregate.count() == expected.count);
+
+    if (expected.count)
+    {
+        matches = matches && (std::fabs(aggregate.mean() - (expected.sum / expected.count)) < 0.05);
+        matches = matches && (aggregate.minimum() == expected.minimum);
+        matches = matches && (aggregate.maximum() == expected.maximum);
+    }
+
+    for (unsigned status = 0; status < 4; status++)
+    {
+        matches = matches && (aggregate.duration(static_cast<Thermostat::Status>(status)) == expected.durations[status]);
+    }
+
+    return matches;
+}
+
+int main(int argc, const char * argv[])
+{
+    std::mt19937 random(46);
+
+    // Two years of cycles about five minutes apart, with the odd gap of hours
+    // between them, which count towards nothing.
+    std::vector<Cycle> cycles;
+    Rollups rollups;
+    Rollups::Time time = 1600000000;
+    float kelvin = 295;
+
+    for (std::size_t index = 0; index < (2 * 105120); index++)
+    {
+        time += 300 + (static_cast<int>(random() % 21) - 10);
+        if (!(random() % 5000)) time += 7200;
+        kelvin += (static_cast<int>(random() % 21) - 10) / 100.0f;
+
+        // Scanned as held, to the hundredth of a Kelvin with fixed point ones.
+        float const held = static_cast<float>(Thermometer::TemperatureUnit(kelvin).value());
+        Cycle const cycle = {time, held, static_cast<Thermostat::Status>(random() % 4)};
+        cycles.push_back(cycle);
+        MJB_CHECK(rollups.record(cycle.time, Thermometer::TemperatureUnit(cycle.kelvin), cycle.status));
+    }
+
+    // Cycles older than the last are turned away.
+    MJB_CHECK(!rollups.record(time - 1, Thermometer::TemperatureUnit(kelvin), Thermostat::Status::Standby));
+
+    // Windows with edges at minutes, hours and days, within what each level
+    // keeps, summarize as scanning every cycle in them does.
+    int64_t const now = time / 60;
+    unsigned mismatches = 0;
+
+    for (std::size_t window = 0; window < 200; window++)
+    {
+        int64_t const from = now - (random() % 359);
+        int64_t const to = from + (random() % (now + 2 - from));
+        if (!Matches(rollups.query(from * 60, to * 60), Scan(cycles, from, to))) mismatches++;
+    }
+
+    for (std::size_t window = 0; window < 200; window++)
+    {
+        int64_t const from = ((now / 60) - (random() % 743)) * 60;
+        int64_t const to = from + (60 * (random() % 700));
+        if (!Matches(rollups.query(from * 60, to * 60), Scan(cycles, from, to))) mismatches++;
+    }
+
+    for (std::size_t window = 0; window < 200; window++)
+    {
+        int64_t const from = ((now / 1440) - (random() % 511)) * 1440;
+        int64_t const to = from + (1440 * (random() % 600));
+        if (!Matches(rollups.query(from * 60, to * 60), Scan(cycles, from, to))) mismatches++;
+    }
+
+    MJB_CHECK(!mismatches);
+
+    // Buckets are those of their level holding the time.
+    int64_t const hour = (now / 60) * 60;
+    MJB_CHECK(Matches(rollups.bucket(Rollups::Level::Hour, time), Scan(cycles, hour, hour + 60)));
+
+    // Days yet to come are empty, though their leaves in the tree still hold
+    // the days a year or so before.
+    Rollups::Aggregate const future = rollups.query(time + (2 * 86400), time + (30 * 86400));
+    MJB_CHECK(!future.count() && !future.duration());
+
+    // Query latency for windows anywhere in a year, across 10k zones fed a
+    // year of five minute cycles each.
+    if (Testing::Benchmarking(argc, argv))
+    {
+        std::size_t const zones = 10000;
+        std::size_t const yearOfCycles = 105120;
+        Rollups::Time const start = 1600000000;
+        Rollups::Time end = start;
+
+        std::vector<Rollups> fleet(zones);
+
+        std::chrono::steady_clock::time_point fed = std::chrono::steady_clock::now();
+        for (std::size_t index = 0; index < yearOfCycles; index++)
+        {
+            end += 300;
+            for (std::size_t zone = 0; zone < zones; zone++)
+            {
+                fleet[zone].record(end + (zone % 300),
+                                   Thermometer::TemperatureUnit(290.0f + (((index + zone) % 50) * 0.1f)),
+                                   static_cast<Thermostat::Status>(((index / 6) + zone) % 4));
+            }
+        }
+        double const feeding = Testing::Seconds(fed);
+
+        std::size_t const queries = 200000;
+        std::vector<double> latencies;
+        latencies.reserve(queries);
+        float checksum = 0;
+
+        for (std::size_t query = 0; query < queries; query++)
+        {
+            Rollups const &zone = fleet[random() % zones];
+            Rollups::Time const from = start + (random() % (end - start));
+            Rollups::Time const to = from + (random() % (end - from + 1));
+
+            std::chrono::steady_clock::time_point const asked = std::chrono::steady_clock::now();
+            Rollups::Aggregate const aggregate = zone.query(from, to);
+            latencies.push_back(Testing::Seconds(asked));
+
+            checksum += aggregate.mean() + aggregate.dutyCycle();
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+
+        std::fprintf(stderr, "Rollups::record: %.1f ns/cycle, %zu zones x %zu cycles\n",
+                     feeding * 1e9 / (static_cast<double>(zones) * yearOfCycles), zones, yearOfCycles);
+        std::fprintf(stderr, "Rollups::query: p50 %.2f us, p99 %.2f us, max %.2f us (%g)\n",
+                     latencies[queries / 2] * 1e6,
+                     latencies[(queries * 99) / 100] * 1e6,
+                     latencies.back() * 1e6,
+                     checksum);
+    }
+
+    return Testing::Result("RollupsTester");
+}
+
+#else
+
+int main()
+{
+    return 0;
+}
+
+#endif
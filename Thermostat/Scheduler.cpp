@@ -11,16 +11,54 @@
 // =============================================================================
 // Scheduler : Static Variables Declaration
 // =============================================================================
-std::set<Scheduler *> &Scheduler::_InstanceRegister()
+#if defined(MJB_MULTITHREAD_CAPABLE)
+thread_local Scheduler::Registry *Scheduler::Registry::_Current = nullptr;
+#else
+Scheduler::Registry *Scheduler::Registry::_Current = nullptr;
+#endif
+
+// =============================================================================
+// Scheduler::Registry : Implementation
+// =============================================================================
+std::size_t Scheduler::Registry::size() const
+{
+#if defined(MJB_MULTITHREAD_CAPABLE)
+    std::lock_guard<std::mutex> const lock(_lock);
+#endif
+    return _schedulers.size();
+}
+
+Scheduler::Registry &Scheduler::Registry::Current()
+{
+    return Scheduler::Registry::_Current? *Scheduler::Registry::_Current : Scheduler::Registry::_Default();
+}
+
+void Scheduler::Registry::SetCurrent(Scheduler::Registry * const registry)
+{
+    Scheduler::Registry::_Current = registry;
+}
+
+Scheduler::Registry &Scheduler::Registry::_Default()
+{
+    static Scheduler::Registry _registry;
+    return _registry;
+}
+
+Scheduler::Registry::Registry()
 {
-    // TODO: Make type below "Scheduler * const" when compiler gets its shit together.
-    static std::set<Scheduler *> _instanceRegister;
-    return _instanceRegister;
+
 }
 
+Scheduler::Registry::~Registry()
+{
 #if defined(MJB_MULTITHREAD_CAPABLE)
-std::mutex Scheduler::_InstanceRegisterLock;
+    std::lock_guard<std::mutex> const lock(_lock);
 #endif
+    for (Scheduler * const scheduler : _schedulers)
+    {
+        scheduler->_registry = nullptr;
+    }
+}
 
 // =============================================================================
 // Scheduler::Event : Implementation
@@ -57,6 +95,12 @@ bool Scheduler::Event::setExecuteTime(Scheduler::Time const executeTime)
     return operation_result;
 }
 
+bool Scheduler::Event::scheduled() const
+{
+    // Schedulers set themselves as the event's on enqueue, and clear on dequeue.
+    return !_scheduler.expired();
+}
+
 std::weak_ptr<Scheduler> const &Scheduler::Event::scheduler() const
 {
     return _scheduler;
@@ -96,15 +140,21 @@ void Scheduler::Event::_executeTimeDidChange(Scheduler::Time const executeTimeDe
     (void) executeTimeDelta;
 }
 
+bool Scheduler::Event::daemon() const
+{
+    return _daemon;
+}
+
 Scheduler::Event::Event(Scheduler::Time const executeTime):
+_daemon(false),
 _executeTime(executeTime)
 {
-    Identifiable<Event>::Register(this); // RTTI Substitute
+    
 }
 
 Scheduler::Event::~Event()
 {
-    Identifiable<Event>::Unregister(this); // RTTI Substitute
+    
 }
 
 
@@ -140,12 +190,12 @@ Scheduler::Daemon::Daemon(Scheduler::Time const executeTime,
 Scheduler::Event(executeTime),
 _executeTimeInterval(executeTimeInterval)
 {
-    Identifiable<Daemon>::Register(this); // RTTI Substitute
+    _daemon = true; // RTTI Substitute
 }
 
 Scheduler::Daemon::~Daemon()
 {
-    Identifiable<Daemon>::Unregister(this); // RTTI Substitute
+    
 }
 
 
@@ -275,7 +325,7 @@ void Scheduler::UpdateInstances(Scheduler::Time const time)
     MJB_DEBUG_LOG_LINE("==============");
 #endif
     
-    for (Scheduler * const scheduler : Scheduler::_InstanceRegister())
+    for (Scheduler * const scheduler : Scheduler::Registry::Current()._schedulers)
     {
 
 #if defined(MJB_DEBUG_LOGGING_SCHEDULER)
@@ -415,7 +465,7 @@ void Scheduler::_processTasksForTime(Scheduler::TaskSet const &tasks, Scheduler:
             });
 
             // Check for special case, being Daemon instances.
-            if (Identifiable<Daemon>::Instanced(event.get()))
+            if (event->daemon())
             {
                 // Since this is a Daemon, and Daemons repeat until finished,
                 // calcualte next execution time and request scheduler priority update.
@@ -571,23 +621,27 @@ Scheduler::EventLocation Scheduler::_GetEventLocation(Scheduler const * const sc
 Scheduler::Scheduler():
 _taskSetPrimary(&_taskSets[0]),
 _taskSetSecondary(&_taskSets[1]),
-_lastTime(0)
+_lastTime(0),
+_registry(&Scheduler::Registry::Current())
 {
 #if defined(MJB_MULTITHREAD_CAPABLE)
-    // Enable the _InstanceRegisterLock immediately upon entering the constructor.
+    // Enable the registry's lock immediately upon entering the constructor.
     // NOTICE: The lock is driven by the code block, released on block-exit.
-    std::lock_guard<std::mutex> const lock(Scheduler::_InstanceRegisterLock);
+    std::lock_guard<std::mutex> const lock(_registry->_lock);
 #endif
-    Scheduler::_InstanceRegister().insert(this);
+    _registry->_schedulers.insert(this);
 }
 
 Scheduler::~Scheduler()
 {
+    if (!_registry) return; // Its registry is gone already.
+
 #if defined(MJB_MULTITHREAD_CAPABLE)
-    // Enable the _InstanceRegisterLock immediately upon entering the destructor.
+    // Enable the registry's lock immediately upon entering the destructor; the
+    // scheduler may be destroyed on a thread other than the one it joined on.
     // NOTICE: The lock is driven by the code block, released on block-exit.
-    std::lock_guard<std::mutex> const lock(Scheduler::_InstanceRegisterLock);
+    std::lock_guard<std::mutex> const lock(_registry->_lock);
 #endif
-    Scheduler::_InstanceRegister().erase(this);
+    _registry->_schedulers.erase(this);
 }
 
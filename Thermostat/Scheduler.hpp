@@ -10,6 +10,7 @@
 #define Scheduler_hpp
 
 #include <utility>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <mutex>
@@ -60,11 +61,17 @@ public:
         bool schedule(std::weak_ptr<Scheduler> const &scheduler);
         bool unschedule();
 
+        // Whether the event is a Daemon, repeating until finished.
+        bool daemon() const;
+
         Event(Time const executeTime = 0); // Trigger event instantly by default.
         virtual ~Event();
         
     protected:
 
+        // Set by Daemon's constructor alone (see Daemon below).
+        bool _daemon;
+
         virtual void _executeTimeDidChange(Time const executeTimeDelta);
 
     private:
@@ -79,7 +86,8 @@ public:
     // the fact polymorphic objects can't be downcasted due to a lack of rtti.
     // Runtime Type Information does not fit on the memory of ESP8266-03, which
     // is the module(s) I've been using to test the code with.
-    // Working around it by using a super-bootlegged template I designed; fugly.
+    // Working around it by having Daemons mark themselves as such on the Event
+    // they derive from, which schedulers check without looking anything up.
     // =========================================================================
     // Daemon: A schedulable class used to trigger repeating events.
     // =========================================================================
@@ -103,11 +111,50 @@ public:
 
     };
     
+    // =========================================================================
+    // Registry: The schedulers updated together by UpdateInstances. Schedulers
+    // join the registry current to the thread constructing them, which is the
+    // default registry unless the thread has set another; threads running their
+    // own registries (see ShardedRunner) share no schedulers with each other.
+    // NOTE: Schedulers outliving their registry are left in none, never to be
+    // updated again; a registry should outlive the schedulers that joined it.
+    // =========================================================================
+    class Registry
+    {
+    public:
+
+        std::size_t size() const;
+
+        // The calling thread's registry; setting nullptr restores the default.
+        static Registry &Current();
+        static void SetCurrent(Registry * const registry);
+
+        Registry();
+        ~Registry();
+
+    protected:
+
+        friend class Scheduler;
+
+        std::set<Scheduler *> _schedulers;
+#if defined(MJB_MULTITHREAD_CAPABLE)
+        mutable std::mutex _lock;
+#endif
+
+        static Registry &_Default();
+#if defined(MJB_MULTITHREAD_CAPABLE)
+        static thread_local Registry *_Current;
+#else
+        static Registry *_Current;
+#endif
+    };
+
     bool enqueue(std::shared_ptr<Event> const &event);
     bool dequeue(std::shared_ptr<Event> const &event);
 
     bool scheduled(std::shared_ptr<Event> const &event) const;
     
+    // Updates the schedulers of the calling thread's current registry.
     static void UpdateInstances(Time const time);
     
     Scheduler();
@@ -159,6 +206,8 @@ protected:
 
     Time _lastTime; // Last update cycle time.
 
+    Registry *_registry; // The registry joined on construction, if still around.
+
     void _processEventsForTime(Time const time);
     void _processTasksForTime(TaskSet const &tasks, Time const time);
     void _processTasks(TaskSet const &tasks);
@@ -169,14 +218,6 @@ protected:
     static EventLocation _GetEventLocation(Scheduler const * const scheduler,
                                            std::shared_ptr<Scheduler::Event> const &event);
 
-
-    // The following static member holds all instances created of Scheduler,
-    // which the class uses to update by calling the static UpdateInstances
-    // method once an update cycle is being executed.
-    inline static std::set<Scheduler *> &_InstanceRegister();
-#if defined(MJB_MULTITHREAD_CAPABLE)
-    static std::mutex _InstanceRegisterLock;
-#endif
 };
 
 // =========================================================================
@@ -7,6 +7,7 @@
 //
 
 #include "Sensor.hpp"
+#include <cstring>
 
 // =============================================================================
 // Sensor : Implementation
@@ -16,8 +17,50 @@ Sensor::Data Sensor::sense() {
     return Sensor::Data(); // Empty data
 }
 
+Sensor::Health const &Sensor::health() const
+{
+    return _health;
+}
+
+void Sensor::_recordReading()
+{
+    _health.readings++;
+    _health.readingTime = micros();
+}
+
+void Sensor::_recordTimeout()
+{
+    _health.timeouts++;
+}
+
+void Sensor::_recordChecksumFailure()
+{
+    _health.checksumFailures++;
+}
+
+bool Sensor::_await(Pin const &pin,
+                    Pin::Value const value,
+                    Scheduler::Time const deadline,
+                    Scheduler::Time &time)
+{
+    for (;;)
+    {
+        time = micros();
+
+        // Compare the value after sampling time, so that time never precedes it.
+        if ((pin.value() != 0) == (value != 0)) return true;
+
+        // The signed difference keeps this correct across clock overflows.
+        if (static_cast<int32_t>(time - deadline) > 0) break;
+    }
+
+    _recordTimeout();
+    return false;
+}
+
 Sensor::Sensor(Pin::Arrangement const &pins, Scheduler::Time const senseTimeout):
-Actuator(pins, senseTimeout)
+Actuator(pins, senseTimeout),
+_health({0, 0, 0, 0})
 {
     
 }
@@ -27,3 +70,130 @@ Sensor::~Sensor()
     
 }
 
+// =============================================================================
+// Sensor::View : Implementation
+// =============================================================================
+Sensor::Byte const *Sensor::View::data() const
+{
+    return _bytes;
+}
+
+std::size_t Sensor::View::size() const
+{
+    return _size;
+}
+
+bool Sensor::View::empty() const
+{
+    return !_size;
+}
+
+Sensor::Byte const &Sensor::View::operator[](std::size_t const index) const
+{
+    return _bytes[index];
+}
+
+Sensor::Byte const *Sensor::View::begin() const
+{
+    return _bytes;
+}
+
+Sensor::Byte const *Sensor::View::end() const
+{
+    return _bytes + _size;
+}
+
+Sensor::View::View(Sensor::Byte const *bytes, std::size_t const size):
+_bytes(bytes),
+_size(bytes? size : 0)
+{
+
+}
+
+// =============================================================================
+// Sensor::Data : Implementation
+// =============================================================================
+Sensor::Byte *Sensor::Data::data()
+{
+    return _bytes;
+}
+
+Sensor::Byte const *Sensor::Data::data() const
+{
+    return _bytes;
+}
+
+std::size_t Sensor::Data::size() const
+{
+    return _size;
+}
+
+bool Sensor::Data::empty() const
+{
+    return !_size;
+}
+
+bool Sensor::Data::resize(std::size_t const size)
+{
+    if (size > Sensor::Data::Capacity) return false;
+
+    // Keep the zero filled guarantee for any bytes being added.
+    if (size > _size) std::memset(_bytes + _size, 0, size - _size);
+
+    _size = static_cast<uint8_t>(size);
+    return true;
+}
+
+bool Sensor::Data::push_back(Sensor::Byte const byte)
+{
+    if (_size >= Sensor::Data::Capacity) return false;
+
+    _bytes[_size++] = byte;
+    return true;
+}
+
+void Sensor::Data::clear()
+{
+    _size = 0;
+}
+
+Sensor::Byte &Sensor::Data::operator[](std::size_t const index)
+{
+    return _bytes[index];
+}
+
+Sensor::Byte const &Sensor::Data::operator[](std::size_t const index) const
+{
+    return _bytes[index];
+}
+
+Sensor::Byte *Sensor::Data::begin()
+{
+    return _bytes;
+}
+
+Sensor::Byte *Sensor::Data::end()
+{
+    return _bytes + _size;
+}
+
+Sensor::Byte const *Sensor::Data::begin() const
+{
+    return _bytes;
+}
+
+Sensor::Byte const *Sensor::Data::end() const
+{
+    return _bytes + _size;
+}
+
+Sensor::Data::operator Sensor::View() const
+{
+    return Sensor::View(_bytes, _size);
+}
+
+Sensor::Data::Data(std::size_t const size):
+_size(0)
+{
+    resize(size);
+}
@@ -9,9 +9,11 @@
 #ifndef Sensor_hpp
 #define Sensor_hpp
 
-#include <vector>
+#include <cstddef>
+#include <cstdint>
 #include "Development.hpp"
 #include "Actuator.hpp"
+#include "Scheduler.hpp"
 #include "Pin.hpp"
 
 // =============================================================================
@@ -23,12 +25,106 @@ class Sensor : protected Actuator
 public:
     
     typedef unsigned char Byte;
-    typedef std::vector<Byte> Data;
+
+    // =========================================================================
+    // View : A read-only window over bytes held elsewhere, as in a Data frame
+    // or a sensor's own buffer. Views don't own, copy or allocate anything.
+    // =========================================================================
+    class View
+    {
+    public:
+
+        Byte const *data() const;
+        std::size_t size() const;
+        bool empty() const;
+
+        Byte const &operator[](std::size_t const index) const;
+
+        Byte const *begin() const;
+        Byte const *end() const;
+
+        View(Byte const *bytes = nullptr, std::size_t const size = 0);
+
+    protected:
+
+        Byte const *_bytes;
+        std::size_t _size;
+    };
+
+    // =========================================================================
+    // Data : A frame of bytes read from a sensor, of any length up to Capacity.
+    // Storage is inline, so frames are created and returned without allocating.
+    // Sensors with longer frames should keep them in a buffer of their own and
+    // hand out Views of it instead.
+    // =========================================================================
+    class Data
+    {
+    public:
+
+        static std::size_t const Capacity = 16;
+
+        Byte *data();
+        Byte const *data() const;
+
+        std::size_t size() const;
+        bool empty() const;
+
+        // Returns false, leaving the frame as it was, if over Capacity.
+        bool resize(std::size_t const size);
+        bool push_back(Byte const byte);
+        void clear();
+
+        Byte &operator[](std::size_t const index);
+        Byte const &operator[](std::size_t const index) const;
+
+        Byte *begin();
+        Byte *end();
+        Byte const *begin() const;
+        Byte const *end() const;
+
+        operator View() const;
+
+        // Frames are zero filled; sizes over Capacity result in empty frames.
+        explicit Data(std::size_t const size = 0);
+
+    protected:
+
+        Byte _bytes[Capacity];
+        uint8_t _size;
+    };
+
+    // Health denotes a record of how reliably the sensor has been reading.
+    struct Health
+    {
+        uint32_t readings;          // Good readings received.
+        uint32_t timeouts;          // Readings abandoned waiting on the sensor.
+        uint32_t checksumFailures;  // Readings received corrupted.
+        Scheduler::Time readingTime; // When the last good reading was received.
+    };
     
     virtual Data sense();
+
+    Health const &health() const;
     
     Sensor(Pin::Arrangement const &pins, Scheduler::Time const senseTimeout = 0);
     virtual ~Sensor();
+
+protected:
+
+    Health _health;
+
+    void _recordReading();
+    void _recordTimeout();
+    void _recordChecksumFailure();
+
+    // Waits for the pin to read the given value, but not past the deadline (a
+    // time, in microseconds, as given by micros()). On success, time is set to
+    // when the value was read; on timeout, false is returned and recorded.
+    // NOTE: Deadlines may be at most half the range of Scheduler::Time away.
+    bool _await(Pin const &pin,
+                Pin::Value const value,
+                Scheduler::Time const deadline,
+                Scheduler::Time &time);
     
 };
 
@@ -0,0 +1,96 @@
+//
+//  SensorTester.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "Development.hpp"
+
+#if ! defined(MJB_ARDUINO_LIB_API)
+
+#include "DHT22.hpp"
+#include "Testing.hpp"
+
+// The clock advances a step every time it's read, as it would while waiting.
+static Scheduler::Time const Step = 10;
+static Scheduler::Time now = 0;
+
+Scheduler::Time micros()
+{
+    return now += Step;
+}
+
+// Exposes the bounded wait, over a pin driven by the test.
+struct Probe : Sensor
+{
+    using Sensor::_await;
+
+    Pin &pin()
+    {
+        return *_pins.begin()->second;
+    }
+
+    Probe(Pin::Identifier const identifier):
+    Sensor({identifier})
+    {
+        pin().setMode(Pin::Mode::Output);
+    }
+};
+
+int main(int argc, const char * argv[])
+{
+    // The following done to suppress unused variable warnings.
+    (void) argc;
+    (void) argv;
+
+    // A level already on the line is returned at once.
+    Probe probe(1);
+    probe.pin().setValue(0);
+
+    Scheduler::Time time = 0;
+    Scheduler::Time start = now;
+    MJB_CHECK(probe._await(probe.pin(), 0, start + DHT22_TRANSFER_TIMEOUT, time));
+    MJB_CHECK(time == start + Step);
+    MJB_CHECK(probe.health().timeouts == 0);
+
+    // A level that never comes is given up on past the deadline, within a
+    // step of it, and recorded as a timeout.
+    start = now;
+    Scheduler::Time deadline = start + DHT22_TRANSFER_TIMEOUT;
+    MJB_CHECK(!probe._await(probe.pin(), 1, deadline, time));
+    MJB_CHECK(static_cast<int32_t>(time - deadline) > 0);
+    MJB_CHECK(time - deadline <= Step);
+    MJB_CHECK(probe.health().timeouts == 1);
+
+    // Deadlines past the clock's overflow hold as well.
+    now = ~static_cast<Scheduler::Time>(0) - (DHT22_RESPONSE_TIMEOUT / 2);
+    start = now;
+    deadline = start + DHT22_RESPONSE_TIMEOUT;
+    MJB_CHECK(!probe._await(probe.pin(), 1, deadline, time));
+    MJB_CHECK(time - start > DHT22_RESPONSE_TIMEOUT);
+    MJB_CHECK(time - deadline <= Step);
+    MJB_CHECK(probe.health().timeouts == 2);
+
+    // A sensor that never answers, its line held low (as host pins read),
+    // costs a reading the response timeout and no more: the reply's pull down
+    // is seen, but not the pull up following it.
+    now = 0;
+    DHT22 sensor(2);
+
+    start = now;
+    Sensor::Data const data = sensor.sense();
+    MJB_CHECK(data.empty());
+    MJB_CHECK(sensor.health().timeouts == 1);
+    MJB_CHECK(sensor.health().readings == 0);
+    MJB_CHECK(sensor.health().checksumFailures == 0);
+
+    // Besides the waits, sensing reads the clock but a few times.
+    MJB_CHECK(now - start > DHT22_RESPONSE_TIMEOUT);
+    MJB_CHECK(now - start <= DHT22_RESPONSE_TIMEOUT + (8 * Step));
+
+    return Testing::Result("SensorTester");
+}
+
+#endif
@@ -0,0 +1,305 @@
+//
+//  SetpointProgram.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "SetpointProgram.hpp"
+
+#include <algorithm>
+
+#if defined(MJB_POSIX_API)
+#include <ctime>
+#endif
+
+constexpr SetpointProgram::Time SetpointProgram::_Day;
+constexpr SetpointProgram::Time SetpointProgram::_Week;
+
+
+// =============================================================================
+// SetpointProgram::Transition & SetpointProgram::Holiday : Implementation
+// =============================================================================
+bool SetpointProgram::Transition::operator==(SetpointProgram::Transition const &other) const
+{
+    return (minute == other.minute) && (target == other.target);
+}
+
+bool SetpointProgram::Holiday::operator==(SetpointProgram::Holiday const &other) const
+{
+    return (first == other.first) && (last == other.last) && (target == other.target);
+}
+
+
+// =============================================================================
+// SetpointProgram::Library : Implementation
+// =============================================================================
+std::shared_ptr<SetpointProgram const> SetpointProgram::Library::intern(SetpointProgram const &program)
+{
+#if defined(MJB_MULTITHREAD_CAPABLE)
+    std::lock_guard<std::mutex> const lock(_lock);
+#endif
+
+    auto const range = _programs.equal_range(program.hash());
+
+    for (auto entry = range.first; entry != range.second;)
+    {
+        std::shared_ptr<SetpointProgram const> const interned = entry->second.lock();
+
+        // Programs no zone holds anymore are let go of as they're found.
+        if (!interned)
+        {
+            entry = _programs.erase(entry);
+            continue;
+        }
+
+        if (*interned == program) return interned;
+        ++entry;
+    }
+
+    std::shared_ptr<SetpointProgram const> const interned(std::make_shared<SetpointProgram const>(program));
+    _programs.emplace(program.hash(), interned);
+    return interned;
+}
+
+std::size_t SetpointProgram::Library::size() const
+{
+#if defined(MJB_MULTITHREAD_CAPABLE)
+    std::lock_guard<std::mutex> const lock(_lock);
+#endif
+
+    std::size_t size = 0;
+
+    for (auto const &entry : _programs)
+    {
+        if (!entry.second.expired()) size++;
+    }
+
+    return size;
+}
+
+SetpointProgram::Library &SetpointProgram::Library::Default()
+{
+    static SetpointProgram::Library library;
+    return library;
+}
+
+
+// =============================================================================
+// SetpointProgram : Implementation
+// =============================================================================
+SetpointProgram::Transition SetpointProgram::At(SetpointProgram::Day const day,
+                                                unsigned const hour,
+                                                unsigned const minute,
+                                                Thermometer::TemperatureUnit const &target)
+{
+    return {static_cast<uint16_t>((day * 1440) + (hour * 60) + minute), static_cast<float>(target.value())};
+}
+
+SetpointProgram::Holiday SetpointProgram::Between(int32_t const first,
+                                                  int32_t const last,
+                                                  Thermometer::TemperatureUnit const &target)
+{
+    return {first, last, static_cast<float>(target.value())};
+}
+
+int32_t SetpointProgram::DayOf(SetpointProgram::Time const time)
+{
+    // Rounding down, for times before the epoch.
+    return static_cast<int32_t>((time >= 0)? (time / SetpointProgram::_Day) :
+                                             -((-time + SetpointProgram::_Day - 1) / SetpointProgram::_Day));
+}
+
+#if defined(MJB_POSIX_API)
+SetpointProgram::Time SetpointProgram::LocalTime()
+{
+    time_t const now = time(nullptr);
+
+    struct tm local;
+    if (!localtime_r(&now, &local)) return now;
+
+    return static_cast<SetpointProgram::Time>(now) + local.tm_gmtoff;
+}
+#endif
+
+bool SetpointProgram::setpoint(SetpointProgram::Time const time, SetpointProgram::Setpoint &setpoint) const
+{
+    int32_t const day = SetpointProgram::DayOf(time);
+
+    // The first holiday starting after the day, preceded by any it falls on.
+    SetpointProgram::Holidays::const_iterator const nextHoliday =
+        std::upper_bound(_holidays.begin(), _holidays.end(), day,
+                         [](int32_t const day, SetpointProgram::Holiday const &holiday) { return day < holiday.first; });
+
+    if ((nextHoliday != _holidays.begin()) && (day <= (nextHoliday - 1)->last))
+    {
+        SetpointProgram::Holiday const &holiday = *(nextHoliday - 1);
+
+        setpoint.target = Thermometer::TemperatureUnit(Thermometer::TemperatureUnit::value_type(holiday.target));
+        setpoint.since = holiday.first * SetpointProgram::_Day;
+        setpoint.until = (static_cast<SetpointProgram::Time>(holiday.last) + 1) * SetpointProgram::_Day;
+        return true;
+    }
+
+    if (_transitions.empty()) return false;
+
+    // The epoch fell on a Thursday.
+    int32_t const weekday = (((day + SetpointProgram::Day::Thursday) % 7) + 7) % 7;
+    SetpointProgram::Time const weekStart = static_cast<SetpointProgram::Time>(day - weekday) * SetpointProgram::_Day;
+    uint16_t const minute = static_cast<uint16_t>((time - weekStart) / 60);
+
+    SetpointProgram::Transitions::const_iterator const next =
+        std::upper_bound(_transitions.begin(), _transitions.end(), minute,
+                         [](uint16_t const minute, SetpointProgram::Transition const &transition) { return minute < transition.minute; });
+
+    // Before the week's first transition, last week's last one holds.
+    SetpointProgram::Transition const &current = (next == _transitions.begin())? _transitions.back() : *(next - 1);
+    SetpointProgram::Time since = weekStart + (current.minute * 60);
+    if (next == _transitions.begin()) since -= SetpointProgram::_Week;
+
+    SetpointProgram::Time until = (next == _transitions.end())? (weekStart + SetpointProgram::_Week + (_transitions.front().minute * 60)) :
+                                                                (weekStart + (next->minute * 60));
+
+    // Holidays around the time cut the interval short.
+    if (nextHoliday != _holidays.end())
+    {
+        until = std::min(until, nextHoliday->first * SetpointProgram::_Day);
+    }
+
+    if (nextHoliday != _holidays.begin())
+    {
+        since = std::max(since, (static_cast<SetpointProgram::Time>((nextHoliday - 1)->last) + 1) * SetpointProgram::_Day);
+    }
+
+    setpoint.target = Thermometer::TemperatureUnit(Thermometer::TemperatureUnit::value_type(current.target));
+    setpoint.since = since;
+    setpoint.until = until;
+    return true;
+}
+
+SetpointProgram::Transitions const &SetpointProgram::transitions() const
+{
+    return _transitions;
+}
+
+SetpointProgram::Holidays const &SetpointProgram::holidays() const
+{
+    return _holidays;
+}
+
+std::size_t SetpointProgram::hash() const
+{
+    return _hash;
+}
+
+bool SetpointProgram::operator==(SetpointProgram const &other) const
+{
+    return (_hash == other._hash) && (_transitions == other._transitions) && (_holidays == other._holidays);
+}
+
+std::size_t SetpointProgram::_Hash(SetpointProgram::Transitions const &transitions,
+                                   SetpointProgram::Holidays const &holidays)
+{
+    // FNV-1a, over the fields rather than the structs, to skip their padding.
+    uint64_t hash = 0xCBF29CE484222325ULL;
+
+    auto const mix = [&hash](void const * const data, std::size_t const size) {
+        for (std::size_t byte = 0; byte < size; byte++)
+        {
+            hash = (hash ^ static_cast<uint8_t const *>(data)[byte]) * 0x100000001B3ULL;
+        }
+    };
+
+    for (SetpointProgram::Transition const &transition : transitions)
+    {
+        mix(&transition.minute, sizeof(transition.minute));
+        mix(&transition.target, sizeof(transition.target));
+    }
+
+    for (SetpointProgram::Holiday const &holiday : holidays)
+    {
+        mix(&holiday.first, sizeof(holiday.first));
+        mix(&holiday.last, sizeof(holiday.last));
+        mix(&holiday.target, sizeof(holiday.target));
+    }
+
+    return static_cast<std::size_t>(hash);
+}
+
+
+// =============================================================================
+// SetpointProgram : Constructors & Destructor
+// =============================================================================
+SetpointProgram::SetpointProgram(SetpointProgram::Transitions const &transitions,
+                                 SetpointProgram::Holidays const &holidays)
+{
+    SetpointProgram::Transitions sorted;
+
+    for (SetpointProgram::Transition const &transition : transitions)
+    {
+        if (transition.minute < (SetpointProgram::_Week / 60)) sorted.push_back(transition);
+    }
+
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](SetpointProgram::Transition const &a, SetpointProgram::Transition const &b) { return a.minute < b.minute; });
+
+    // Of transitions at the same minute, the last given is kept.
+    SetpointProgram::Transitions unique;
+
+    for (SetpointProgram::Transition const &transition : sorted)
+    {
+        if (!unique.empty() && (unique.back().minute == transition.minute)) unique.back() = transition;
+        else unique.push_back(transition);
+    }
+
+    // Transitions to the target already in effect change nothing; the week
+    // wraps around, so the first follows the last.
+    for (std::size_t index = 0; index < unique.size(); index++)
+    {
+        float const previous = unique[index? (index - 1) : (unique.size() - 1)].target;
+        if ((unique.size() == 1) || (unique[index].target != previous)) _transitions.push_back(unique[index]);
+    }
+
+    if (_transitions.empty() && !unique.empty()) _transitions.push_back(unique.front());
+
+    SetpointProgram::Holidays sortedHolidays;
+
+    for (SetpointProgram::Holiday const &holiday : holidays)
+    {
+        if (holiday.first <= holiday.last) sortedHolidays.push_back(holiday);
+    }
+
+    std::stable_sort(sortedHolidays.begin(), sortedHolidays.end(),
+                     [](SetpointProgram::Holiday const &a, SetpointProgram::Holiday const &b) { return a.first < b.first; });
+
+    // A holiday takes over its own days from those it overlaps, which keep
+    // the days before and after it; the ones overlapping it are those last
+    // compiled, as all started earlier.
+    SetpointProgram::Holidays overlapped;
+
+    for (SetpointProgram::Holiday const &holiday : sortedHolidays)
+    {
+        overlapped.clear();
+
+        while (!_holidays.empty() && (holiday.first <= _holidays.back().last))
+        {
+            overlapped.insert(overlapped.begin(), _holidays.back());
+            _holidays.pop_back();
+        }
+
+        for (SetpointProgram::Holiday const &earlier : overlapped)
+        {
+            if (earlier.first < holiday.first) _holidays.push_back({earlier.first, holiday.first - 1, earlier.target});
+        }
+
+        _holidays.push_back(holiday);
+
+        for (SetpointProgram::Holiday const &earlier : overlapped)
+        {
+            if (earlier.last > holiday.last) _holidays.push_back({std::max(earlier.first, holiday.last + 1), earlier.last, earlier.target});
+        }
+    }
+
+    _hash = SetpointProgram::_Hash(_transitions, _holidays);
+}
@@ -0,0 +1,148 @@
+//
+//  SetpointProgram.hpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef SetpointProgram_hpp
+#define SetpointProgram_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "Development.hpp"
+#include "Thermometer.hpp"
+
+// =============================================================================
+// SetpointProgram : This class holds a zone's weekly schedule of setpoints,
+// and the holidays overriding it, compiled into sorted intervals; looking up
+// the setpoint at a time is a binary search of each, and also tells when the
+// setpoint will next change, so that it need only be looked up again then.
+// Programs are immutable once compiled, so zones on the same schedule may
+// share one through a Library, which keeps a single copy of every program.
+// NOTE: Times are in seconds of local time, that is, Unix time shifted by the
+// zone's UTC offset; weeks start on Sunday.
+// =============================================================================
+class SetpointProgram
+{
+public:
+    typedef int64_t Time;
+    typedef std::function<Time()> Clock;
+
+    enum Day
+    {
+        Sunday,
+        Monday,
+        Tuesday,
+        Wednesday,
+        Thursday,
+        Friday,
+        Saturday
+    };
+
+    // The target from a minute of the week on, until the next transition.
+    struct Transition
+    {
+        uint16_t minute;
+        float target;       // Kelvin.
+
+        bool operator==(Transition const &other) const;
+    };
+
+    // The target for whole days, from the first to the last (days since the
+    // epoch, inclusive), overriding the week's.
+    struct Holiday
+    {
+        int32_t first;
+        int32_t last;
+        float target;       // Kelvin.
+
+        bool operator==(Holiday const &other) const;
+    };
+
+    typedef std::vector<Transition> Transitions;
+    typedef std::vector<Holiday> Holidays;
+
+    // The setpoint in effect at a time, from when, and until when.
+    struct Setpoint
+    {
+        Thermometer::TemperatureUnit target;
+        Time since;
+        Time until;
+    };
+
+    // =========================================================================
+    // Library : Interns programs, handing out the one copy of each kept; the
+    // copy lives on for as long as any zone holds it.
+    // =========================================================================
+    class Library
+    {
+    public:
+
+        std::shared_ptr<SetpointProgram const> intern(SetpointProgram const &program);
+
+        // The distinct programs still held by some zone.
+        std::size_t size() const;
+
+        static Library &Default();
+
+    protected:
+
+        std::unordered_multimap<std::size_t, std::weak_ptr<SetpointProgram const>> _programs;
+#if defined(MJB_MULTITHREAD_CAPABLE)
+        mutable std::mutex _lock;
+#endif
+    };
+
+    static Transition At(Day const day,
+                         unsigned const hour,
+                         unsigned const minute,
+                         Thermometer::TemperatureUnit const &target);
+
+    static Holiday Between(int32_t const first,
+                           int32_t const last,
+                           Thermometer::TemperatureUnit const &target);
+
+    // The day since the epoch a time falls on.
+    static int32_t DayOf(Time const time);
+
+#if defined(MJB_POSIX_API)
+    // The system's local time, per its time zone.
+    static Time LocalTime();
+#endif
+
+    // Programs without transitions have no setpoint but on their holidays;
+    // otherwise, the setpoint's target is that of the program, and its since
+    // and until are the program's transitions around the time.
+    bool setpoint(Time const time, Setpoint &setpoint) const;
+
+    Transitions const &transitions() const;
+    Holidays const &holidays() const;
+
+    std::size_t hash() const;
+    bool operator==(SetpointProgram const &other) const;
+
+    // Transitions are sorted, and those not changing the target dropped; where
+    // holidays overlap, the one starting later takes over for its own days
+    // only, so a holiday within another splits it around itself.
+    SetpointProgram(Transitions const &transitions, Holidays const &holidays = Holidays());
+
+protected:
+
+    static constexpr Time _Day = 86400;
+    static constexpr Time _Week = 7 * _Day;
+
+    Transitions _transitions;
+    Holidays _holidays;
+    std::size_t _hash;
+
+    static std::size_t _Hash(Transitions const &transitions, Holidays const &holidays);
+};
+
+#endif /* SetpointProgram_hpp */
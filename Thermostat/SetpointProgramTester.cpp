@@ -0,0 +1,217 @@
+//
+//  SetpointProgramTester.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "Development.hpp"
+
+#if ! defined(MJB_ARDUINO_LIB_API)
+
+#include <random>
+#include <vector>
+#include "SetpointProgram.hpp"
+#include "Testing.hpp"
+
+Scheduler::Time micros()
+{
+    return 0;
+}
+
+typedef Thermometer::TemperatureUnit TemperatureUnit;
+
+static TemperatureUnit Celsius(float const celsius)
+{
+    return TemperatureUnit(celsius, TemperatureUnit::Scale::Celsius);
+}
+
+static SetpointProgram::Holiday Holiday(int32_t const first, int32_t const last, float const target)
+{
+    return {first, last, target};
+}
+
+// The target at a time, found by going through the program as given: of the
+// holidays on the day, the one starting latest (or given last, of those
+// starting together), otherwise the week's last transition by then.
+static bool Expected(SetpointProgram::Transitions const &transitions,
+                     SetpointProgram::Holidays const &holidays,
+                     SetpointProgram::Time const time,
+                     float &target)
+{
+    int32_t const day = SetpointProgram::DayOf(time);
+    SetpointProgram::Holiday const *latest = nullptr;
+
+    for (SetpointProgram::Holiday const &holiday : holidays)
+    {
+        if ((holiday.first > holiday.last) || (day < holiday.first) || (day > holiday.last)) continue;
+        if (!latest || (holiday.first >= latest->first)) latest = &holiday;
+    }
+
+    if (latest)
+    {
+        target = latest->target;
+        return true;
+    }
+
+    if (transitions.empty()) return false;
+
+    // Of transitions at the same minute, the last given holds.
+    int32_t const weekday = (((day + SetpointProgram::Day::Thursday) % 7) + 7) % 7;
+    int64_t const minute = (time - (static_cast<int64_t>(day - weekday) * 86400)) / 60;
+    int64_t latestMinute = -1, lastMinute = -1;
+    float lastTarget = 0;
+
+    for (SetpointProgram::Transition const &transition : transitions)
+    {
+        if ((transition.minute <= minute) && (transition.minute >= latestMinute))
+        {
+            latestMinute = transition.minute;
+            target = transition.target;
+        }
+
+        if (transition.minute >= lastMinute)
+        {
+            lastMinute = transition.minute;
+            lastTarget = transition.target;
+        }
+    }
+
+    // Before the week's first transition, last week's last one holds.
+    if (latestMinute < 0) target = lastTarget;
+    return true;
+}
+
+int main(int argc, const char * argv[])
+{
+    // A holiday within another splits it around itself, whichever's given
+    // first; of holidays starting together, the one given last takes over.
+    SetpointProgram const nested({}, {Holiday(1, 10, 280), Holiday(3, 4, 290)});
+    MJB_CHECK(nested.holidays() == SetpointProgram::Holidays({Holiday(1, 2, 280), Holiday(3, 4, 290), Holiday(5, 10, 280)}));
+
+    SetpointProgram const reversed({}, {Holiday(3, 4, 290), Holiday(1, 10, 280)});
+    MJB_CHECK(reversed.holidays() == nested.holidays());
+
+    SetpointProgram const together({}, {Holiday(3, 8, 280), Holiday(3, 5, 290), Holiday(4, 4, 300), Holiday(7, 12, 285)});
+    MJB_CHECK(together.holidays() == SetpointProgram::Holidays({Holiday(3, 3, 290), Holiday(4, 4, 300),
+                                                               Holiday(5, 5, 290), Holiday(6, 6, 280),
+                                                               Holiday(7, 12, 285)}));
+
+    // The enclosing holiday holds again after the one within it, to its end.
+    SetpointProgram::Setpoint setpoint;
+    MJB_CHECK(nested.setpoint((6 * 86400) + 3600, setpoint));
+    MJB_CHECK(setpoint.target.value() == TemperatureUnit::value_type(280));
+    MJB_CHECK((setpoint.since == (5 * 86400)) && (setpoint.until == (11 * 86400)));
+    MJB_CHECK(!nested.setpoint(11 * 86400, setpoint));
+
+    // Lookups in random programs, holidays overlapping and all, give the
+    // target going through the program as given does, and hold it from
+    // since until until.
+    std::mt19937 random(47);
+    unsigned mismatches = 0;
+
+    for (std::size_t trial = 0; trial < 200; trial++)
+    {
+        SetpointProgram::Transitions transitions;
+        for (std::size_t count = random() % 12; count; count--)
+        {
+            transitions.push_back({static_cast<uint16_t>(random() % 10080), static_cast<float>(280 + (random() % 5))});
+        }
+
+        SetpointProgram::Holidays holidays;
+        for (std::size_t count = random() % 6; count; count--)
+        {
+            int32_t const first = 19000 + (random() % 60);
+            holidays.push_back(Holiday(first, first + (random() % 20), static_cast<float>(270 + (random() % 5))));
+        }
+
+        SetpointProgram const program(transitions, holidays);
+
+        for (std::size_t lookup = 0; lookup < 200; lookup++)
+        {
+            SetpointProgram::Time const time = (19000 * 86400LL) + (random() % (90 * 86400));
+            float target = 0;
+
+            bool const expected = Expected(transitions, holidays, time, target);
+            if (program.setpoint(time, setpoint) != expected)
+            {
+                mismatches++;
+                continue;
+            }
+
+            if (!expected) continue;
+
+            SetpointProgram::Setpoint since, until;
+            program.setpoint(setpoint.since, since);
+            program.setpoint(setpoint.until - 1, until);
+
+            if ((setpoint.target.value() != TemperatureUnit::value_type(target)) ||
+                (setpoint.since > time) || (time >= setpoint.until) ||
+                (since.target.value() != setpoint.target.value()) ||
+                (until.target.value() != setpoint.target.value())) mismatches++;
+        }
+    }
+
+    MJB_CHECK(!mismatches);
+
+    // Zones on the same schedule share one program.
+    std::vector<std::shared_ptr<SetpointProgram const>> zones;
+    SetpointProgram::Library library;
+
+    for (unsigned zone = 0; zone < 1000; zone++)
+    {
+        SetpointProgram::Transitions const transitions = {
+            SetpointProgram::At(SetpointProgram::Day::Monday, 6 + (zone % 5), 0, Celsius(21)),
+            SetpointProgram::At(SetpointProgram::Day::Monday, 22, 0, Celsius(17))
+        };
+        zones.push_back(library.intern(SetpointProgram(transitions)));
+    }
+
+    MJB_CHECK(library.size() == 5);
+    MJB_CHECK(zones[0] == zones[5]);
+
+    if (Testing::Benchmarking(argc, argv))
+    {
+        SetpointProgram::Transitions transitions;
+        for (unsigned day = SetpointProgram::Day::Sunday; day <= SetpointProgram::Day::Saturday; day++)
+        {
+            for (unsigned hour = 0; hour < 24; hour += 2)
+            {
+                transitions.push_back(SetpointProgram::At(static_cast<SetpointProgram::Day>(day), hour, 0, Celsius(18 + (hour % 4))));
+            }
+        }
+
+        SetpointProgram::Holidays holidays;
+        for (int32_t week = 0; week < 30; week++)
+        {
+            holidays.push_back(SetpointProgram::Between(19000 + (7 * week), 19001 + (7 * week), Celsius(15)));
+        }
+
+        SetpointProgram const program(transitions, holidays);
+        std::size_t const lookups = 10000000;
+        float checksum = 0;
+
+        std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+        for (std::size_t lookup = 0; lookup < lookups; lookup++)
+        {
+            program.setpoint((19000 * 86400LL) + (lookup * 61), setpoint);
+            checksum += static_cast<float>(setpoint.target.value());
+        }
+        double const seconds = Testing::Seconds(start);
+
+        std::fprintf(stderr, "SetpointProgram::setpoint: %.1f ns, %zu transitions, %zu holidays (%g)\n",
+                     seconds * 1e9 / lookups, program.transitions().size(), program.holidays().size(), checksum);
+    }
+
+    return Testing::Result("SetpointProgramTester");
+}
+
+#else
+
+int main()
+{
+    return 0;
+}
+
+#endif
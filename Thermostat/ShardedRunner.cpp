@@ -0,0 +1,262 @@
+//
+//  ShardedRunner.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "ShardedRunner.hpp"
+
+#if defined(MJB_MULTITHREAD_CAPABLE)
+
+#include <algorithm>
+#include <chrono>
+
+#if defined(MJB_POSIX_API) && defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// =============================================================================
+// ShardedRunner::Shard : Implementation
+// =============================================================================
+std::size_t ShardedRunner::Shard::index() const
+{
+    return _index;
+}
+
+int ShardedRunner::Shard::core() const
+{
+    return _core.load();
+}
+
+std::size_t ShardedRunner::Shard::size() const
+{
+    return _size.load();
+}
+
+uint64_t ShardedRunner::Shard::cycles() const
+{
+    return _cycles.load(std::memory_order_relaxed);
+}
+
+void ShardedRunner::Shard::_post(ShardedRunner::Shard::Task const &task)
+{
+    std::lock_guard<std::mutex> const lock(_inboxLock);
+    _inbox.push_back(task);
+}
+
+void ShardedRunner::Shard::_drain()
+{
+    std::vector<ShardedRunner::Shard::Task> tasks;
+
+    {
+        std::lock_guard<std::mutex> const lock(_inboxLock);
+        tasks.swap(_inbox);
+    }
+
+    for (ShardedRunner::Shard::Task const &task : tasks)
+    {
+        task();
+    }
+}
+
+void ShardedRunner::Shard::_run(ShardedRunner &runner)
+{
+    // Everything made on this thread from here on joins the shard's registry.
+    Scheduler::Registry::SetCurrent(&_registry);
+
+    while (runner._running.load(std::memory_order_acquire))
+    {
+        _drain();
+
+        Scheduler::UpdateInstances(runner._clock());
+        _cycles.fetch_add(1, std::memory_order_relaxed);
+
+        if (runner._idleInterval)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(runner._idleInterval));
+        }
+    }
+
+    Scheduler::Registry::SetCurrent(nullptr);
+}
+
+ShardedRunner::Shard::Shard(std::size_t const index):
+_index(index),
+_core(-1),
+_size(0),
+_cycles(0)
+{
+
+}
+
+ShardedRunner::Shard::~Shard()
+{
+    if (_thread.joinable()) _thread.join();
+
+    // Thermostats leave the shard's registry as they're destroyed, before it is.
+    _thermostats.clear();
+}
+
+
+// =============================================================================
+// ShardedRunner : Implementation
+// =============================================================================
+std::size_t ShardedRunner::shards() const
+{
+    return _shards.size();
+}
+
+ShardedRunner::Shard const &ShardedRunner::shard(std::size_t const index) const
+{
+    return *_shards[index];
+}
+
+ShardedRunner::Handle ShardedRunner::add(ShardedRunner::Factory const &factory)
+{
+    std::size_t const shardIndex = _nextShard;
+    _nextShard = (_nextShard + 1) % _shards.size();
+
+    ShardedRunner::Shard &shard = *_shards[shardIndex];
+    ShardedRunner::Handle const handle = {static_cast<uint32_t>(shardIndex), _assigned[shardIndex]++};
+
+    // Messages run in order, so the thermostat lands at the handle's index.
+    shard._post([&shard, factory]() {
+        shard._thermostats.push_back(factory());
+        shard._size.store(shard._thermostats.size());
+    });
+
+    return handle;
+}
+
+bool ShardedRunner::post(ShardedRunner::Handle const &handle, ShardedRunner::Message const &message)
+{
+    if ((handle.shard >= _shards.size()) || (handle.index >= _assigned[handle.shard])) return false;
+
+    ShardedRunner::Shard &shard = *_shards[handle.shard];
+    uint32_t const index = handle.index;
+
+    shard._post([&shard, index, message]() {
+        // Factories may have failed to make their thermostat.
+        if (shard._thermostats[index]) message(*shard._thermostats[index]);
+    });
+
+    return true;
+}
+
+bool ShardedRunner::setMode(ShardedRunner::Handle const &handle, Thermostat::Mode const mode)
+{
+    return post(handle, [mode](Thermostat &thermostat) {
+        thermostat.setMode(mode);
+    });
+}
+
+bool ShardedRunner::setTargetTemperature(ShardedRunner::Handle const &handle,
+                                         Thermometer::TemperatureUnit const &targetTemperature)
+{
+    return post(handle, [targetTemperature](Thermostat &thermostat) {
+        thermostat.setTargetTemperature(targetTemperature);
+    });
+}
+
+std::future<Thermostat::Status> ShardedRunner::status(ShardedRunner::Handle const &handle)
+{
+    // Messages must be copyable, and promises aren't, so the message shares it.
+    std::shared_ptr<std::promise<Thermostat::Status>> const promise(std::make_shared<std::promise<Thermostat::Status>>());
+
+    if (!post(handle, [promise](Thermostat &thermostat) { promise->set_value(thermostat.status()); }))
+    {
+        promise->set_value(Thermostat::Status::Standby);
+    }
+
+    return promise->get_future();
+}
+
+bool ShardedRunner::running() const
+{
+    return _running.load();
+}
+
+bool ShardedRunner::start()
+{
+    if (running()) return false;
+
+    _running.store(true, std::memory_order_release);
+
+    unsigned const cores = std::thread::hardware_concurrency();
+
+    for (std::unique_ptr<ShardedRunner::Shard> const &shard : _shards)
+    {
+        ShardedRunner::Shard * const runnerShard = shard.get();
+        shard->_thread = std::thread([this, runnerShard]() { runnerShard->_run(*this); });
+
+        int const core = cores? static_cast<int>(shard->index() % cores) : -1;
+        shard->_core.store(ShardedRunner::_Pin(shard->_thread, core)? core : -1);
+    }
+
+    return true;
+}
+
+void ShardedRunner::stop()
+{
+    _running.store(false, std::memory_order_release);
+
+    for (std::unique_ptr<ShardedRunner::Shard> const &shard : _shards)
+    {
+        if (shard->_thread.joinable()) shard->_thread.join();
+        shard->_core.store(-1);
+    }
+}
+
+Scheduler::Time ShardedRunner::SteadyClock()
+{
+    std::chrono::steady_clock::duration const elapsed = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<Scheduler::Time>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+}
+
+bool ShardedRunner::_Pin(std::thread &thread, int const core)
+{
+#if defined(MJB_POSIX_API) && defined(__linux__)
+    if (core < 0) return false;
+
+    cpu_set_t cores;
+    CPU_ZERO(&cores);
+    CPU_SET(core, &cores);
+    return !pthread_setaffinity_np(thread.native_handle(), sizeof(cores), &cores);
+#else
+    // The following done to suppress unused variable warnings.
+    (void) thread;
+    (void) core;
+    return false;
+#endif
+}
+
+
+// =============================================================================
+// ShardedRunner : Constructors & Destructor
+// =============================================================================
+ShardedRunner::ShardedRunner(std::size_t const shards,
+                             ShardedRunner::Clock const &clock,
+                             Scheduler::Time const idleInterval):
+_nextShard(0),
+_clock(clock),
+_idleInterval(idleInterval),
+_running(false)
+{
+    std::size_t const count = shards? shards : std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+
+    for (std::size_t index = 0; index < count; index++)
+    {
+        _shards.push_back(std::unique_ptr<ShardedRunner::Shard>(new ShardedRunner::Shard(index)));
+        _assigned.push_back(0);
+    }
+}
+
+ShardedRunner::~ShardedRunner()
+{
+    stop();
+}
+
+#endif
@@ -0,0 +1,155 @@
+//
+//  ShardedRunner.hpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef ShardedRunner_hpp
+#define ShardedRunner_hpp
+
+#include "Development.hpp"
+
+#if defined(MJB_MULTITHREAD_CAPABLE)
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Scheduler.hpp"
+#include "Thermometer.hpp"
+#include "Thermostat.hpp"
+#include "Actuator.hpp"
+
+// =============================================================================
+// ShardedRunner : This class runs many Thermostats across threads, one shard
+// per thread, each pinned to a core where the platform allows it. Every shard
+// keeps its own Scheduler::Registry, so the schedulers of its thermostats (and
+// of their actuators and sensors) are only ever updated by its own clock loop;
+// shards share no thermostats, schedulers or events.
+// Thermostats are only touched on their shard's thread; anything done to them
+// from elsewhere, as changing a setpoint or reading a status, is posted to the
+// shard as a message, which runs between the shard's update cycles.
+// NOTE: The clock is called from every shard's thread, so it must be safe to;
+// by default, it's SteadyClock. Thermostats, and their sensors, read micros()
+// on their own as well, which must then be safe to call from any thread too.
+// =============================================================================
+class ShardedRunner
+{
+public:
+    typedef std::function<std::shared_ptr<Thermostat>()> Factory;
+    typedef std::function<void(Thermostat &thermostat)> Message;
+    typedef std::function<Scheduler::Time()> Clock;
+
+    // Identifies a thermostat by its shard, and its place within the shard.
+    struct Handle
+    {
+        uint32_t shard;
+        uint32_t index;
+    };
+
+    // =========================================================================
+    // Shard : A thread running its own thermostats, with its own registry.
+    // =========================================================================
+    class Shard
+    {
+    public:
+
+        std::size_t index() const;
+
+        // The core the shard's thread is pinned to, or -1 if it isn't.
+        int core() const;
+
+        std::size_t size() const;
+
+        // The update cycles the shard's clock loop has run.
+        uint64_t cycles() const;
+
+        Shard(std::size_t const index);
+        ~Shard();
+
+    protected:
+
+        friend class ShardedRunner;
+
+        typedef std::function<void()> Task;
+
+        std::size_t const _index;
+        std::atomic<int> _core;
+        std::atomic<std::size_t> _size;
+        std::atomic<uint64_t> _cycles;
+
+        // Only ever touched on the shard's thread, but for destruction.
+        std::vector<std::shared_ptr<Thermostat>> _thermostats;
+        Scheduler::Registry _registry;
+
+        // The shard's message queue; producers append to the inbox, which the
+        // shard swaps out whole, so that it's only locked for the swap.
+        std::vector<Task> _inbox;
+        std::mutex _inboxLock;
+
+        std::thread _thread;
+
+        void _post(Task const &task);
+        void _drain();
+        void _run(ShardedRunner &runner);
+    };
+
+    std::size_t shards() const;
+    Shard const &shard(std::size_t const index) const;
+
+    // Thermostats are made by the factory on their shard's thread, so that
+    // their schedulers join the shard's registry; shards take turns. The
+    // thermostat is made once the shard runs, and is only then sent messages.
+    // NOTE: Thermostats should only be added from the runner's own thread.
+    Handle add(Factory const &factory);
+
+    // Runs the message on the thermostat's shard, between update cycles.
+    bool post(Handle const &handle, Message const &message);
+
+    bool setMode(Handle const &handle, Thermostat::Mode const mode);
+    bool setTargetTemperature(Handle const &handle, Thermometer::TemperatureUnit const &targetTemperature);
+
+    // The status is read on the thermostat's shard; until the shard gets to
+    // it, the future isn't ready.
+    std::future<Thermostat::Status> status(Handle const &handle);
+
+    bool running() const;
+    bool start();
+    void stop();
+
+    // Microseconds on std::chrono::steady_clock, wrapping around as micros()
+    // does; it's safe to call from any thread.
+    static Scheduler::Time SteadyClock();
+
+    // One shard per core by default. Every cycle, each shard runs its messages
+    // and updates its schedulers, then sleeps for the idle interval (in
+    // microseconds), if any.
+    ShardedRunner(std::size_t const shards = 0,
+                  Clock const &clock = ShardedRunner::SteadyClock,
+                  Scheduler::Time const idleInterval = 1000);
+    ~ShardedRunner();
+
+protected:
+
+    std::vector<std::unique_ptr<Shard>> _shards;
+    std::vector<uint32_t> _assigned;    // Thermostats handed out, by shard.
+    std::size_t _nextShard;
+
+    Clock const _clock;
+    Scheduler::Time const _idleInterval;
+    std::atomic<bool> _running;
+
+    // Pins the thread to the core, where supported; returns whether it did.
+    static bool _Pin(std::thread &thread, int const core);
+};
+
+#endif
+
+#endif /* ShardedRunner_hpp */
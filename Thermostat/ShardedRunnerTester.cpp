@@ -0,0 +1,167 @@
+//
+//  ShardedRunnerTester.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "Development.hpp"
+
+#if defined(MJB_MULTITHREAD_CAPABLE)
+
+#include <cstdlib>
+#include <vector>
+#include "ShardedRunner.hpp"
+#include "Testing.hpp"
+
+// Shards' thermostats read the clock on their own threads, so it's the
+// runner's own, which is safe to.
+Scheduler::Time micros()
+{
+    return ShardedRunner::SteadyClock();
+}
+
+typedef Thermometer::TemperatureUnit TemperatureUnit;
+
+// Reads 62F, at once, every time it's sensed.
+class Fixed : public Thermometer
+{
+public:
+
+    Sensor::Data sense()
+    {
+        _temperature = TemperatureUnit(62, TemperatureUnit::Scale::Fahrenheit);
+        _humidity = 40;
+        _recordReading();
+        return Sensor::Data();
+    }
+
+    Fixed():
+    Thermometer({})
+    {
+
+    }
+};
+
+// Adds count thermostats evaluating every interval, each on pins of its own,
+// keeping their thermometers to count the readings taken.
+static std::vector<ShardedRunner::Handle> Populate(ShardedRunner &runner,
+                                                  std::vector<std::shared_ptr<Fixed>> &thermometers,
+                                                  std::size_t const count,
+                                                  Scheduler::Time const interval)
+{
+    thermometers.assign(count, nullptr);
+
+    std::vector<ShardedRunner::Handle> handles;
+    for (std::size_t index = 0; index < count; index++)
+    {
+        std::shared_ptr<Fixed> &thermometer = thermometers[index];
+        Pin::Identifier const pin = static_cast<Pin::Identifier>(1000 + (3 * index));
+
+        handles.push_back(runner.add([&thermometer, pin, interval]() {
+            thermometer = std::make_shared<Fixed>();
+            return std::make_shared<Thermostat>(Pin::Arrangement({pin, pin + 1, pin + 2}),
+                                                Thermostat::Thermometers({thermometer}),
+                                                interval);
+        }));
+    }
+
+    return handles;
+}
+
+static uint64_t Readings(std::vector<std::shared_ptr<Fixed>> const &thermometers)
+{
+    uint64_t readings = 0;
+    for (std::shared_ptr<Fixed> const &thermometer : thermometers)
+    {
+        if (thermometer) readings += thermometer->health().readings;
+    }
+    return readings;
+}
+
+int main(int argc, const char * argv[])
+{
+    // Thermostats are dealt to the shards in turn, and made on them; messages
+    // reach them there, as do status requests.
+    {
+        ShardedRunner runner(3);
+        MJB_CHECK(runner.shards() == 3);
+
+        std::vector<std::shared_ptr<Fixed>> thermometers;
+        std::vector<ShardedRunner::Handle> const handles = Populate(runner, thermometers, 9, 1000);
+
+        for (std::size_t index = 0; index < handles.size(); index++)
+        {
+            MJB_CHECK(handles[index].shard == (index % 3));
+            MJB_CHECK(handles[index].index == (index / 3));
+        }
+
+        MJB_CHECK(runner.setMode(handles[4], Thermostat::Mode::Heat));
+        MJB_CHECK(runner.setTargetTemperature(handles[4], TemperatureUnit(72, TemperatureUnit::Scale::Fahrenheit)));
+
+        MJB_CHECK(runner.start());
+        MJB_CHECK(runner.running());
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        // Statuses are those of the cycles run since.
+        std::future<Thermostat::Status> heating = runner.status(handles[4]);
+        std::future<Thermostat::Status> standby = runner.status(handles[5]);
+        MJB_CHECK(heating.get() == Thermostat::Status::Heating);
+        MJB_CHECK(standby.get() == Thermostat::Status::Standby);
+
+        runner.stop();
+        MJB_CHECK(!runner.running());
+
+        for (std::size_t index = 0; index < runner.shards(); index++)
+        {
+            MJB_CHECK(runner.shard(index).size() == 3);
+            MJB_CHECK(runner.shard(index).cycles() > 0);
+        }
+
+        for (std::shared_ptr<Fixed> const &thermometer : thermometers)
+        {
+            MJB_CHECK(thermometer && thermometer->health().readings);
+        }
+
+        MJB_CHECK(!runner.post({7, 0}, [](Thermostat &) {}));
+    }
+
+    // Control cycles per second, as shards are added, for as many thermostats;
+    // each evaluates as often as its shard gets to it.
+    if (Testing::Benchmarking(argc, argv))
+    {
+        std::size_t const thermostats = 1000;
+        std::size_t const cores = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+        double baseline = 0;
+
+        for (std::size_t shards = 1; shards <= std::max<std::size_t>(cores, 4); shards *= 2)
+        {
+            ShardedRunner runner(shards, ShardedRunner::SteadyClock, 0);
+            std::vector<std::shared_ptr<Fixed>> thermometers;
+            Populate(runner, thermometers, thermostats, 1);
+
+            // Readings are only counted once the shards have stopped.
+            std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+            runner.start();
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+            runner.stop();
+            double const rate = Readings(thermometers) / Testing::Seconds(start);
+
+            if (shards == 1) baseline = rate;
+            std::fprintf(stderr, "ShardedRunner: %zu shard(s) on %zu core(s): %.0fk control cycles/s (%.2fx)\n",
+                         shards, cores, rate / 1e3, rate / baseline);
+        }
+    }
+
+    return Testing::Result("ShardedRunnerTester");
+}
+
+#else
+
+int main()
+{
+    return 0;
+}
+
+#endif
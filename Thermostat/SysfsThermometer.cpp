@@ -0,0 +1,112 @@
+//
+//  SysfsThermometer.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "SysfsThermometer.hpp"
+
+#if defined(MJB_POSIX_API)
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// =============================================================================
+// SysfsThermometer : Implementation
+// =============================================================================
+Sensor::Data SysfsThermometer::sense()
+{
+    // If the sensor isn't ready (cooling down), cached values remain.
+    if (!available() || (status() != Actuator::Status::Ready)) return Sensor::Data();
+
+    Sensor::sense(); // Restart the sense timeout.
+
+    long temperature = 0;
+    if (!SysfsThermometer::_ReadAttribute(_temperatureDescriptor, temperature)) return Sensor::Data();
+
+    long humidity = 0;
+    bool const humidityRead = (_humidityDescriptor >= 0) &&
+                              SysfsThermometer::_ReadAttribute(_humidityDescriptor, humidity);
+
+    // Attributes are in millidegrees Celsius and thousandths of a percent.
+    _temperature = Thermometer::TemperatureUnit(static_cast<float>(temperature) / 1000,
+                                                Thermometer::TemperatureUnit::Scale::Celsius);
+    if (humidityRead) _humidity = static_cast<float>(humidity) / 1000;
+    _recordReading();
+
+    return Sensor::Data();
+}
+
+bool SysfsThermometer::available() const
+{
+    return _temperatureDescriptor >= 0;
+}
+
+std::size_t SysfsThermometer::Poll(SysfsThermometer::Zones const &zones)
+{
+    std::size_t updated = 0;
+
+    for (std::shared_ptr<SysfsThermometer> const &zone : zones)
+    {
+        uint32_t const readings = zone->health().readings;
+        zone->sense();
+        if (zone->health().readings != readings) updated++;
+    }
+
+    return updated;
+}
+
+int SysfsThermometer::_Open(char const * const path)
+{
+    return path? open(path, O_RDONLY | O_CLOEXEC) : -1;
+}
+
+bool SysfsThermometer::_ReadAttribute(int const descriptor, long &value)
+{
+    // Attributes are short decimal strings; pread from the start re-reads the
+    // attribute without having to seek, or to re-open it, every time.
+    char buffer[32];
+    ssize_t const length = pread(descriptor, buffer, sizeof(buffer), 0);
+
+    return (length > 0) && SysfsThermometer::_ParseInteger(buffer, buffer + length, value);
+}
+
+bool SysfsThermometer::_ParseInteger(char const *begin, char const * const end, long &value)
+{
+    bool const negative = (begin < end) && (*begin == '-');
+    if (negative) begin++;
+
+    char const * const digits = begin;
+    long result = 0;
+
+    // Stop at the first non-digit, typically the trailing new line.
+    for (; (begin < end) && (*begin >= '0') && (*begin <= '9'); begin++)
+    {
+        result = (result * 10) + (*begin - '0');
+    }
+
+    if (begin == digits) return false; // No digits at all.
+
+    value = negative? -result : result;
+    return true;
+}
+
+SysfsThermometer::SysfsThermometer(char const * const temperaturePath,
+                                   char const * const humidityPath,
+                                   Scheduler::Time const senseTimeout):
+Thermometer({}, senseTimeout),
+_temperatureDescriptor(SysfsThermometer::_Open(temperaturePath)),
+_humidityDescriptor(SysfsThermometer::_Open(humidityPath))
+{
+    
+}
+
+SysfsThermometer::~SysfsThermometer()
+{
+    if (_temperatureDescriptor >= 0) close(_temperatureDescriptor);
+    if (_humidityDescriptor >= 0) close(_humidityDescriptor);
+}
+
+#endif
@@ -0,0 +1,63 @@
+//
+//  SysfsThermometer.hpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef SysfsThermometer_hpp
+#define SysfsThermometer_hpp
+
+#include "Development.hpp"
+
+#if defined(MJB_POSIX_API)
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include "Sensor.hpp"
+#include "Scheduler.hpp"
+#include "Thermometer.hpp"
+
+// =============================================================================
+// SysfsThermometer : This class reads temperatures exposed by Linux under
+// /sys/class/hwmon (tempN_input, humidityN_input) and /sys/class/thermal
+// (thermal_zoneN/temp), both reported in thousandths of their unit.
+// Attributes are opened once and re-read in place, allocating nothing.
+// =============================================================================
+class SysfsThermometer : public Thermometer
+{
+public:
+
+    typedef std::vector<std::shared_ptr<SysfsThermometer>> Zones;
+
+    // NOTE: Attributes are only read once the sense timeout has elapsed,
+    // until then the cached values are returned, as with any other sensor.
+    Sensor::Data sense();
+
+    // Returns whether the temperature attribute could be opened.
+    bool available() const;
+
+    // Senses all zones in one pass, returning how many provided new readings.
+    static std::size_t Poll(Zones const &zones);
+
+    // The humidity attribute is optional, pass null if there isn't one.
+    SysfsThermometer(char const * const temperaturePath,
+                     char const * const humidityPath = nullptr,
+                     Scheduler::Time const senseTimeout = 0);
+    virtual ~SysfsThermometer();
+
+protected:
+
+    int const _temperatureDescriptor;
+    int const _humidityDescriptor;
+
+    static int _Open(char const * const path);
+    static bool _ReadAttribute(int const descriptor, long &value);
+    static bool _ParseInteger(char const *begin, char const * const end, long &value);
+};
+
+#endif
+
+#endif /* SysfsThermometer_hpp */
@@ -0,0 +1,161 @@
+//
+//  SysfsThermometerTester.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "Development.hpp"
+
+#if defined(MJB_POSIX_API)
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "SysfsThermometer.hpp"
+#include "Testing.hpp"
+
+static Scheduler::Time now = 1000;
+
+Scheduler::Time micros()
+{
+    return now;
+}
+
+// A fake sysfs tree, in a temporary directory removed once done with.
+class Tree
+{
+public:
+
+    std::string path(char const * const name) const
+    {
+        return _root + "/" + name;
+    }
+
+    void write(char const * const name, char const * const contents) const
+    {
+        FILE * const file = std::fopen(path(name).c_str(), "w");
+        std::fputs(contents, file);
+        std::fclose(file);
+    }
+
+    Tree()
+    {
+        char root[] = "/tmp/SysfsThermometerTester.XXXXXX";
+        _root = mkdtemp(root);
+        mkdir(path("hwmon0").c_str(), 0755);
+        mkdir(path("thermal_zone0").c_str(), 0755);
+    }
+
+    ~Tree()
+    {
+        std::system(("rm -rf " + _root).c_str());
+    }
+
+protected:
+
+    std::string _root;
+};
+
+#if defined(MJB_FIXED_POINT_TEMPERATURE)
+// Readings are held to the hundredth of a Kelvin, and of a percent.
+static float const Resolution = 0.01f;
+#else
+static float const Resolution = 0;
+#endif
+
+static bool Near(float const value, float const expected, float const tolerance)
+{
+    return std::fabs(value - expected) < std::max(tolerance, Resolution);
+}
+
+static float Celsius(Thermometer &thermometer)
+{
+    return static_cast<float>(thermometer.sample().temperature.value(Thermometer::TemperatureUnit::Scale::Celsius));
+}
+
+static float Humidity(Thermometer &thermometer)
+{
+    return static_cast<float>(thermometer.sample().humidity);
+}
+
+int main(int argc, const char * argv[])
+{
+    // The following done to suppress unused variable warnings.
+    (void) argc;
+    (void) argv;
+
+    Tree const tree;
+
+    // hwmon reports millidegrees Celsius and thousandths of a percent.
+    tree.write("hwmon0/temp1_input", "23456\n");
+    tree.write("hwmon0/humidity1_input", "45678\n");
+
+    SysfsThermometer hwmon(tree.path("hwmon0/temp1_input").c_str(), tree.path("hwmon0/humidity1_input").c_str());
+    MJB_CHECK(hwmon.available());
+
+    hwmon.snapshot(now);
+    MJB_CHECK(hwmon.health().readings == 1);
+    MJB_CHECK(Near(Celsius(hwmon), 23.456f, 1e-3f));
+    MJB_CHECK(Near(Humidity(hwmon), 45.678f, 1e-3f));
+
+    // Attributes are re-read in place as they change.
+    tree.write("hwmon0/temp1_input", "-12\n");
+    tree.write("hwmon0/humidity1_input", "100000\n");
+    now += 1000000;
+    hwmon.snapshot(now);
+    MJB_CHECK(hwmon.health().readings == 2);
+    MJB_CHECK(Near(Celsius(hwmon), -0.012f, 1e-4f));
+    MJB_CHECK(Near(Humidity(hwmon), 100.0f, 1e-3f));
+
+    // Thermal zones have no humidity; below freezing, values are negative.
+    tree.write("thermal_zone0/temp", "-5250\n");
+
+    SysfsThermometer zone(tree.path("thermal_zone0/temp").c_str());
+    zone.snapshot(now);
+    MJB_CHECK(zone.health().readings == 1);
+    MJB_CHECK(Near(Celsius(zone), -5.25f, 1e-4f));
+    MJB_CHECK(Humidity(zone) == 0);
+
+    // A humidity attribute that isn't there leaves the temperature be read.
+    SysfsThermometer missingHumidity(tree.path("thermal_zone0/temp").c_str(), tree.path("hwmon0/humidity9_input").c_str());
+    missingHumidity.snapshot(now);
+    MJB_CHECK(missingHumidity.health().readings == 1);
+    MJB_CHECK(Near(Celsius(missingHumidity), -5.25f, 1e-4f));
+
+    // Unreadable attributes record no reading, and keep the last values.
+    tree.write("hwmon0/temp1_input", "n/a\n");
+    now += 1000000;
+    hwmon.snapshot(now);
+    MJB_CHECK(hwmon.health().readings == 2);
+    MJB_CHECK(Near(Celsius(hwmon), -0.012f, 1e-4f));
+
+    SysfsThermometer absent(tree.path("hwmon0/temp9_input").c_str());
+    MJB_CHECK(!absent.available());
+
+    // Polling senses every zone at once, counting those newly read.
+    tree.write("hwmon0/temp1_input", "21000\n");
+    now += 1000000;
+
+    SysfsThermometer::Zones const zones = {
+        std::make_shared<SysfsThermometer>(tree.path("hwmon0/temp1_input").c_str()),
+        std::make_shared<SysfsThermometer>(tree.path("thermal_zone0/temp").c_str()),
+        std::make_shared<SysfsThermometer>(tree.path("hwmon0/temp9_input").c_str())
+    };
+    MJB_CHECK(SysfsThermometer::Poll(zones) == 2);
+
+    return Testing::Result("SysfsThermometerTester");
+}
+
+#else
+
+int main()
+{
+    return 0;
+}
+
+#endif
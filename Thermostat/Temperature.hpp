@@ -208,6 +208,16 @@ public:
         // If no match was found, return the value that was given.
         return value;
     }
+
+    // Converts a temperature difference (rather than a temperature) between
+    // scales; Kelvin & Celsius intervals are alike, Fahrenheit's are 1/1.8th.
+    static constexpr NumericType ConvertInterval(NumericType const interval,
+                                                 Scale const scaleInput,
+                                                 Scale const scaleOutput)
+    {
+        return ((scaleInput == Fahrenheit) == (scaleOutput == Fahrenheit))? interval :
+               (scaleInput == Fahrenheit)? NumericType(interval / 1.80) : NumericType(interval * 1.80);
+    }
     
     static Temperature<NumericType> Make(NumericType const value, char const scale)
     {
@@ -246,5 +256,115 @@ protected:
     
 };
 
+// =============================================================================
+// ScaledTemperature : A temperature whose scale is part of its type, rather than
+// a conversion away. Values are held in their own scale, conversions between
+// scales are resolved at compile time, and comparing two temperatures of the
+// same scale is a single compare. Crossing scales, or converting from or to a
+// Temperature, must be done explicitly.
+// =============================================================================
+template<typename NumericType, typename Temperature<NumericType>::Scale TemperatureScale>
+class ScaledTemperature
+{
+public:
+    typedef NumericType value_type;
+    typedef typename Temperature<NumericType>::Scale Scale;
+
+    static constexpr Scale scale = TemperatureScale;
+
+    static constexpr NumericType ToKelvin(NumericType const value)
+    {
+        return (TemperatureScale == Temperature<NumericType>::Kelvin)?  value :
+               (TemperatureScale == Temperature<NumericType>::Celsius)? value + 273.15 :
+                                                                        (value + 40) / 1.80 - 40 + 273.15;
+    }
+
+    static constexpr NumericType FromKelvin(NumericType const value)
+    {
+        return (TemperatureScale == Temperature<NumericType>::Kelvin)?  value :
+               (TemperatureScale == Temperature<NumericType>::Celsius)? value - 273.15 :
+                                                                        (value - 273.15 + 40) * 1.80 - 40;
+    }
+
+    constexpr NumericType value() const
+    {
+        return _value;
+    }
+
+    Temperature<NumericType> temperature() const
+    {
+        return Temperature<NumericType>(ToKelvin(_value)); // Kelvin, as stored.
+    }
+
+    constexpr bool operator==(ScaledTemperature const &other) const
+    {
+        return _value == other._value;
+    }
+
+    constexpr bool operator!=(ScaledTemperature const &other) const
+    {
+        return _value != other._value;
+    }
+
+    constexpr bool operator<(ScaledTemperature const &other) const
+    {
+        return _value < other._value;
+    }
+
+    constexpr bool operator>(ScaledTemperature const &other) const
+    {
+        return _value > other._value;
+    }
+
+    constexpr bool operator<=(ScaledTemperature const &other) const
+    {
+        return _value <= other._value;
+    }
+
+    constexpr bool operator>=(ScaledTemperature const &other) const
+    {
+        return _value >= other._value;
+    }
+
+    // Offsets by an interval in this scale, as in target plus a threshold.
+    constexpr ScaledTemperature operator+(NumericType const interval) const
+    {
+        return ScaledTemperature(_value + interval);
+    }
+
+    constexpr ScaledTemperature operator-(NumericType const interval) const
+    {
+        return ScaledTemperature(_value - interval);
+    }
+
+    constexpr explicit ScaledTemperature(NumericType const value = 0):
+    _value(value)
+    {
+
+    }
+
+    template<typename Temperature<NumericType>::Scale OtherScale>
+    constexpr explicit ScaledTemperature(ScaledTemperature<NumericType, OtherScale> const &other):
+    _value(FromKelvin(ScaledTemperature<NumericType, OtherScale>::ToKelvin(other.value())))
+    {
+
+    }
+
+    // Temperatures are stored as Kelvin, so this takes no runtime conversion.
+    explicit ScaledTemperature(Temperature<NumericType> const &temperature):
+    _value(FromKelvin(temperature.value(Temperature<NumericType>::Kelvin)))
+    {
+
+    }
+
+protected:
+
+    NumericType _value;
+
+};
+
+template<typename NumericType, typename Temperature<NumericType>::Scale TemperatureScale>
+constexpr typename Temperature<NumericType>::Scale ScaledTemperature<NumericType, TemperatureScale>::scale;
+
 #endif /* Temperature_hpp */
 
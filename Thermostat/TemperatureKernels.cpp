@@ -0,0 +1,291 @@
+//
+//  TemperatureKernels.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "TemperatureKernels.hpp"
+
+// ================================================================
+// TemperatureKernels Implementation
+// ================================================================
+void TemperatureKernels::Convert(float const * const values,
+                                 float * const results,
+                                 std::size_t const count,
+                                 TemperatureKernels::TemperatureUnit::Scale const scaleInput,
+                                 TemperatureKernels::TemperatureUnit::Scale const scaleOutput)
+{
+    std::size_t index = 0;
+
+#if defined(MJB_TEMPERATURE_KERNELS_X86)
+    TemperatureKernels::Plan const plan = TemperatureKernels::_Plan(scaleInput, scaleOutput);
+
+    index = TemperatureKernels::_AVX2()? TemperatureKernels::_ConvertAVX2(values, results, count, plan) :
+                                         TemperatureKernels::_ConvertSSE2(values, results, count, plan);
+#endif
+
+    for (; index < count; index++)
+    {
+        results[index] = TemperatureKernels::Convert(values[index], scaleInput, scaleOutput);
+    }
+}
+
+void TemperatureKernels::Humiture(float const * const temperatures,
+                                  float const * const humidities,
+                                  float * const humitures,
+                                  std::size_t const count)
+{
+    std::size_t index = 0;
+
+#if defined(MJB_TEMPERATURE_KERNELS_X86)
+    index = TemperatureKernels::_AVX2()? TemperatureKernels::_HumitureAVX2(temperatures, humidities, humitures, count) :
+                                         TemperatureKernels::_HumitureSSE2(temperatures, humidities, humitures, count);
+#endif
+
+    for (; index < count; index++)
+    {
+        humitures[index] = TemperatureKernels::Humiture(temperatures[index], humidities[index]);
+    }
+}
+
+float TemperatureKernels::Convert(float const value,
+                                  TemperatureKernels::TemperatureUnit::Scale const scaleInput,
+                                  TemperatureKernels::TemperatureUnit::Scale const scaleOutput)
+{
+    return TemperatureKernels::TemperatureUnit::Convert(value, scaleInput, scaleOutput);
+}
+
+float TemperatureKernels::Humiture(float const temperature, float const humidity)
+{
+    // NOTE: This must be kept identical to Thermometer::Humiture's float path.
+    float const t = TemperatureKernels::TemperatureUnit(temperature).value(TemperatureKernels::TemperatureUnit::Scale::Fahrenheit);
+    float const h = humidity / 100;
+    float const tt = t * t;
+    float const hh = h * h;
+    float const th = t * h;
+
+    if ((t < 70) || (t > 115) || (h < 0) || (h > 0.80)) return temperature;
+
+    return TemperatureKernels::TemperatureUnit(0.363445176f +
+                                               0.988622465f * t +
+                                               4.777114035f * h +
+                                              -0.114037667f * th +
+                                              -0.000850208f * tt +
+                                              -0.020716198f * hh +
+                                               0.000687678f * t * th +
+                                               0.000274954f * th * h,
+                                               TemperatureKernels::TemperatureUnit::Scale::Fahrenheit).value();
+}
+
+TemperatureKernels::Plan TemperatureKernels::_Plan(TemperatureKernels::TemperatureUnit::Scale const scaleInput,
+                                                   TemperatureKernels::TemperatureUnit::Scale const scaleOutput)
+{
+    typedef TemperatureKernels::TemperatureUnit::Scale Scale;
+
+    // Mirrors the paths taken by TemperatureUnit::Convert, step by step.
+    TemperatureKernels::Plan plan = {{Offset, Offset}, {0, 0}, 0};
+
+    if ((scaleInput == Scale::Celsius) && (scaleOutput == Scale::Fahrenheit)) {
+        plan = {{CelsiusToFahrenheit, Offset}, {0, 0}, 1};
+    } else
+    if ((scaleInput == Scale::Celsius) && (scaleOutput == Scale::Kelvin)) {
+        plan = {{Offset, Offset}, {273.15, 0}, 1};
+    } else
+    if ((scaleInput == Scale::Fahrenheit) && (scaleOutput == Scale::Celsius)) {
+        plan = {{FahrenheitToCelsius, Offset}, {0, 0}, 1};
+    } else
+    if ((scaleInput == Scale::Fahrenheit) && (scaleOutput == Scale::Kelvin)) {
+        plan = {{FahrenheitToCelsius, Offset}, {0, 273.15}, 2};
+    } else
+    if ((scaleInput == Scale::Kelvin) && (scaleOutput == Scale::Celsius)) {
+        plan = {{Offset, Offset}, {-273.15, 0}, 1};
+    } else
+    if ((scaleInput == Scale::Kelvin) && (scaleOutput == Scale::Fahrenheit)) {
+        plan = {{Offset, CelsiusToFahrenheit}, {-273.15, 0}, 2};
+    }
+
+    return plan;
+}
+
+#if defined(MJB_TEMPERATURE_KERNELS_X86)
+bool TemperatureKernels::_AVX2()
+{
+    static bool const available = __builtin_cpu_supports("avx2");
+    return available;
+}
+
+// ================================================================
+// TemperatureKernels SSE2 Implementation
+// ================================================================
+__m128d TemperatureKernels::_Step(__m128d const values, TemperatureKernels::Step const step, double const offset)
+{
+    switch (step)
+    {
+        case CelsiusToFahrenheit:
+            return _mm_sub_pd(_mm_mul_pd(values, _mm_set1_pd(1.80)), _mm_set1_pd(40));
+
+        case FahrenheitToCelsius:
+            return _mm_sub_pd(_mm_div_pd(values, _mm_set1_pd(1.80)), _mm_set1_pd(40));
+
+        default:
+            return _mm_add_pd(values, _mm_set1_pd(offset));
+    }
+}
+
+__m128 TemperatureKernels::_Apply(__m128 values, TemperatureKernels::Plan const &plan)
+{
+    for (std::size_t step = 0; step < plan.count; step++)
+    {
+        // NOTE: Convert adds 40 to Fahrenheit/Celsius in float, not double.
+        if (plan.steps[step] != Offset) values = _mm_add_ps(values, _mm_set1_ps(40));
+
+        // Widen to double, as Convert's double literals do, then round back.
+        __m128d const low = _Step(_mm_cvtps_pd(values), plan.steps[step], plan.offsets[step]);
+        __m128d const high = _Step(_mm_cvtps_pd(_mm_movehl_ps(values, values)), plan.steps[step], plan.offsets[step]);
+        values = _mm_movelh_ps(_mm_cvtpd_ps(low), _mm_cvtpd_ps(high));
+    }
+    return values;
+}
+
+__m128 TemperatureKernels::_Humiture(__m128 const temperatures, __m128 const humidities)
+{
+    static TemperatureKernels::Plan const toFahrenheit = _Plan(TemperatureUnit::Scale::Kelvin, TemperatureUnit::Scale::Fahrenheit);
+    static TemperatureKernels::Plan const toKelvin = _Plan(TemperatureUnit::Scale::Fahrenheit, TemperatureUnit::Scale::Kelvin);
+
+    __m128 const t = _Apply(temperatures, toFahrenheit);
+    __m128 const h = _mm_div_ps(humidities, _mm_set1_ps(100));
+    __m128 const tt = _mm_mul_ps(t, t);
+    __m128 const hh = _mm_mul_ps(h, h);
+    __m128 const th = _mm_mul_ps(t, h);
+
+    // NOTE: No float lies between 0.80 and 0.80f, so h > 0.80 is h >= 0.80f.
+    __m128 const outside = _mm_or_ps(_mm_or_ps(_mm_cmplt_ps(t, _mm_set1_ps(70)), _mm_cmpgt_ps(t, _mm_set1_ps(115))),
+                                     _mm_or_ps(_mm_cmplt_ps(h, _mm_setzero_ps()), _mm_cmpge_ps(h, _mm_set1_ps(0.80f))));
+
+    // Accumulate in the scalar expression's order, so roundings are alike.
+    __m128 index = _mm_add_ps(_mm_set1_ps(0.363445176f), _mm_mul_ps(_mm_set1_ps(0.988622465f), t));
+    index = _mm_add_ps(index, _mm_mul_ps(_mm_set1_ps(4.777114035f), h));
+    index = _mm_add_ps(index, _mm_mul_ps(_mm_set1_ps(-0.114037667f), th));
+    index = _mm_add_ps(index, _mm_mul_ps(_mm_set1_ps(-0.000850208f), tt));
+    index = _mm_add_ps(index, _mm_mul_ps(_mm_set1_ps(-0.020716198f), hh));
+    index = _mm_add_ps(index, _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.000687678f), t), th));
+    index = _mm_add_ps(index, _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.000274954f), th), h));
+    index = _Apply(index, toKelvin);
+
+    return _mm_or_ps(_mm_and_ps(outside, temperatures), _mm_andnot_ps(outside, index));
+}
+
+std::size_t TemperatureKernels::_ConvertSSE2(float const * const values, float * const results,
+                                             std::size_t const count, TemperatureKernels::Plan const &plan)
+{
+    std::size_t index = 0;
+    for (; (index + 4) <= count; index += 4)
+    {
+        _mm_storeu_ps(results + index, _Apply(_mm_loadu_ps(values + index), plan));
+    }
+    return index;
+}
+
+std::size_t TemperatureKernels::_HumitureSSE2(float const * const temperatures, float const * const humidities,
+                                              float * const humitures, std::size_t const count)
+{
+    std::size_t index = 0;
+    for (; (index + 4) <= count; index += 4)
+    {
+        _mm_storeu_ps(humitures + index, _Humiture(_mm_loadu_ps(temperatures + index),
+                                                   _mm_loadu_ps(humidities + index)));
+    }
+    return index;
+}
+
+// ================================================================
+// TemperatureKernels AVX2 Implementation
+// ================================================================
+// NOTE: FMA is deliberately left disabled; fused operations round once
+// rather than twice, which would break equality with the scalar code.
+__attribute__((target("avx2")))
+__m256d TemperatureKernels::_Step(__m256d const values, TemperatureKernels::Step const step, double const offset)
+{
+    switch (step)
+    {
+        case CelsiusToFahrenheit:
+            return _mm256_sub_pd(_mm256_mul_pd(values, _mm256_set1_pd(1.80)), _mm256_set1_pd(40));
+
+        case FahrenheitToCelsius:
+            return _mm256_sub_pd(_mm256_div_pd(values, _mm256_set1_pd(1.80)), _mm256_set1_pd(40));
+
+        default:
+            return _mm256_add_pd(values, _mm256_set1_pd(offset));
+    }
+}
+
+__attribute__((target("avx2")))
+__m256 TemperatureKernels::_Apply(__m256 values, TemperatureKernels::Plan const &plan)
+{
+    for (std::size_t step = 0; step < plan.count; step++)
+    {
+        if (plan.steps[step] != Offset) values = _mm256_add_ps(values, _mm256_set1_ps(40));
+
+        __m256d const low = _Step(_mm256_cvtps_pd(_mm256_castps256_ps128(values)), plan.steps[step], plan.offsets[step]);
+        __m256d const high = _Step(_mm256_cvtps_pd(_mm256_extractf128_ps(values, 1)), plan.steps[step], plan.offsets[step]);
+        values = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(low)), _mm256_cvtpd_ps(high), 1);
+    }
+    return values;
+}
+
+__attribute__((target("avx2")))
+__m256 TemperatureKernels::_Humiture(__m256 const temperatures, __m256 const humidities)
+{
+    static TemperatureKernels::Plan const toFahrenheit = _Plan(TemperatureUnit::Scale::Kelvin, TemperatureUnit::Scale::Fahrenheit);
+    static TemperatureKernels::Plan const toKelvin = _Plan(TemperatureUnit::Scale::Fahrenheit, TemperatureUnit::Scale::Kelvin);
+
+    __m256 const t = _Apply(temperatures, toFahrenheit);
+    __m256 const h = _mm256_div_ps(humidities, _mm256_set1_ps(100));
+    __m256 const tt = _mm256_mul_ps(t, t);
+    __m256 const hh = _mm256_mul_ps(h, h);
+    __m256 const th = _mm256_mul_ps(t, h);
+
+    __m256 const outside = _mm256_or_ps(_mm256_or_ps(_mm256_cmp_ps(t, _mm256_set1_ps(70), _CMP_LT_OQ),
+                                                     _mm256_cmp_ps(t, _mm256_set1_ps(115), _CMP_GT_OQ)),
+                                        _mm256_or_ps(_mm256_cmp_ps(h, _mm256_setzero_ps(), _CMP_LT_OQ),
+                                                     _mm256_cmp_ps(h, _mm256_set1_ps(0.80f), _CMP_GE_OQ)));
+
+    __m256 index = _mm256_add_ps(_mm256_set1_ps(0.363445176f), _mm256_mul_ps(_mm256_set1_ps(0.988622465f), t));
+    index = _mm256_add_ps(index, _mm256_mul_ps(_mm256_set1_ps(4.777114035f), h));
+    index = _mm256_add_ps(index, _mm256_mul_ps(_mm256_set1_ps(-0.114037667f), th));
+    index = _mm256_add_ps(index, _mm256_mul_ps(_mm256_set1_ps(-0.000850208f), tt));
+    index = _mm256_add_ps(index, _mm256_mul_ps(_mm256_set1_ps(-0.020716198f), hh));
+    index = _mm256_add_ps(index, _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.000687678f), t), th));
+    index = _mm256_add_ps(index, _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.000274954f), th), h));
+    index = _Apply(index, toKelvin);
+
+    return _mm256_blendv_ps(index, temperatures, outside);
+}
+
+__attribute__((target("avx2")))
+std::size_t TemperatureKernels::_ConvertAVX2(float const * const values, float * const results,
+                                             std::size_t const count, TemperatureKernels::Plan const &plan)
+{
+    std::size_t index = 0;
+    for (; (index + 8) <= count; index += 8)
+    {
+        _mm256_storeu_ps(results + index, _Apply(_mm256_loadu_ps(values + index), plan));
+    }
+    return index;
+}
+
+__attribute__((target("avx2")))
+std::size_t TemperatureKernels::_HumitureAVX2(float const * const temperatures, float const * const humidities,
+                                              float * const humitures, std::size_t const count)
+{
+    std::size_t index = 0;
+    for (; (index + 8) <= count; index += 8)
+    {
+        _mm256_storeu_ps(humitures + index, _Humiture(_mm256_loadu_ps(temperatures + index),
+                                                      _mm256_loadu_ps(humidities + index)));
+    }
+    return index;
+}
+#endif
@@ -0,0 +1,106 @@
+//
+//  TemperatureKernels.hpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef TemperatureKernels_hpp
+#define TemperatureKernels_hpp
+
+#include <cstddef>
+#include "Development.hpp"
+#include "Temperature.hpp"
+
+#if defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define MJB_TEMPERATURE_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+// =============================================================================
+// TemperatureKernels : This class applies the temperature math of Temperature
+// and Thermometer to whole buffers at once, as when processing recorded
+// telemetry offline. Buffers are plain float arrays (a struct-of-arrays), and
+// results match the scalar code bit for bit; x86 hosts use SSE2, or AVX2 when
+// the processor supports it, while other targets use the scalar code itself.
+// Results may be written over the inputs they're computed from.
+// =============================================================================
+class TemperatureKernels
+{
+public:
+    typedef Temperature<float> TemperatureUnit;
+
+    // Converts count values between scales, as TemperatureUnit::Convert does.
+    static void Convert(float const * const values,
+                        float * const results,
+                        std::size_t const count,
+                        TemperatureUnit::Scale const scaleInput,
+                        TemperatureUnit::Scale const scaleOutput);
+
+    // Computes the heat index of count samples, as Thermometer::Humiture does,
+    // including its fallback to the dry-bulb temperature outside of the range
+    // the formula covers. Temperatures are Kelvin, humidities are percentages.
+    static void Humiture(float const * const temperatures,
+                         float const * const humidities,
+                         float * const humitures,
+                         std::size_t const count);
+
+    // Scalar versions of the above, for a single value.
+    static float Convert(float const value,
+                         TemperatureUnit::Scale const scaleInput,
+                         TemperatureUnit::Scale const scaleOutput);
+    static float Humiture(float const temperature, float const humidity);
+
+protected:
+
+    // Conversions are made of up to two steps, each rounded back to float, as
+    // TemperatureUnit::Convert's are. Scale changes add 40 in float, then scale
+    // and subtract 40 in double; the 40 isn't part of the Step's computation.
+    enum Step
+    {
+        Offset,                 // Adds the step's offset (Celsius & Kelvin).
+        CelsiusToFahrenheit,
+        FahrenheitToCelsius
+    };
+
+    struct Plan
+    {
+        Step steps[2];
+        double offsets[2];
+        std::size_t count;
+    };
+
+    static Plan _Plan(TemperatureUnit::Scale const scaleInput,
+                      TemperatureUnit::Scale const scaleOutput);
+
+#if defined(MJB_TEMPERATURE_KERNELS_X86)
+    static __m128d _Step(__m128d const values, Step const step, double const offset);
+    static __m128 _Apply(__m128 const values, Plan const &plan);
+    static __m128 _Humiture(__m128 const temperatures, __m128 const humidities);
+
+    __attribute__((target("avx2")))
+    static __m256d _Step(__m256d const values, Step const step, double const offset);
+    __attribute__((target("avx2")))
+    static __m256 _Apply(__m256 const values, Plan const &plan);
+    __attribute__((target("avx2")))
+    static __m256 _Humiture(__m256 const temperatures, __m256 const humidities);
+
+    // Process as many values as fit in whole vectors, returning that count.
+    static std::size_t _ConvertSSE2(float const * const values, float * const results,
+                                    std::size_t const count, Plan const &plan);
+    static std::size_t _HumitureSSE2(float const * const temperatures, float const * const humidities,
+                                     float * const humitures, std::size_t const count);
+
+    __attribute__((target("avx2")))
+    static std::size_t _ConvertAVX2(float const * const values, float * const results,
+                                    std::size_t const count, Plan const &plan);
+    __attribute__((target("avx2")))
+    static std::size_t _HumitureAVX2(float const * const temperatures, float const * const humidities,
+                                     float * const humitures, std::size_t const count);
+
+    static bool _AVX2();
+#endif
+};
+
+#endif /* TemperatureKernels_hpp */
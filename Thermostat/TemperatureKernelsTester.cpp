@@ -0,0 +1,231 @@
+//
+//  TemperatureKernelsTester.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "Development.hpp"
+
+#if ! defined(MJB_ARDUINO_LIB_API)
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "TemperatureKernels.hpp"
+#include "Thermometer.hpp"
+#include "Testing.hpp"
+
+Scheduler::Time micros()
+{
+    return 0;
+}
+
+typedef TemperatureKernels::TemperatureUnit TemperatureUnit;
+
+// Exposes the vector paths, so that each is checked whichever the host runs.
+struct Kernels : TemperatureKernels
+{
+#if defined(MJB_TEMPERATURE_KERNELS_X86)
+    using TemperatureKernels::Plan;
+    using TemperatureKernels::_Plan;
+    using TemperatureKernels::_ConvertSSE2;
+    using TemperatureKernels::_HumitureSSE2;
+    using TemperatureKernels::_ConvertAVX2;
+    using TemperatureKernels::_HumitureAVX2;
+    using TemperatureKernels::_AVX2;
+#endif
+};
+
+static TemperatureUnit::Scale const Scales[] = {
+    TemperatureUnit::Scale::Celsius,
+    TemperatureUnit::Scale::Fahrenheit,
+    TemperatureUnit::Scale::Kelvin
+};
+
+static bool Identical(std::vector<float> const &a, std::vector<float> const &b)
+{
+    return (a.size() == b.size()) && !std::memcmp(a.data(), b.data(), a.size() * sizeof(float));
+}
+
+int main(int argc, const char * argv[])
+{
+    std::mt19937 random(37);
+
+    // Odd sized, so that every path's tail is covered; the range spans the
+    // heat index formula's, and beyond it, in every scale.
+    std::size_t const count = 4099;
+    std::vector<float> values(count), humidities(count);
+    std::uniform_real_distribution<float> temperature(230, 340);
+    std::uniform_real_distribution<float> humidity(-5, 105);
+    for (std::size_t index = 0; index < count; index++)
+    {
+        values[index] = temperature(random);
+        humidities[index] = humidity(random);
+    }
+
+    // Conversions match TemperatureUnit::Convert's, bit for bit.
+    for (TemperatureUnit::Scale const input : Scales)
+    {
+        for (TemperatureUnit::Scale const output : Scales)
+        {
+            std::vector<float> expected(count), results(count);
+            for (std::size_t index = 0; index < count; index++)
+            {
+                expected[index] = TemperatureUnit::Convert(values[index], input, output);
+            }
+
+            TemperatureKernels::Convert(values.data(), results.data(), count, input, output);
+            MJB_CHECK(Identical(results, expected));
+
+            // In place, as well.
+            results = values;
+            TemperatureKernels::Convert(results.data(), results.data(), count, input, output);
+            MJB_CHECK(Identical(results, expected));
+
+#if defined(MJB_TEMPERATURE_KERNELS_X86)
+            Kernels::Plan const plan = Kernels::_Plan(input, output);
+
+            results = expected;
+            std::size_t const vectorized = Kernels::_ConvertSSE2(values.data(), results.data(), count, plan);
+            MJB_CHECK(vectorized && Identical(results, expected));
+
+            if (Kernels::_AVX2())
+            {
+                results = expected;
+                std::size_t const vectorized = Kernels::_ConvertAVX2(values.data(), results.data(), count, plan);
+                MJB_CHECK(vectorized && Identical(results, expected));
+            }
+#endif
+        }
+    }
+
+    std::vector<float> expected(count), results(count);
+    TemperatureKernels::Humiture(values.data(), humidities.data(), results.data(), count);
+
+#if defined(MJB_FIXED_POINT_TEMPERATURE)
+    // Heat indices match Thermometer::Humiture's, integer only here, to within
+    // its rounding; readings it rounds across the formula's bounds are left
+    // out, their heat indices being the temperature on one side only.
+    double deviation = 0;
+    for (std::size_t index = 0; index < count; index++)
+    {
+        float const fahrenheit = TemperatureUnit::Convert(values[index], TemperatureUnit::Scale::Kelvin,
+                                                          TemperatureUnit::Scale::Fahrenheit);
+        if ((std::fabs(fahrenheit - 70) < 0.01f) || (std::fabs(fahrenheit - 115) < 0.01f) ||
+            (std::fabs(humidities[index]) < 0.01f) || (std::fabs(humidities[index] - 80) < 0.01f)) continue;
+
+        Thermometer::TemperatureUnit const dryBulb(values[index], Thermometer::TemperatureUnit::Scale::Kelvin);
+        float const humiture = static_cast<float>(Thermometer::Humiture(dryBulb, humidities[index]).value());
+        deviation = std::max<double>(deviation, std::fabs(humiture - results[index]));
+    }
+    MJB_CHECK(deviation < 0.02);
+
+    // The vector paths match the scalar one's, bit for bit.
+    expected = results;
+#else
+    // Heat indices match Thermometer::Humiture's, bit for bit.
+    for (std::size_t index = 0; index < count; index++)
+    {
+        TemperatureUnit const dryBulb(values[index], TemperatureUnit::Scale::Kelvin);
+        expected[index] = Thermometer::Humiture(dryBulb, humidities[index]).value(TemperatureUnit::Scale::Kelvin);
+    }
+
+    MJB_CHECK(Identical(results, expected));
+#endif
+
+#if defined(MJB_TEMPERATURE_KERNELS_X86)
+    results = expected;
+    MJB_CHECK(Kernels::_HumitureSSE2(values.data(), humidities.data(), results.data(), count));
+    MJB_CHECK(Identical(results, expected));
+
+    if (Kernels::_AVX2())
+    {
+        results = expected;
+        MJB_CHECK(Kernels::_HumitureAVX2(values.data(), humidities.data(), results.data(), count));
+        MJB_CHECK(Identical(results, expected));
+    }
+#endif
+
+    if (Testing::Benchmarking(argc, argv))
+    {
+        std::size_t const samples = 1 << 16;
+        std::size_t const rounds = 1000;
+        std::vector<float> temperatures(samples), relatives(samples), outputs(samples);
+        for (std::size_t index = 0; index < samples; index++)
+        {
+            temperatures[index] = temperature(random);
+            relatives[index] = humidity(random);
+        }
+
+        float checksum = 0;
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (std::size_t round = 0; round < rounds; round++)
+        {
+            for (std::size_t index = 0; index < samples; index++)
+            {
+                outputs[index] = TemperatureKernels::Humiture(temperatures[index], relatives[index]);
+            }
+            checksum += outputs[round % samples];
+        }
+        double const scalar = Testing::Seconds(start);
+
+        start = std::chrono::steady_clock::now();
+        for (std::size_t round = 0; round < rounds; round++)
+        {
+            TemperatureKernels::Humiture(temperatures.data(), relatives.data(), outputs.data(), samples);
+            checksum += outputs[round % samples];
+        }
+        double const vectorized = Testing::Seconds(start);
+
+        std::fprintf(stderr, "TemperatureKernels::Humiture: %.0fM samples/s scalar, %.0fM samples/s batched (%.1fx; %g)\n",
+                     (rounds * samples) / scalar / 1e6,
+                     (rounds * samples) / vectorized / 1e6,
+                     scalar / vectorized,
+                     checksum);
+
+        start = std::chrono::steady_clock::now();
+        for (std::size_t round = 0; round < rounds; round++)
+        {
+            for (std::size_t index = 0; index < samples; index++)
+            {
+                outputs[index] = TemperatureKernels::Convert(temperatures[index],
+                                                             TemperatureUnit::Scale::Kelvin,
+                                                             TemperatureUnit::Scale::Fahrenheit);
+            }
+            checksum += outputs[round % samples];
+        }
+        double const scalarConversions = Testing::Seconds(start);
+
+        start = std::chrono::steady_clock::now();
+        for (std::size_t round = 0; round < rounds; round++)
+        {
+            TemperatureKernels::Convert(temperatures.data(), outputs.data(), samples,
+                                        TemperatureUnit::Scale::Kelvin,
+                                        TemperatureUnit::Scale::Fahrenheit);
+            checksum += outputs[round % samples];
+        }
+        double const vectorizedConversions = Testing::Seconds(start);
+
+        std::fprintf(stderr, "TemperatureKernels::Convert: %.0fM samples/s scalar, %.0fM samples/s batched (%.1fx; %g)\n",
+                     (rounds * samples) / scalarConversions / 1e6,
+                     (rounds * samples) / vectorizedConversions / 1e6,
+                     scalarConversions / vectorizedConversions,
+                     checksum);
+    }
+
+    return Testing::Result("TemperatureKernelsTester");
+}
+
+#else
+
+int main()
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,124 @@
+//
+//  TemperatureTester.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "Development.hpp"
+
+#if ! defined(MJB_ARDUINO_LIB_API)
+
+#include <random>
+#include <vector>
+#include "Temperature.hpp"
+#include "FixedPoint.hpp"
+#include "Testing.hpp"
+
+template<typename NumericType>
+constexpr bool Near(NumericType const value, double const expected, double const tolerance = 0.0001)
+{
+    return ((static_cast<double>(value) - expected) <= tolerance) && ((expected - static_cast<double>(value)) <= tolerance);
+}
+
+// Conversions of intervals, and between scales of scaled temperatures, are
+// resolved at compile time, for floats and fixed point numbers alike.
+typedef Temperature<float> Float;
+typedef Temperature<FixedPoint> Fixed;
+
+static_assert(Float::ConvertInterval(1, Float::Celsius, Float::Kelvin) == 1, "Celsius and Kelvin intervals are alike.");
+static_assert(Near(Float::ConvertInterval(1.8f, Float::Fahrenheit, Float::Kelvin), 1), "Fahrenheit intervals are 1/1.8th.");
+static_assert(Near(Float::ConvertInterval(1, Float::Celsius, Float::Fahrenheit), 1.8), "Fahrenheit intervals are 1/1.8th.");
+static_assert(Fixed::ConvertInterval(FixedPoint(1.8), Fixed::Fahrenheit, Fixed::Kelvin) == FixedPoint(1), "Fixed point intervals convert exactly.");
+static_assert(Fixed::ConvertInterval(FixedPoint(0.5), Fixed::Kelvin, Fixed::Fahrenheit) == FixedPoint(0.9), "Fixed point intervals convert exactly.");
+
+typedef ScaledTemperature<float, Float::Kelvin> FloatKelvin;
+typedef ScaledTemperature<float, Float::Celsius> FloatCelsius;
+typedef ScaledTemperature<float, Float::Fahrenheit> FloatFahrenheit;
+typedef ScaledTemperature<FixedPoint, Fixed::Kelvin> FixedKelvin;
+typedef ScaledTemperature<FixedPoint, Fixed::Fahrenheit> FixedFahrenheit;
+
+static_assert(Near(FloatCelsius::ToKelvin(0), 273.15), "Water freezes at 273.15K.");
+static_assert(Near(FloatFahrenheit::ToKelvin(32), 273.15, 0.001), "Water freezes at 32F.");
+static_assert(Near(FloatFahrenheit::FromKelvin(373.15f), 212, 0.001), "Water boils at 212F.");
+static_assert(Near(FloatFahrenheit(FloatCelsius(100)).value(), 212, 0.001), "Crossing scales converts.");
+static_assert(Near(FloatKelvin(FloatCelsius(-40)).value(), 233.15, 0.001), "Crossing scales converts.");
+static_assert(FloatKelvin(300) > FloatKelvin(290) && ((FloatKelvin(290) + 0.5f) < FloatKelvin(291)), "Same scales compare as is.");
+static_assert(FixedKelvin(FixedFahrenheit(FixedPoint(32))).value() == FixedPoint(273.15), "Fixed point scales convert exactly.");
+static_assert(FixedFahrenheit::FromKelvin(FixedPoint(373.15)) == FixedPoint(212), "Fixed point scales convert exactly.");
+
+int main(int argc, const char * argv[])
+{
+    std::mt19937 random(35);
+    unsigned mismatches = 0;
+
+    // At runtime, scaled temperatures agree with Temperature's conversions,
+    // and intervals with the difference of the temperatures bounding them.
+    for (std::size_t index = 0; index < 100000; index++)
+    {
+        float const fahrenheit = -40.0f + ((random() % 20000) / 100.0f);
+        float const interval = (random() % 1000) / 100.0f;
+
+        Float const temperature(fahrenheit, Float::Fahrenheit);
+        float const kelvin = temperature.value();
+
+        if (!Near(FloatKelvin(FloatFahrenheit(fahrenheit)).value(), kelvin, 0.001)) mismatches++;
+        if (!Near(FloatFahrenheit(temperature).value(), fahrenheit, 0.001)) mismatches++;
+        if (!Near(FloatCelsius(temperature).value(), temperature.value(Float::Celsius), 0.001)) mismatches++;
+
+        float const difference = Float::Convert(fahrenheit + interval, Float::Fahrenheit, Float::Kelvin) - kelvin;
+        if (!Near(Float::ConvertInterval(interval, Float::Fahrenheit, Float::Kelvin), difference, 0.001)) mismatches++;
+    }
+
+    MJB_CHECK(!mismatches);
+
+    // A threshold comparison in Fahrenheit, converting both temperatures as
+    // Temperature does, against one in Kelvin, as ScaledTemperature does.
+    if (Testing::Benchmarking(argc, argv))
+    {
+        std::vector<Float> temperatures;
+        std::vector<FloatKelvin> kelvins;
+        for (std::size_t index = 0; index < 4096; index++)
+        {
+            temperatures.push_back(Float(-40.005f + ((random() % 20000) / 100.0f), Float::Fahrenheit));
+            kelvins.push_back(FloatKelvin(temperatures.back()));
+        }
+
+        std::size_t const comparisons = 100000000;
+        Float const target(70, Float::Fahrenheit);
+        FloatKelvin const kelvinTarget(target);
+        float const threshold = 1;
+        float const kelvinThreshold = Float::ConvertInterval(threshold, Float::Fahrenheit, Float::Kelvin);
+        std::size_t converted = 0, scaled = 0;
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (std::size_t index = 0; index < comparisons; index++)
+        {
+            converted += temperatures[index % 4096].value(Float::Fahrenheit) < (target.value(Float::Fahrenheit) - threshold);
+        }
+        double const conversions = Testing::Seconds(start);
+
+        start = std::chrono::steady_clock::now();
+        for (std::size_t index = 0; index < comparisons; index++)
+        {
+            scaled += kelvins[index % 4096] < (kelvinTarget - kelvinThreshold);
+        }
+        double const compares = Testing::Seconds(start);
+
+        MJB_CHECK(converted == scaled);
+        std::fprintf(stderr, "Temperature::value(Fahrenheit) compare: %.2f ns, ScaledTemperature compare: %.2f ns\n",
+                     conversions * 1e9 / comparisons, compares * 1e9 / comparisons);
+    }
+
+    return Testing::Result("TemperatureTester");
+}
+
+#else
+
+int main()
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,58 @@
+//
+//  Testing.hpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef Testing_hpp
+#define Testing_hpp
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include "Development.hpp"
+
+// =============================================================================
+// Testing : The little the host testers (the *Tester.cpp programs beside
+// Tester.cpp) share. Checks report their failures as they happen, and each
+// tester's exit status is the outcome; testers run their benchmarks only when
+// passed "benchmark", so that `make test` stays quick.
+// =============================================================================
+namespace Testing
+{
+    inline unsigned &Failures()
+    {
+        static unsigned failures = 0;
+        return failures;
+    }
+
+    inline void Check(bool const passed, char const * const what, char const * const file, int const line)
+    {
+        if (passed) return;
+        std::fprintf(stderr, "%s:%d: FAILED: %s\n", file, line, what);
+        Failures()++;
+    }
+
+    inline bool Benchmarking(int const argc, char const * const argv[])
+    {
+        return (argc > 1) && !std::strcmp(argv[1], "benchmark");
+    }
+
+    inline double Seconds(std::chrono::steady_clock::time_point const start)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Reports the tester's outcome, returning its exit status.
+    inline int Result(char const * const tester)
+    {
+        std::fprintf(stderr, "%s: %s (%u failed)\n", tester, Failures()? "FAILED" : "passed", Failures());
+        return Failures()? 1 : 0;
+    }
+}
+
+#define MJB_CHECK(condition) Testing::Check((condition), #condition, __FILE__, __LINE__)
+
+#endif /* Testing_hpp */
@@ -20,11 +20,117 @@ Thermometer::TemperatureUnit Thermometer::temperature()
 Thermometer::TemperatureUnit Thermometer::humiture()
 {
     sense(); // Attempt to get new sensory data.
-    
+    return Thermometer::Humiture(_temperature, _humidity);
+}
+
+Thermometer::TemperatureUnit::value_type Thermometer::humidity()
+{
+    sense(); // Attempt to get new sensory data.
+    return _humidity;
+}
+
+Thermometer::Sample const &Thermometer::snapshot(Scheduler::Time const time)
+{
+    sense(); // Attempt to get new sensory data, only once.
+    return collect(time);
+}
+
+Thermometer::Sample const &Thermometer::sample() const
+{
+    return _sample;
+}
+
+void Thermometer::request()
+{
+    sense(); // Attempt to get new sensory data.
+}
+
+bool Thermometer::pending() const
+{
+    return false;
+}
+
+Thermometer::Sample const &Thermometer::collect(Scheduler::Time const time)
+{
+    _sample.temperature = _temperature;
+    _sample.humidity = _humidity;
+    _sample.humiture = Thermometer::Humiture(_temperature, _humidity);
+    _sample.sequence++;
+    _sample.time = time;
+    _sample.stale = (health().readings == _sampleReadings);
+
+    // Only new readings are filtered, lest stale ones outweigh the rest.
+    if (!_sample.stale)
+        _sample.smoothed = Thermometer::TemperatureUnit(_temperatureFilter.update(_temperature.value()));
+
+    _sampleReadings = health().readings;
+
+    _delegate([this](std::shared_ptr<ThermometerDelegate> const &delegate) -> bool {
+        delegate->thermometerSampled(this, _sample);
+        return true;
+    });
+
+    return _sample;
+}
+
+Scheduler::Time Thermometer::samplingInterval() const
+{
+    return _sampler.executeTimeInterval();
+}
+
+void Thermometer::setSamplingInterval(Scheduler::Time const samplingInterval)
+{
+    _sampler.setExecuteTimeInterval(samplingInterval);
+
+    if (!samplingInterval)
+    {
+        _sampler.unschedule();
+        return;
+    }
+
+    // If already sampling, the new interval applies from the next sample on.
+    _sampler.start(micros());
+}
+
+Thermometer::TemperatureFilter const &Thermometer::temperatureFilter() const
+{
+    return _temperatureFilter;
+}
+
+Thermometer::Range Thermometer::range() const
+{
+    return _range;
+}
+
+Thermometer::TemperatureUnit Thermometer::Humiture(Thermometer::TemperatureUnit const &temperature,
+                                                   Thermometer::TemperatureUnit::value_type const humidity)
+{
     // Returns the heat index, aka, the "feels like" temperature.
     // Heat Index is determined by Rothfusz Steadman's equation.
-    Thermometer::TemperatureUnit::value_type const t = temperature().value(Thermometer::TemperatureUnit::Scale::Fahrenheit);
-    Thermometer::TemperatureUnit::value_type const h = humidity() / 100;
+#if defined(MJB_FIXED_POINT_TEMPERATURE)
+    // Integer evaluation of the polynomial below, with t in hundredths of a
+    // degree Fahrenheit, h in ten thousandths, and coefficients scaled by 1e9,
+    // accumulating hundredths of a degree scaled by 1e9 (well within 64 bits).
+    int64_t const t = temperature.value(Thermometer::TemperatureUnit::Scale::Fahrenheit).raw();
+    int64_t const h = humidity.raw() * 100 / FixedPoint::Scale;
+
+    if ((t < 7000) || (t > 11500) || (h < 0) || (h > 8000))
+        return Thermometer::TemperatureUnit(temperature);
+
+    int64_t const heatIndex =   363445176LL * 100 +
+                                988622465LL * t +
+                               4777114035LL * h / 100 +
+                               -114037667LL * t * h / 10000 +
+                                  -850208LL * t * t / 100 +
+                                -20716198LL * h * h / 1000000 +
+                                   687678LL * t * t * h / 1000000 +
+                                   274954LL * t * h * h / 100000000;
+
+    return Thermometer::TemperatureUnit(FixedPoint::FromRaw(static_cast<FixedPoint::Raw>(FixedPoint::Divide(heatIndex, 1000000000))),
+                                        Thermometer::TemperatureUnit::Scale::Fahrenheit);
+#else
+    Thermometer::TemperatureUnit::value_type const t = temperature.value(Thermometer::TemperatureUnit::Scale::Fahrenheit);
+    Thermometer::TemperatureUnit::value_type const h = humidity / 100;
     Thermometer::TemperatureUnit::value_type const tt = t * t;
     Thermometer::TemperatureUnit::value_type const hh = h * h;
     Thermometer::TemperatureUnit::value_type const th = t * h;
@@ -34,7 +140,7 @@ Thermometer::TemperatureUnit Thermometer::humiture()
     // NOTE: ±3 degrees between 70-115F, and humidity of 0-80%
     // NOTE: [Functional] range is for temperatures below 150F.
     if ((t < 70) || (t > 115) || (h < 0) || (h > 0.80))
-        return Thermometer::TemperatureUnit(temperature());
+        return Thermometer::TemperatureUnit(temperature);
     
     return Thermometer::TemperatureUnit(0.363445176f +
                                         0.988622465f * t +
@@ -45,17 +151,7 @@ Thermometer::TemperatureUnit Thermometer::humiture()
                                         0.000687678f * t * th +
                                         0.000274954f * th * h,
                                         Thermometer::TemperatureUnit::Scale::Fahrenheit);
-}
-
-Thermometer::TemperatureUnit::value_type Thermometer::humidity()
-{
-    sense(); // Attempt to get new sensory data.
-    return _humidity;
-}
-
-Thermometer::Range Thermometer::range() const
-{
-    return _range;
+#endif
 }
 
 bool Thermometer::_validTemperature(Thermometer::TemperatureUnit const &temperature)
@@ -67,13 +163,71 @@ Thermometer::Thermometer(Pin::Arrangement const &pins,
                          Scheduler::Time const senseTimeout,
                          Thermometer::Range const &range):
 Sensor(pins, senseTimeout),
-_range(range)
+_range(range),
+_humidity(0),
+_sample({_temperature, _temperature, 0, _temperature, 0, 0, true}),
+_temperatureFilter(0.5, 3, 0.5), // Outliers are at least half a degree off.
+_sampleReadings(0),
+_sampler(*this)
 {
     
 }
 
 Thermometer::~Thermometer()
 {
-    
+    _sampler.unschedule();
+}
+
+
+// =============================================================================
+// Thermometer::Sampler : Implementation
+// =============================================================================
+bool Thermometer::Sampler::start(Scheduler::Time const time)
+{
+    if (scheduled()) return false;
+
+    setExecuteTime(time); // Not scheduled at this point, won't reprioritize.
+    return _thermometer._scheduler.enqueue(std::static_pointer_cast<Scheduler::Event>(self()));
+}
+
+int Thermometer::Sampler::execute(Scheduler::Time const time)
+{
+    _thermometer.snapshot(time);
+    return 0;
+}
+
+bool Thermometer::Sampler::finished() const
+{
+    return !executeTimeInterval();
+}
+
+Thermometer::Sampler::Sampler(Thermometer &thermometer):
+Scheduler::Daemon(0, 0),
+_thermometer(thermometer)
+{
+
+}
+
+Thermometer::Sampler::~Sampler()
+{
+
+}
+
+
+// =============================================================================
+// ThermometerDelegate : Implementation
+// =============================================================================
+void ThermometerDelegate::thermometerSampled(Thermometer * const thermometer,
+                                             Thermometer::Sample const &sample)
+{
+    // The following done to suppress unused variable warnings.
+    (void) thermometer;
+    (void) sample;
+    return; // By default, skip.
+}
+
+ThermometerDelegate::~ThermometerDelegate()
+{
+
 }
 
@@ -10,32 +10,95 @@
 #define Thermometer_hpp
 
 #include <utility>
+#include <cstdint>
 #include "Development.hpp"
 #include "Temperature.hpp"
+#include "FixedPoint.hpp"
+#include "Aggregators.hpp"
+#include "Scheduler.hpp"
 #include "Actuator.hpp"
 #include "Sensor.hpp"
+#include "Delegable.hpp"
+
+class ThermometerDelegate;
 
 // =============================================================================
 // Thermometer : This class abstracts the functionality of temperature reading.
 // The thermometer class is meant to be subclassed to implement the sense method
 // of the Sensor class, which generate/get temperature info and return that.
 // =============================================================================
-class Thermometer : protected Sensor {
+class Thermometer : protected Sensor, public Delegable<ThermometerDelegate> {
 public:
 
     // TemperatureUnit denotes the temperature data type to use.
+    // Define MJB_FIXED_POINT_TEMPERATURE for integer only temperatures (held as
+    // centi-Kelvin), sparing targets without an FPU from software floats.
+#if defined(MJB_FIXED_POINT_TEMPERATURE)
+    typedef Temperature<FixedPoint> TemperatureUnit;
+#else
     typedef Temperature<float> TemperatureUnit;
+#endif
+
+    // KelvinUnit denotes TemperatureUnit's internal scale, as a distinct type.
+    typedef ScaledTemperature<TemperatureUnit::value_type, TemperatureUnit::Kelvin> KelvinUnit;
+
+    using Sensor::Health;
+    using Sensor::health;
 
     // Range denotes the thermometer's range as a tuple, [Minimum, Maximum].
     typedef std::pair<TemperatureUnit, TemperatureUnit> Range;
+
+    // TemperatureFilter denotes the smoothing applied to readings (in Kelvin).
+    typedef ReadingFilter<TemperatureUnit::value_type, 5> TemperatureFilter;
+
+    // Sample denotes the readings of a single sense operation, along with the
+    // metrics derived from them, so that consumers needn't sense repeatedly.
+    struct Sample
+    {
+        TemperatureUnit temperature;
+        TemperatureUnit humiture;
+        TemperatureUnit::value_type humidity;
+        TemperatureUnit smoothed;   // The temperature, through the filter.
+        uint32_t sequence;      // Incremented with every snapshot taken.
+        Scheduler::Time time;   // The time at which the snapshot was taken.
+        bool stale;             // No new readings arrived since the last one.
+    };
     
     // NOTE: The methods below call Sensor's sense() method to update values,
     // which are then returned by default. However, these can be overwritten.
     virtual TemperatureUnit temperature();
     virtual TemperatureUnit humiture(); // AKA, Heat Index.
     virtual TemperatureUnit::value_type humidity();
+
+    // Senses once and records the readings, and the metrics derived from them,
+    // as the latest sample; meant to be called once per control cycle.
+    // Delegates are told of every sample recorded, however it was taken.
+    virtual Sample const &snapshot(Scheduler::Time const time);
+    Sample const &sample() const;
+
+    // When non-zero, the thermometer takes a snapshot of itself this often (in
+    // microseconds) on its own scheduler, for delegates to react to, rather
+    // than waiting on a Thermostat's cycle to be sampled.
+    Scheduler::Time samplingInterval() const;
+    void setSamplingInterval(Scheduler::Time const samplingInterval = 0);
+
+    // The following allow readings to be acquired concurrently: request starts
+    // acquiring readings, pending reports whether they're still on their way,
+    // and collect records whatever readings are at hand, without sensing.
+    // NOTE: By default, request senses in place and readings arrive at once.
+    virtual void request();
+    virtual bool pending() const;
+    Sample const &collect(Scheduler::Time const time);
+
+    // Fresh readings are filtered as they're collected; outliers are rejected
+    // and the rest are averaged, yielding each sample's smoothed temperature.
+    TemperatureFilter const &temperatureFilter() const;
     
     virtual Range range() const;
+
+    // Returns the heat index, aka, the "feels like" temperature.
+    static TemperatureUnit Humiture(TemperatureUnit const &temperature,
+                                    TemperatureUnit::value_type const humidity);
     
     Thermometer(Pin::Arrangement const &pins,
                 Scheduler::Time const senseTimeout = 0,
@@ -46,6 +109,26 @@ public:
     
     
 protected:
+
+    // =========================================================================
+    // Sampler: A Daemon taking the thermometer's snapshots at its interval.
+    // =========================================================================
+    class Sampler : public Scheduler::Daemon
+    {
+    public:
+
+        bool start(Scheduler::Time const time);
+
+        int execute(Scheduler::Time const time);
+        bool finished() const;
+
+        Sampler(Thermometer &thermometer);
+        virtual ~Sampler();
+
+    protected:
+
+        Thermometer &_thermometer;
+    };
     
     // The following serve for two purposes:
     // 1. To have a common method which will update the values below and not be
@@ -55,9 +138,31 @@ protected:
     Range const _range;
     TemperatureUnit::value_type _humidity;
 
+    Sample _sample;
+    TemperatureFilter _temperatureFilter;
+
+    // Implementations must call _recordReading() whenever they update the
+    // cached values above with new readings, this is how staleness is known.
+    uint32_t _sampleReadings;
+
+    Sampler _sampler;
+
     bool _validTemperature(TemperatureUnit const &temperature);
     
 };
 
+// =========================================================================
+// Delegate: A common interface used to interface with other classes.
+// =========================================================================
+class ThermometerDelegate
+{
+public:
+
+    virtual void thermometerSampled(Thermometer * const thermometer,
+                                    Thermometer::Sample const &sample);
+
+    virtual ~ThermometerDelegate();
+};
+
 #endif /* Thermometer_hpp */
 
@@ -8,6 +8,11 @@
 
 #include "Thermostat.hpp"
 
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
 // =============================================================================
 // Thermostat : Implementation
 // =============================================================================
@@ -19,6 +24,8 @@ Thermostat::Mode Thermostat::mode() const
 void Thermostat::setMode(const Thermostat::Mode mode)
 {
     _mode = mode;
+    _band = Thermostat::ControlBand::Compile(_mode, _targetTemperature, _targetTemperatureThreshold);
+    _settingsChanged();
 }
 
 Thermostat::Status Thermostat::status() const
@@ -26,48 +33,63 @@ Thermostat::Status Thermostat::status() const
     return _status;
 }
 
-Thermometer::TemperatureUnit::value_type Thermostat::humidity()
+Thermometer::TemperatureUnit::value_type Thermostat::humidity() const
 {
     Thermometer::TemperatureUnit::value_type humidity = 0;
+    std::size_t count = 0;
+
+    bool const freshSamples = _freshSamples();
     
     for (std::shared_ptr<Thermometer> const &thermometer : thermometers)
     {
-        humidity += thermometer->humidity();
+        if (_excluded(*thermometer, freshSamples)) continue;
+        humidity += thermometer->sample().humidity;
+        count++;
     }
 
     // NOTE: The following accounts for no thermometers; division by 0.
-    if (thermometers.size() > 1) humidity /= thermometers.size();
+    if (count > 1) humidity /= count;
     
     return humidity;
 }
 
-Thermometer::TemperatureUnit Thermostat::humiture()
+Thermometer::TemperatureUnit Thermostat::humiture() const
 {
-    Thermometer::TemperatureUnit humiture = 0;
+    Thermometer::TemperatureUnit humiture(0);
+    std::size_t count = 0;
+
+    bool const freshSamples = _freshSamples();
     
     for (std::shared_ptr<Thermometer> const &thermometer : thermometers)
     {
-        humiture += thermometer->humiture();
+        if (_excluded(*thermometer, freshSamples)) continue;
+        humiture += thermometer->sample().humiture;
+        count++;
     }
 
     // NOTE: The following accounts for no thermometers; division by 0.
-    if (thermometers.size() > 1) humiture /= thermometers.size();
+    if (count > 1) humiture /= count;
     
     return humiture;
 }
 
 
-Thermometer::TemperatureUnit Thermostat::temperature()
+Thermometer::TemperatureUnit Thermostat::temperature() const
 {
-    Thermometer::TemperatureUnit temperature = 0;
+    Thermometer::TemperatureUnit temperature(0);
+    std::size_t count = 0;
+
+    bool const freshSamples = _freshSamples();
     
     for (std::shared_ptr<Thermometer> const &thermometer : thermometers)
     {
-        temperature += thermometer->temperature();
+        if (_excluded(*thermometer, freshSamples)) continue;
+        temperature += thermometer->sample().temperature;
+        count++;
     }
 
     // NOTE: The following accounts for no thermometers; division by 0.
-    if (thermometers.size() > 1) temperature /= thermometers.size();
+    if (count > 1) temperature /= count;
     
     return temperature;
 }
@@ -80,6 +102,8 @@ Thermometer::TemperatureUnit Thermostat::targetTemperature() const
 void Thermostat::setTargetTemperature(Thermometer::TemperatureUnit const &targetTemperature)
 {
     _targetTemperature = targetTemperature;
+    _band = Thermostat::ControlBand::Compile(_mode, _targetTemperature, _targetTemperatureThreshold);
+    _settingsChanged();
 }
 
 Thermostat::TemperatureThreshold Thermostat::targetTemperatureThreshold() const
@@ -90,6 +114,8 @@ Thermostat::TemperatureThreshold Thermostat::targetTemperatureThreshold() const
 void Thermostat::setTargetTemperatureThreshold(Thermostat::TemperatureThreshold const & targetTemperatureThreshold)
 {
     _targetTemperatureThreshold = targetTemperatureThreshold;
+    _band = Thermostat::ControlBand::Compile(_mode, _targetTemperature, _targetTemperatureThreshold);
+    _settingsChanged();
 }
 
 Thermostat::PerceptionIndex Thermostat::perceptionIndex() const
@@ -100,6 +126,140 @@ Thermostat::PerceptionIndex Thermostat::perceptionIndex() const
 void Thermostat::setPerceptionIndex(Thermostat::PerceptionIndex const perceptionIndex)
 {
     _perceptionIndex = perceptionIndex;
+    _settingsChanged();
+}
+
+Thermostat::ControlBand const &Thermostat::controlBand() const
+{
+    return _band;
+}
+
+Thermometer::TemperatureUnit Thermostat::smoothedTemperature() const
+{
+    return _temperatureFilter.primed()? Thermometer::TemperatureUnit(_temperatureFilter.value()) : temperature();
+}
+
+Thermometer::TemperatureUnit Thermostat::smoothedHumiture() const
+{
+    return _humitureFilter.primed()? Thermometer::TemperatureUnit(_humitureFilter.value()) : humiture();
+}
+
+Thermostat::Aggregation Thermostat::aggregation() const
+{
+    return _aggregation;
+}
+
+void Thermostat::setAggregation(Thermostat::Aggregation const aggregation)
+{
+    _aggregation = aggregation;
+    _settingsChanged();
+}
+
+Scheduler::Time Thermostat::acquisitionTimeout() const
+{
+    return _acquisitionTimeout;
+}
+
+void Thermostat::setAcquisitionTimeout(Scheduler::Time const acquisitionTimeout)
+{
+    _acquisitionTimeout = acquisitionTimeout;
+}
+
+Scheduler::Time Thermostat::readingAgeLimit() const
+{
+    return _readingAgeLimit;
+}
+
+void Thermostat::setReadingAgeLimit(Scheduler::Time const readingAgeLimit)
+{
+    _readingAgeLimit = readingAgeLimit;
+}
+
+Thermostat::Evaluation Thermostat::evaluation() const
+{
+    return _evaluation;
+}
+
+void Thermostat::setEvaluation(Thermostat::Evaluation const evaluation)
+{
+    _evaluation = evaluation;
+
+    // Shares self()'s (non-owning) ownership, since the delegate base isn't public.
+    std::shared_ptr<ThermometerDelegate> const delegate(Scheduler::Event::self(), static_cast<ThermometerDelegate *>(this));
+
+    for (std::shared_ptr<Thermometer> const &thermometer : thermometers)
+    {
+        if (evaluation == Thermostat::Evaluation::OnChange) thermometer->addDelegate(delegate);
+        else thermometer->removeDelegate(delegate);
+    }
+}
+
+Thermostat::CycleHistory const &Thermostat::history() const
+{
+    return _history;
+}
+
+std::shared_ptr<SetpointProgram const> const &Thermostat::program() const
+{
+    return _program;
+}
+
+bool Thermostat::setProgram(std::shared_ptr<SetpointProgram const> const &program,
+                            SetpointProgram::Clock const &clock)
+{
+    if (_programmer.scheduled()) _programmer.unschedule();
+
+    _program = program;
+    _programClock = clock;
+
+#if defined(MJB_POSIX_API)
+    if (!_programClock) _programClock = SetpointProgram::LocalTime;
+#endif
+
+    if (!_program) return true;
+
+    if (!_programClock)
+    {
+        _program = nullptr;
+        return false;
+    }
+
+    // The program's setpoint is applied on the next update.
+    return _programmer.start(micros());
+}
+
+uint32_t Thermostat::submit(Thermostat::Command const &command)
+{
+    if (command.empty() || !command.valid() || (_commandsCount >= Thermostat::_CommandsMax)) return 0;
+
+    Thermostat::Command &queued = _commands[(_commandsFirst + _commandsCount) % Thermostat::_CommandsMax];
+    queued = command;
+    queued._id = ++_submittedCommand;
+    _commandsCount++;
+
+    // The dispatcher is already scheduled if other commands are queued.
+    if (!_dispatcher.scheduled()) _dispatcher.start(micros());
+
+    return queued._id;
+}
+
+uint32_t Thermostat::appliedCommand() const
+{
+    return _appliedCommand;
+}
+
+uint32_t Thermostat::submittedCommand() const
+{
+    return _submittedCommand;
+}
+
+std::shared_ptr<Thermostat::Snapshot const> Thermostat::snapshot() const
+{
+#if defined(MJB_MULTITHREAD_CAPABLE)
+    return std::atomic_load(&_snapshot);
+#else
+    return _snapshot;
+#endif
 }
 
 int Thermostat::update(Scheduler::Time const time)
@@ -109,35 +269,81 @@ int Thermostat::update(Scheduler::Time const time)
     return execute(time);
 }
 
-Thermostat::Status Thermostat::_standby(Thermostat::Status const status)
+void Thermostat::_sampleThermometers(Scheduler::Time const time)
 {
-    _controller.actuate({ // Toggle all pins to 0, or release all relays, immediately.
-        {_controller.pinout[Thermostat::SignalLine::FanCall],  {Pin::Mode::Output, 0}, 0},
-        {_controller.pinout[Thermostat::SignalLine::CoolCall], {Pin::Mode::Output, 0}, 0},
-        {_controller.pinout[Thermostat::SignalLine::HeatCall], {Pin::Mode::Output, 0}, 0}
-    });
-    
-    return status;
+    _sampling = true; // The cycle evaluates once they're all sampled.
+
+    for (std::shared_ptr<Thermometer> const &thermometer : thermometers)
+    {
+        thermometer->snapshot(time);
+    }
+
+    _sampling = false;
+}
+
+bool Thermostat::_eligible(Thermometer const &thermometer) const
+{
+    Thermometer::Health const &health = thermometer.health();
+
+    if (!health.readings) return false; // Never read, nothing to go by.
+
+    // A fresh sample's reading was just taken; only stale ones may be too old.
+    Thermometer::Sample const &sample = thermometer.sample();
+    return !sample.stale || !readingAgeLimit() ||
+           ((sample.time - health.readingTime) <= readingAgeLimit());
 }
 
-Thermostat::Status Thermostat::_setCooler(bool const cool)
+bool Thermostat::_eligibleSamples() const
 {
-    _controller.actuate({ // Cool & Fan on if above target temp, off otherwise.
-        {_controller.pinout[Thermostat::SignalLine::FanCall],  {Pin::Mode::Output, cool}, 0},
-        {_controller.pinout[Thermostat::SignalLine::CoolCall], {Pin::Mode::Output, cool}, 0},
-        {_controller.pinout[Thermostat::SignalLine::HeatCall], {Pin::Mode::Output,    0}, 0}
-    });
-    return cool? Thermostat::Status::Cooling : Thermostat::Status::Standby;
+    for (std::shared_ptr<Thermometer> const &thermometer : thermometers)
+    {
+        if (_eligible(*thermometer)) return true;
+    }
+    return false;
+}
+
+bool Thermostat::_freshSamples() const
+{
+    for (std::shared_ptr<Thermometer> const &thermometer : thermometers)
+    {
+        if (!thermometer->sample().stale && _eligible(*thermometer)) return true;
+    }
+    return false;
 }
 
-Thermostat::Status Thermostat::_setHeater(bool const heat)
+bool Thermostat::_excluded(Thermometer const &thermometer, bool const freshSamples) const
 {
-    _controller.actuate({ // Heat & Fan on if below target temp, off otherwise.
-        {_controller.pinout[Thermostat::SignalLine::FanCall],  {Pin::Mode::Output, heat}, 0},
-        {_controller.pinout[Thermostat::SignalLine::CoolCall], {Pin::Mode::Output,    0}, 0},
-        {_controller.pinout[Thermostat::SignalLine::HeatCall], {Pin::Mode::Output, heat}, 0}
-    });
-    return heat? Thermostat::Status::Heating : Thermostat::Status::Standby;
+    return !_eligible(thermometer) || (freshSamples && thermometer.sample().stale);
+}
+
+constexpr Actuator::Pattern Thermostat::_FanCall;
+constexpr Actuator::Pattern Thermostat::_CoolCall;
+constexpr Actuator::Pattern Thermostat::_HeatCall;
+constexpr Thermostat::Decision Thermostat::_Decisions[4][3];
+
+Thermostat::Decision const &Thermostat::_Decide(Thermostat::Mode const mode,
+                                                Thermostat::ControlBand::Position const position)
+{
+    switch (mode)
+    {
+        case Off:
+        case Heat:
+        case Cool:
+        case Auto: return _Decisions[mode][position];
+        default: return _Decisions[Off][position];
+    }
+}
+
+Thermostat::Status Thermostat::_apply(Thermostat::Decision const &decision)
+{
+    _controller.transition(decision.pattern); // Only lines that change are written.
+    return decision.status;
+}
+
+Thermostat::Status Thermostat::_standby()
+{
+    // Release all relays, immediately.
+    return _apply(_Decisions[Off][Thermostat::ControlBand::Position::Within]);
 }
 
 int Thermostat::execute(Scheduler::Time const updateTime)
@@ -163,60 +369,138 @@ int Thermostat::execute(Scheduler::Time const updateTime)
         return Thermostat::ExecutionCode::SignalLinesNotReady; // Pins not ready or unavailable!
     }
 
+    // When acquiring concurrently, request all readings at once and let the
+    // collector complete the cycle once they've arrived (or timed out).
+    if (acquisitionTimeout() && !thermometers.empty())
+    {
+        // A cycle already awaiting its readings will complete shortly.
+        if (_collector.collecting()) return Thermostat::ExecutionCode::Success;
+
+        for (std::shared_ptr<Thermometer> const &thermometer : thermometers)
+        {
+            thermometer->request();
+        }
+
+        _collector.start(updateTime);
+        return Thermostat::ExecutionCode::Success;
+    }
+
     // Read this only once every update, since the sensor may need to timeout for a bit.
     // In my case, the DHT22 needs to timeout for about two seconds after a read cycle.
-    Thermometer::TemperatureUnit const currentTemperature = perceptionIndex()? humiture() : temperature();
+    // Everything else this cycle, including logging, is derived from these samples.
+    _sampleThermometers(updateTime);
+
+    return _control(updateTime);
+}
+
+void Thermostat::_filter()
+{
+    bool const freshSamples = _freshSamples();
+
+    if (!freshSamples) return; // Nothing new to filter.
 
-    const Thermometer::TemperatureUnit::value_type temperatureThreshold = _targetTemperatureThreshold.first;
-    const Thermometer::TemperatureUnit::Scale temperatureThresholdScale = _targetTemperatureThreshold.second;
+    Thermometer::TemperatureUnit::value_type temperature = 0;
+    std::size_t count = 0;
 
-    switch (mode())
+    for (std::shared_ptr<Thermometer> const &thermometer : thermometers)
     {
-        case Off: _status = _standby();
-            break;
-            
-        case Heat: _status = _setHeater(currentTemperature.value(temperatureThresholdScale) <
-                                        (targetTemperature().value(temperatureThresholdScale) + temperatureThreshold));
-            break;
-            
-        case Cool: _status = _setCooler(currentTemperature.value(temperatureThresholdScale) >
-                                        (targetTemperature().value(temperatureThresholdScale) - temperatureThreshold));
-            break;
-            
-        case Auto: {
-            if (currentTemperature.value(temperatureThresholdScale) <
-                (targetTemperature().value(temperatureThresholdScale) - temperatureThreshold)) {
-                _status = _setHeater(true);
-            } else
-            if (currentTemperature.value(temperatureThresholdScale) >
-                (targetTemperature().value(temperatureThresholdScale) + temperatureThreshold)) {
-                _status = _setCooler(true);
-            } else {
-                _status = _standby(Thermostat::Status::Stasis);
-            }
-        }   break;
-            
-        default: _status = _standby();
-            break;
+        if (_excluded(*thermometer, freshSamples)) continue;
+        temperature += thermometer->sample().smoothed.value();
+        count++;
     }
 
+    if (count > 1) temperature /= count;
+
+    _temperatureFilter.update(temperature);
+    _humitureFilter.update(humiture().value());
+
+    _roundSequences.resize(thermometers.size());
+    for (std::size_t index = 0; index < thermometers.size(); index++)
+    {
+        _roundSequences[index] = thermometers[index]->sample().sequence;
+    }
+}
+
+bool Thermostat::_roundComplete() const
+{
+    if (_roundSequences.size() != thermometers.size()) return true; // Changed.
+
+    for (std::size_t index = 0; index < thermometers.size(); index++)
+    {
+        Thermometer const &thermometer = *thermometers[index];
+
+        // Thermometers not sampling themselves are only sampled by cycles.
+        if (!thermometer.samplingInterval()) continue;
+        if (thermometer.sample().sequence == _roundSequences[index]) return false;
+    }
+    return true;
+}
+
+int Thermostat::_control(Scheduler::Time const updateTime)
+{
+    // Without a usable reading, don't act on made up (zero) temperatures.
+    if (!_eligibleSamples()) {
+#if defined(MJB_DEBUG_LOGGING_THERMOSTAT)
+        MJB_DEBUG_LOG("[Thermostat <");
+        MJB_DEBUG_LOG_FORMAT((unsigned long) this, MJB_DEBUG_LOG_HEX);
+        MJB_DEBUG_LOG_LINE(">] WARNING: No usable thermometer readings!");
+#endif
+        _status = _standby();
+        _changed = true; // Evaluate as soon as readings are back.
+        return Thermostat::ExecutionCode::ReadingsUnavailable;
+    }
+
+    _filter();
+
+    return _evaluate(updateTime);
+}
+
+Thermometer::KelvinUnit Thermostat::_perceived() const
+{
+    bool const smoothed = (aggregation() == Thermostat::Aggregation::Smoothed);
+    return Thermometer::KelvinUnit(perceptionIndex()? (smoothed? smoothedHumiture() : humiture()) :
+                                                      (smoothed? smoothedTemperature() : temperature()));
+}
+
+int Thermostat::_evaluate(Scheduler::Time const updateTime)
+{
+    // Compare in Kelvin, the temperatures' own scale, against the band compiled
+    // when the settings last changed; the decision takes at most two compares,
+    // and what to do about it is a lookup by the band's mode and position.
+    Thermostat::ControlBand::Position const position = _band.position(_perceived());
+
+    _status = _apply(_Decide(_band.mode(), position));
+    _position = position;
+    _changed = false;
+
+    _history.append(updateTime,
+                    temperature(),
+                    humidity(),
+                    humiture(),
+                    targetTemperature(),
+                    static_cast<uint8_t>(_band.mode()),
+                    static_cast<uint8_t>(_status),
+                    static_cast<uint8_t>(_controller.pattern()));
+
+    _publish();
+
 #if defined(MJB_DEBUG_LOGGING_THERMOSTAT)
     MJB_DEBUG_LOG("[Thermostat <");
     MJB_DEBUG_LOG_FORMAT((unsigned long) this, MJB_DEBUG_LOG_HEX);
     MJB_DEBUG_LOG(">] Temperature:");
-    MJB_DEBUG_LOG_FORMAT(temperature().value(Thermometer::TemperatureUnit::Scale::Fahrenheit), MJB_DEBUG_LOG_DEC);
+    MJB_DEBUG_LOG_FORMAT(static_cast<float>(temperature().value(Thermometer::TemperatureUnit::Scale::Fahrenheit)), MJB_DEBUG_LOG_DEC);
     MJB_DEBUG_LOG("F, Humiture:");
-    MJB_DEBUG_LOG(humiture().value(Thermometer::TemperatureUnit::Scale::Fahrenheit));
+    MJB_DEBUG_LOG(static_cast<float>(humiture().value(Thermometer::TemperatureUnit::Scale::Fahrenheit)));
     MJB_DEBUG_LOG("F, Humidity:");
-    MJB_DEBUG_LOG(humidity());
+    MJB_DEBUG_LOG(static_cast<float>(humidity()));
     MJB_DEBUG_LOG("% Target: ");
-    MJB_DEBUG_LOG_FORMAT(targetTemperature().value(Thermometer::TemperatureUnit::Scale::Fahrenheit), MJB_DEBUG_LOG_DEC);
+    MJB_DEBUG_LOG_FORMAT(static_cast<float>(targetTemperature().value(Thermometer::TemperatureUnit::Scale::Fahrenheit)), MJB_DEBUG_LOG_DEC);
     MJB_DEBUG_LOG_LINE("F");
 
     MJB_DEBUG_LOG("[Thermostat <");
     MJB_DEBUG_LOG_FORMAT((unsigned long) this, MJB_DEBUG_LOG_HEX);
     MJB_DEBUG_LOG(">] Threshold:");
-    MJB_DEBUG_LOG_FORMAT(targetTemperatureThreshold().first, MJB_DEBUG_LOG_DEC);
+    MJB_DEBUG_LOG_FORMAT(static_cast<float>(targetTemperatureThreshold().first), MJB_DEBUG_LOG_DEC);
     MJB_DEBUG_LOG(((targetTemperatureThreshold().second == Thermometer::TemperatureUnit::Scale::Fahrenheit)? "F" :
                    ((targetTemperatureThreshold().second == Thermometer::TemperatureUnit::Scale::Celsius)?  "C" :  "K")));
     MJB_DEBUG_LOG(", Perceivable Index:");
@@ -232,6 +516,527 @@ int Thermostat::execute(Scheduler::Time const updateTime)
     return Thermostat::ExecutionCode::Success;
 }
 
+void Thermostat::_react(Scheduler::Time const time)
+{
+    if (evaluation() != Thermostat::Evaluation::OnChange) return;
+    _reconsider(time);
+}
+
+void Thermostat::_reconsider(Scheduler::Time const time)
+{
+    // Leave it to the next cycle if it can't act now, or has nothing to go by.
+    if ((_controller.pinout.size() < 3) || (_controller.status() != Actuator::Status::Ready)) return;
+    if (!_eligibleSamples()) return;
+
+    // Most samples land where the last one did; those don't change a thing.
+    if (!_changed && (_band.position(_perceived()) == _position)) return;
+
+    _evaluate(time);
+}
+
+void Thermostat::_settingsChanged()
+{
+    _changed = true;
+    _react(micros());
+    _publish();
+}
+
+void Thermostat::_publish()
+{
+    std::shared_ptr<Thermostat::Snapshot const> const current = snapshot();
+    Thermostat::Snapshot const candidate(*this, current? (current->version() + 1) : 1);
+
+    // Statuses reading the same keep their snapshot, and clients their copies.
+    if (current && (*current == candidate)) return;
+
+    std::shared_ptr<Thermostat::Snapshot const> const published(std::make_shared<Thermostat::Snapshot const>(candidate));
+
+#if defined(MJB_MULTITHREAD_CAPABLE)
+    std::atomic_store(&_snapshot, published);
+#else
+    _snapshot = published;
+#endif
+}
+
+void Thermostat::thermometerSampled(Thermometer * const thermometer,
+                                    Thermometer::Sample const &sample)
+{
+    // The following done to suppress unused variable warnings.
+    (void) thermometer;
+
+    // Samples taken by the thermostat's own cycles are evaluated by them.
+    if ((evaluation() != Thermostat::Evaluation::OnChange) || _sampling || sample.stale) return;
+
+    // Filters take a round of samples at a time, as cycles feed them, rather
+    // than a sample per thermometer's; reactions needn't wait on the round.
+    if (_roundComplete()) _filter();
+    _react(sample.time);
+}
+
+
+// =============================================================================
+// Thermostat::ControlBand : Implementation
+// =============================================================================
+Thermostat::Mode Thermostat::ControlBand::mode() const
+{
+    return _mode;
+}
+
+Thermometer::KelvinUnit Thermostat::ControlBand::lower() const
+{
+    return _lower;
+}
+
+Thermometer::KelvinUnit Thermostat::ControlBand::upper() const
+{
+    return _upper;
+}
+
+Thermostat::ControlBand::Position Thermostat::ControlBand::position(Thermometer::KelvinUnit const &temperature) const
+{
+    if (temperature < _lower) return Thermostat::ControlBand::Position::Below;
+    if (temperature > _upper) return Thermostat::ControlBand::Position::Above;
+    return Thermostat::ControlBand::Position::Within;
+}
+
+Thermostat::ControlBand Thermostat::ControlBand::Compile(Thermostat::Mode const mode,
+                                                         Thermometer::TemperatureUnit const &targetTemperature,
+                                                         Thermostat::TemperatureThreshold const &targetTemperatureThreshold)
+{
+    Thermometer::KelvinUnit const target(targetTemperature);
+
+    // Thresholds are intervals, so they're only scaled, not offset.
+    Thermometer::TemperatureUnit::value_type const threshold =
+        Thermometer::TemperatureUnit::ConvertInterval(targetTemperatureThreshold.first,
+                                                      targetTemperatureThreshold.second,
+                                                      Thermometer::TemperatureUnit::Scale::Kelvin);
+
+    switch (mode)
+    {
+        // Heat until the temperature reaches the target, plus the threshold.
+        case Heat: return ControlBand(mode, target + threshold, target + threshold);
+
+        // Cool until the temperature reaches the target, minus the threshold.
+        case Cool: return ControlBand(mode, target - threshold, target - threshold);
+
+        // Heat or cool once the temperature strays the threshold from target.
+        case Auto: return ControlBand(mode, target - threshold, target + threshold);
+
+        default: return ControlBand(Off, target, target);
+    }
+}
+
+Thermostat::ControlBand::ControlBand(Thermostat::Mode const mode,
+                                     Thermometer::KelvinUnit const &lower,
+                                     Thermometer::KelvinUnit const &upper):
+_mode(mode),
+_lower(lower),
+_upper(upper)
+{
+
+}
+
+// =============================================================================
+// Thermostat::Collector : Implementation
+// =============================================================================
+bool Thermostat::Collector::collecting() const
+{
+    return _collecting;
+}
+
+bool Thermostat::Collector::start(Scheduler::Time const time)
+{
+    if (collecting()) return false;
+
+    setExecuteTime(time); // Not scheduled at this point, won't reprioritize.
+
+    // Check on the readings every cycle until they're all in.
+    _collecting = _thermostat._scheduler.enqueue(std::static_pointer_cast<Scheduler::Event>(self()));
+    _startTime = time;
+    return _collecting;
+}
+
+int Thermostat::Collector::execute(Scheduler::Time const time)
+{
+    bool pending = false;
+
+    for (std::shared_ptr<Thermometer> const &thermometer : _thermostat.thermometers)
+    {
+        pending = pending || thermometer->pending();
+    }
+
+    // Keep waiting only while readings are pending and there's time left.
+    if (pending && ((time - _startTime) <= _thermostat.acquisitionTimeout())) return 0;
+
+    // NOTE: Readings which didn't arrive in time are recorded as stale.
+    _thermostat._sampling = true;
+    for (std::shared_ptr<Thermometer> const &thermometer : _thermostat.thermometers)
+    {
+        thermometer->collect(time);
+    }
+    _thermostat._sampling = false;
+
+    _collecting = false;
+    return _thermostat._control(time);
+}
+
+bool Thermostat::Collector::finished() const
+{
+    return !collecting();
+}
+
+Thermostat::Collector::Collector(Thermostat &thermostat):
+Scheduler::Daemon(0, 0),
+_thermostat(thermostat),
+_startTime(0),
+_collecting(false)
+{
+    
+}
+
+Thermostat::Collector::~Collector()
+{
+    
+}
+
+
+// =============================================================================
+// Thermostat::Command : Implementation
+// =============================================================================
+uint32_t Thermostat::Command::id() const
+{
+    return _id;
+}
+
+void Thermostat::Command::setMode(Thermostat::Mode const mode)
+{
+    _mode = mode;
+    _settings |= Thermostat::Command::Setting::ModeSetting;
+}
+
+void Thermostat::Command::setTargetTemperature(Thermometer::TemperatureUnit const &targetTemperature,
+                                               Thermostat::TemperatureThreshold const &targetTemperatureThreshold)
+{
+    _targetTemperature = targetTemperature;
+    _targetTemperatureThreshold = targetTemperatureThreshold;
+    _settings |= Thermostat::Command::Setting::TargetSetting;
+}
+
+void Thermostat::Command::setPerceptionIndex(Thermostat::PerceptionIndex const perceptionIndex)
+{
+    _perceptionIndex = perceptionIndex;
+    _settings |= Thermostat::Command::Setting::PerceptionSetting;
+}
+
+bool Thermostat::Command::empty() const
+{
+    return !_settings;
+}
+
+bool Thermostat::Command::valid() const
+{
+    if (_settings & Thermostat::Command::Setting::TargetSetting)
+    {
+        Thermometer::TemperatureUnit::Scale const scale = _targetTemperatureThreshold.second;
+
+        if ((scale != Thermometer::TemperatureUnit::Scale::Kelvin) &&
+            (scale != Thermometer::TemperatureUnit::Scale::Celsius) &&
+            (scale != Thermometer::TemperatureUnit::Scale::Fahrenheit)) return false;
+
+        if (!(_targetTemperatureThreshold.first > 0)) return false;
+
+        float const fahrenheit = static_cast<float>(_targetTemperature.value(Thermometer::TemperatureUnit::Scale::Fahrenheit));
+        if (!((fahrenheit >= 40) && (fahrenheit <= 100))) return false;
+    }
+
+    return true;
+}
+
+Thermostat::Command Thermostat::Command::Parse(char const * const mode,
+                                               char const * const temperature,
+                                               char const * const type,
+                                               Thermostat::Mode const current)
+{
+    Thermostat::Command command;
+    Thermostat::Mode commandMode = current;
+
+    if (mode && *mode)
+    {
+        // Only modes by name or number are set; casting any other number
+        // would make a mode that isn't one.
+        bool recognized = true;
+
+        if (!std::strcmp(mode, "auto") || !std::strcmp(mode, "3")) commandMode = Thermostat::Mode::Auto;
+        else
+        if (!std::strcmp(mode, "cool") || !std::strcmp(mode, "2")) commandMode = Thermostat::Mode::Cool;
+        else
+        if (!std::strcmp(mode, "heat") || !std::strcmp(mode, "1")) commandMode = Thermostat::Mode::Heat;
+        else
+        if (!std::strcmp(mode, "off") || !std::strcmp(mode, "0")) commandMode = Thermostat::Mode::Off;
+        else
+        recognized = false;
+
+        if (recognized) command.setMode(commandMode);
+    }
+
+    if (temperature && *temperature)
+    {
+        // The scale follows the value, which must be all there is before it.
+        char const *scale = std::strchr(temperature, 'K');
+        if (!scale) scale = std::strchr(temperature, 'F');
+        if (!scale) scale = std::strchr(temperature, 'C');
+
+        char *parsedEnd = nullptr;
+        float const value = (scale && (scale > temperature))? std::strtof(temperature, &parsedEnd) : 0;
+
+        if (parsedEnd && (parsedEnd == scale))
+        {
+            Thermometer::TemperatureUnit::Scale const unit = static_cast<Thermometer::TemperatureUnit::Scale>(*scale);
+            Thermometer::TemperatureUnit::value_type const temperatureThreshold =
+                (commandMode == Thermostat::Mode::Auto)? 1.0000 : 0.5000;
+
+            command.setTargetTemperature(Thermometer::TemperatureUnit(value, unit),
+                                         std::make_pair(temperatureThreshold, unit));
+        }
+    }
+
+    if (type && *type)
+    {
+        if (!std::strcmp(type, "HI") || !std::strcmp(type, "1"))
+            command.setPerceptionIndex(Thermostat::PerceptionIndex::HeatIndex);
+        else
+        if (!std::strcmp(type, "T") || !std::strcmp(type, "0"))
+            command.setPerceptionIndex(Thermostat::PerceptionIndex::TemperatureIndex);
+    }
+
+    return command;
+}
+
+Thermostat::Command::Command():
+_id(0),
+_settings(0),
+_mode(Thermostat::Mode::Off),
+_targetTemperatureThreshold(std::make_pair(1, Thermometer::TemperatureUnit::Scale::Fahrenheit)),
+_perceptionIndex(Thermostat::PerceptionIndex::TemperatureIndex)
+{
+
+}
+
+
+// =============================================================================
+// Thermostat::Snapshot : Implementation
+// =============================================================================
+uint32_t Thermostat::Snapshot::version() const
+{
+    return _version;
+}
+
+char const *Thermostat::Snapshot::data() const
+{
+    return _data;
+}
+
+std::size_t Thermostat::Snapshot::size() const
+{
+    return _size;
+}
+
+char const *Thermostat::Snapshot::etag() const
+{
+    return _etag;
+}
+
+std::size_t Thermostat::Snapshot::write(char * const buffer,
+                                        std::size_t const capacity,
+                                        uint32_t const submitted) const
+{
+    if (!capacity) return 0;
+
+    std::size_t const command = std::min<std::size_t>(_command, capacity - 1);
+    std::memcpy(buffer, _data, command);
+
+    int const tail = std::snprintf(buffer + command, capacity - command,
+                                   ",\"submitted\":%lu%s",
+                                   static_cast<unsigned long>(submitted),
+                                   _data + _command);
+
+    return (tail < 0)? command : std::min<std::size_t>(command + tail, capacity - 1);
+}
+
+bool Thermostat::Snapshot::operator==(Thermostat::Snapshot const &other) const
+{
+    return (_size == other._size) && !std::memcmp(_data, other._data, _size);
+}
+
+Thermostat::Snapshot::Snapshot(Thermostat const &thermostat, uint32_t const version):
+_version(version)
+{
+    int const size = std::snprintf(_data, Thermostat::Snapshot::_Capacity,
+                                   "{\"temperature\": {\"current\":%.2f,\"target\":%.2f,\"scale\":\"K\",\"delay\":\"?\"}"
+                                   ",\"humiture\":%.2f,\"measurement\":%d,\"humidity\":{\"current\":%.2f}"
+                                   ",\"mode\":%d,\"status\":%d,\"command\":{\"applied\":%lu",
+                                   static_cast<double>(static_cast<float>(thermostat.temperature().value())),
+                                   static_cast<double>(static_cast<float>(thermostat.targetTemperature().value())),
+                                   static_cast<double>(static_cast<float>(thermostat.humiture().value())),
+                                   static_cast<int>(thermostat.perceptionIndex()),
+                                   static_cast<double>(static_cast<float>(thermostat.humidity())),
+                                   static_cast<int>(thermostat.mode()),
+                                   static_cast<int>(thermostat.status()),
+                                   static_cast<unsigned long>(thermostat.appliedCommand()));
+
+    // NOTE: The status is well under capacity; truncation is only a safeguard.
+    _command = static_cast<uint16_t>((size < 0)? 0 : std::min<std::size_t>(size, Thermostat::Snapshot::_Capacity - 3));
+    std::memcpy(_data + _command, "}}", 3);
+    _size = static_cast<uint16_t>(_command + 2);
+
+    // FNV-1a, over the JSON.
+    uint32_t hash = 0x811C9DC5;
+
+    for (std::size_t byte = 0; byte < _size; byte++)
+    {
+        hash = (hash ^ static_cast<uint8_t>(_data[byte])) * 0x01000193;
+    }
+
+    std::snprintf(_etag, sizeof(_etag), "\"%08lx\"", static_cast<unsigned long>(hash));
+}
+
+
+// =============================================================================
+// Thermostat::Dispatcher : Implementation
+// =============================================================================
+bool Thermostat::Dispatcher::start(Scheduler::Time const time)
+{
+    if (scheduled()) return false;
+
+    setExecuteTime(time); // Not scheduled at this point, won't reprioritize.
+    return _thermostat._scheduler.enqueue(std::static_pointer_cast<Scheduler::Event>(self()));
+}
+
+int Thermostat::Dispatcher::execute(Scheduler::Time const time)
+{
+    // Settings are written as they are, rather than set, so that the thermostat
+    // neither evaluates nor publishes until every command queued is applied.
+    bool const applying = _thermostat._commandsCount;
+
+    while (_thermostat._commandsCount)
+    {
+        Thermostat::Command const command = _thermostat._commands[_thermostat._commandsFirst];
+        _thermostat._commandsFirst = (_thermostat._commandsFirst + 1) % Thermostat::_CommandsMax;
+        _thermostat._commandsCount--;
+
+        if (command._settings & Thermostat::Command::Setting::ModeSetting)
+        {
+            _thermostat._mode = command._mode;
+        }
+
+        if (command._settings & Thermostat::Command::Setting::TargetSetting)
+        {
+            _thermostat._targetTemperature = command._targetTemperature;
+            _thermostat._targetTemperatureThreshold = command._targetTemperatureThreshold;
+        }
+
+        if (command._settings & Thermostat::Command::Setting::PerceptionSetting)
+        {
+            _thermostat._perceptionIndex = command._perceptionIndex;
+        }
+
+        _thermostat._appliedCommand = command._id;
+    }
+
+    if (applying)
+    {
+        _thermostat._band = Thermostat::ControlBand::Compile(_thermostat._mode,
+                                                             _thermostat._targetTemperature,
+                                                             _thermostat._targetTemperatureThreshold);
+        _thermostat._changed = true;
+    }
+
+    _thermostat._reconsider(time);
+    _thermostat._publish();
+    return Thermostat::ExecutionCode::Success;
+}
+
+Thermostat::Dispatcher::Dispatcher(Thermostat &thermostat):
+Scheduler::Event(0),
+_thermostat(thermostat)
+{
+
+}
+
+Thermostat::Dispatcher::~Dispatcher()
+{
+
+}
+
+
+// =============================================================================
+// Thermostat::Programmer : Implementation
+// =============================================================================
+constexpr SetpointProgram::Time Thermostat::Programmer::_SleepLimit;
+constexpr uint8_t Thermostat::_CommandsMax;
+constexpr std::size_t Thermostat::Snapshot::Capacity;
+constexpr std::size_t Thermostat::Snapshot::_Capacity;
+
+bool Thermostat::Programmer::start(Scheduler::Time const time)
+{
+    if (scheduled()) return false;
+
+    _applied = false;
+
+    setExecuteTime(time); // Not scheduled at this point, won't reprioritize.
+    return _thermostat._scheduler.enqueue(std::static_pointer_cast<Scheduler::Event>(self()));
+}
+
+int Thermostat::Programmer::execute(Scheduler::Time const time)
+{
+    // The following done to suppress unused variable warnings.
+    (void) time;
+
+    SetpointProgram::Time const now = _thermostat._programClock();
+    SetpointProgram::Setpoint setpoint;
+
+    // Programs may have nothing in effect, until their next holiday.
+    if (!_thermostat._program->setpoint(now, setpoint))
+    {
+        _applied = false;
+        setExecuteTimeInterval(Thermostat::Programmer::_SleepLimit * 1000000);
+        return Thermostat::ExecutionCode::Success;
+    }
+
+    // Setpoints are only applied as they come into effect (or the clock is
+    // set back), so that targets set in between hold until the next one.
+    if (!_applied || (now >= _setpoint.until) || (now < _setpoint.since))
+    {
+        _setpoint = setpoint;
+        _applied = true;
+        _thermostat.setTargetTemperature(setpoint.target);
+    }
+
+    SetpointProgram::Time const remaining = std::min(std::max<SetpointProgram::Time>(_setpoint.until - now, 1),
+                                                     Thermostat::Programmer::_SleepLimit);
+    setExecuteTimeInterval(static_cast<Scheduler::Time>(remaining * 1000000));
+
+    return Thermostat::ExecutionCode::Success;
+}
+
+bool Thermostat::Programmer::finished() const
+{
+    return !_thermostat._program;
+}
+
+Thermostat::Programmer::Programmer(Thermostat &thermostat):
+Scheduler::Daemon(0, 0),
+_thermostat(thermostat),
+_applied(false)
+{
+
+}
+
+Thermostat::Programmer::~Programmer()
+{
+
+}
+
 
 // =============================================================================
 // Thermostat : Constructors & Destructor
@@ -245,14 +1050,41 @@ _targetTemperatureThreshold(std::make_pair(1, Thermometer::TemperatureUnit::Scal
 _perceptionIndex(Thermostat::PerceptionIndex::TemperatureIndex),
 _status(Thermostat::Status::Standby),
 _mode(Thermostat::Mode::Off),
-_controller(pins)
+_band(Thermostat::ControlBand::Compile(_mode, _targetTemperature, _targetTemperatureThreshold)),
+_controller(pins),
+_acquisitionTimeout(0),
+_collector(*this),
+_readingAgeLimit(0),
+_aggregation(Thermostat::Aggregation::Mean),
+_temperatureFilter(0.5, 3, 0.5),
+_humitureFilter(0.5, 3, 0.5),
+_evaluation(Thermostat::Evaluation::Periodic),
+_position(Thermostat::ControlBand::Position::Within),
+_changed(true),
+_sampling(false),
+_programmer(*this),
+_commandsFirst(0),
+_commandsCount(0),
+_submittedCommand(0),
+_appliedCommand(0),
+_dispatcher(*this)
 {
     // targetTemp, targetTempThresh & _scheduler are fine auto-initialized.
+    for (std::shared_ptr<Thermometer> const &thermometer : thermometers)
+    {
+        _roundSequences.push_back(thermometer->sample().sequence);
+    }
+
     _scheduler.enqueue(std::static_pointer_cast<Scheduler::Event>(Scheduler::Event::self()));
+
+    _publish();
 }
 
 Thermostat::~Thermostat()
 {
+    if (_collector.collecting()) _collector.unschedule();
+    if (_programmer.scheduled()) _programmer.unschedule();
+    if (_dispatcher.scheduled()) _dispatcher.unschedule();
 
 }
 
@@ -9,6 +9,8 @@
 #ifndef Thermostat_hpp
 #define Thermostat_hpp
 
+#include <cstddef>
+#include <memory>
 #include <utility>
 #include <vector>
 #include "Development.hpp"
@@ -17,6 +19,8 @@
 #include "Scheduler.hpp"
 #include "Identifiable.hpp"
 #include "Actuator.hpp"
+#include "History.hpp"
+#include "SetpointProgram.hpp"
 
 #if defined(MJB_ARDUINO_LIB_API)
 #include <Arduino.h>
@@ -24,11 +28,21 @@
 #include <iostream>
 #endif
 
+// The control cycles each thermostat remembers; by default, a day's
+// worth of the default 5 minute cycles, at 6 bytes each (see History).
+// NOTE: Histories hold evaluations, not time; at shorter intervals they span
+// less, as 24 minutes of the sketch's 5 second cycles. Keeping a day of those
+// would take 17280 records (over 100KB), so define this for every translation
+// unit (as a compiler flag, never in a single file) to trade memory for span.
+#if !defined(MJB_THERMOSTAT_HISTORY_CAPACITY)
+#define MJB_THERMOSTAT_HISTORY_CAPACITY 288
+#endif
+
 // =============================================================================
 // Thermostat : This class abstracts the functionality of an HVAC control system
 // and provides a simplistic interface for interacting with it.
 // =============================================================================
-class Thermostat : protected Scheduler::Daemon
+class Thermostat : protected Scheduler::Daemon, protected ThermometerDelegate
 {
 public:
     // ================================================================
@@ -37,6 +51,7 @@ public:
     typedef std::vector<std::shared_ptr<Thermometer>> Thermometers;
     typedef std::pair<Thermometer::TemperatureUnit::value_type,
                       Thermometer::TemperatureUnit::Scale> TemperatureThreshold;
+    typedef History<MJB_THERMOSTAT_HISTORY_CAPACITY> CycleHistory;
     
     enum Mode
     {
@@ -60,6 +75,18 @@ public:
         HeatIndex           // Control based on heat index
     };
 
+    enum Aggregation
+    {
+        Mean,               // Control based on the latest samples' average
+        Smoothed            // Control based on filtered samples (see below)
+    };
+
+    enum Evaluation
+    {
+        Periodic,           // Evaluate every cycle (see update(...) below)
+        OnChange            // Evaluate as samples cross the band (see below)
+    };
+
     enum SignalLine
     {
         FanCall,
@@ -72,8 +99,145 @@ public:
         Success,
         SignalLinesMissing,     // Not enough pins (3; cool, fan, heat)
         SignalLinesNotReady,    // A pin isn't ready to actuate.
+        ReadingsUnavailable,    // No thermometer has a usable reading.
     };
     
+    // =========================================================================
+    // ControlBand : The mode, setpoint and threshold compiled into the bounds
+    // temperatures are compared against, in Kelvin (the readings' own scale).
+    // Bands are rebuilt whenever any of them change, never per cycle.
+    // NOTE: Heating calls are below the lower bound, cooling calls are above
+    // the upper bound; in Heat and Cool modes, both bounds are the same.
+    // =========================================================================
+    class ControlBand
+    {
+    public:
+
+        enum Position
+        {
+            Below,
+            Within,
+            Above
+        };
+
+        Mode mode() const;
+        Thermometer::KelvinUnit lower() const;
+        Thermometer::KelvinUnit upper() const;
+
+        Position position(Thermometer::KelvinUnit const &temperature) const;
+
+        static ControlBand Compile(Mode const mode,
+                                   Thermometer::TemperatureUnit const &targetTemperature,
+                                   TemperatureThreshold const &targetTemperatureThreshold);
+
+    protected:
+
+        Mode _mode;
+        Thermometer::KelvinUnit _lower;
+        Thermometer::KelvinUnit _upper;
+
+        ControlBand(Mode const mode,
+                    Thermometer::KelvinUnit const &lower,
+                    Thermometer::KelvinUnit const &upper);
+    };
+
+    // =========================================================================
+    // Command : Settings changed together, as asked for by a remote client;
+    // only the settings set on the command are changed, in the order below.
+    // =========================================================================
+    class Command
+    {
+    public:
+
+        // Ids are given out as commands are submitted, counting up from 1.
+        uint32_t id() const;
+
+        void setMode(Mode const mode);
+        void setTargetTemperature(Thermometer::TemperatureUnit const &targetTemperature,
+                                  TemperatureThreshold const &targetTemperatureThreshold);
+        void setPerceptionIndex(PerceptionIndex const perceptionIndex);
+
+        bool empty() const;
+
+        // Whether thresholds are positive, of a known scale, and targets
+        // between 40F and 100F.
+        // NOTE: Modes and perception indices are checked as they're parsed,
+        // not here; values cast to them from out of range numbers aren't ones.
+        bool valid() const;
+
+        // The command asked for by /control's arguments, any of which may be
+        // null or empty, or unknown, leaving its setting unset: a mode ("off",
+        // "heat", "cool", "auto", or 0 to 3), a target temperature with its
+        // scale ("72F", "22.5C"), and a perception index ("T" or "HI", or 0
+        // and 1). Targets hold within a degree in Auto, and half a degree
+        // otherwise, of the same scale; in the current mode, if none is set.
+        static Command Parse(char const * const mode,
+                             char const * const temperature,
+                             char const * const type,
+                             Mode const current);
+
+        Command();
+
+    protected:
+
+        friend class Thermostat;
+
+        enum Setting
+        {
+            ModeSetting = 1 << 0,
+            TargetSetting = 1 << 1,
+            PerceptionSetting = 1 << 2
+        };
+
+        uint32_t _id;
+        uint8_t _settings;
+        Mode _mode;
+        Thermometer::TemperatureUnit _targetTemperature;
+        TemperatureThreshold _targetTemperatureThreshold;
+        PerceptionIndex _perceptionIndex;
+    };
+
+    // =========================================================================
+    // Snapshot : The thermostat's status as of when it was published, kept
+    // serialized as JSON, with an entity tag of its content for HTTP caching.
+    // Snapshots never change once published; newer ones replace them, stamped
+    // with the next version.
+    // =========================================================================
+    class Snapshot
+    {
+    public:
+
+        uint32_t version() const;
+
+        // The JSON, null terminated, and its length.
+        char const *data() const;
+        std::size_t size() const;
+
+        // The entity tag, quoted; it's a hash of the JSON, so identical
+        // statuses are tagged the same, even across restarts.
+        char const *etag() const;
+
+        // Writes the JSON, null terminated, with the id of a command just
+        // submitted added to its command object; returns its length. Buffers
+        // of Capacity hold any.
+        static constexpr std::size_t Capacity = 288;
+        std::size_t write(char * const buffer, std::size_t const capacity, uint32_t const submitted) const;
+
+        bool operator==(Snapshot const &other) const;
+
+        Snapshot(Thermostat const &thermostat, uint32_t const version);
+
+    protected:
+
+        static constexpr std::size_t _Capacity = 256;
+
+        uint32_t _version;
+        uint16_t _size;
+        uint16_t _command;      // Where the command object's closing brace is.
+        char _etag[11];
+        char _data[_Capacity];
+    };
+
     // ================================================================
     // Thermostat Members
     // ================================================================
@@ -88,14 +252,17 @@ public:
     
     Status status() const;
     
+    // NOTE: The following methods don't sense; they're derived from the
+    // thermometers' samples, which are taken once at the start of each cycle.
+
     // This method returns the average humidity of all thermometers.
-    Thermometer::TemperatureUnit::value_type humidity();
+    Thermometer::TemperatureUnit::value_type humidity() const;
     
     // This method returns the average humiture of all thermometers.
-    Thermometer::TemperatureUnit humiture();
+    Thermometer::TemperatureUnit humiture() const;
     
     // This method returns the average temperature of all thermometers.
-    Thermometer::TemperatureUnit temperature();
+    Thermometer::TemperatureUnit temperature() const;
     
     Thermometer::TemperatureUnit targetTemperature() const;
     void setTargetTemperature(Thermometer::TemperatureUnit const &targetTemperature);
@@ -105,7 +272,75 @@ public:
 
     PerceptionIndex perceptionIndex() const;
     void setPerceptionIndex(PerceptionIndex const perceptionIndex = TemperatureIndex);
+
+    ControlBand const &controlBand() const;
+
+    // The zone's smoothed values; every cycle with fresh samples feeds the
+    // average of the thermometers' smoothed temperatures, and the average
+    // humiture, through filters rejecting outliers and averaging the rest.
+    Thermometer::TemperatureUnit smoothedTemperature() const;
+    Thermometer::TemperatureUnit smoothedHumiture() const;
+
+    Aggregation aggregation() const;
+    void setAggregation(Aggregation const aggregation = Mean);
+
+    // When non-zero, every cycle requests readings from all thermometers at
+    // once and waits up to this long (in microseconds) for them to arrive,
+    // rather than reading each thermometer in turn. Late readings are stale.
+    Scheduler::Time acquisitionTimeout() const;
+    void setAcquisitionTimeout(Scheduler::Time const acquisitionTimeout = 0);
+
+    // When non-zero, a thermometer whose last good reading is older than this
+    // (in microseconds) is left out of averages. Thermometers that have never
+    // read are always left out; with none left, the thermostat stands by.
+    Scheduler::Time readingAgeLimit() const;
+    void setReadingAgeLimit(Scheduler::Time const readingAgeLimit = 0);
     
+    // Periodic thermostats evaluate their control law every cycle. Thermostats
+    // evaluating on change do as well, but also become their thermometers'
+    // delegates, and re-evaluate as soon as a sample moves the temperature to
+    // another part of the control band, or the settings change; otherwise,
+    // samples are only filtered. Thermometers must be sampling themselves for
+    // this (see Thermometer::setSamplingInterval), which lets the thermostat's
+    // own cycle be made long, as a safety net.
+    // NOTE: Thermometers added later are only followed once this is set again.
+    Evaluation evaluation() const;
+    void setEvaluation(Evaluation const evaluation = Periodic);
+
+    // Every evaluation is recorded in the history, along with the readings and
+    // settings it was made with; entries' modes and statuses are a Mode and a
+    // Status, and their patterns the signal lines called, in pinout order.
+    CycleHistory const &history() const;
+
+    // Programs set the target temperature as each of their setpoints comes
+    // into effect, as told by the clock (local time, see SetpointProgram). The
+    // thermostat wakes only at the program's transitions, or every hour at
+    // least, as Scheduler::Time wraps around; targets set in between hold until
+    // the next transition. Clocks default to the system's, where there's one.
+    // Returns false if there's no clock to follow the program by.
+    std::shared_ptr<SetpointProgram const> const &program() const;
+    bool setProgram(std::shared_ptr<SetpointProgram const> const &program,
+                    SetpointProgram::Clock const &clock = SetpointProgram::Clock());
+
+    // Commands are checked and queued rather than applied, so that whoever
+    // submits them never waits on the thermostat; the thermostat's scheduler
+    // applies them on its next update, then re-evaluates the control law on
+    // the samples at hand, without sensing anew. Returns the command's id, or
+    // 0 if it's invalid, empty, or the queue is full.
+    // NOTE: Commands must be submitted from the thread updating the thermostat.
+    uint32_t submit(Command const &command);
+
+    // The id of the last command applied, and of the last submitted.
+    uint32_t appliedCommand() const;
+    uint32_t submittedCommand() const;
+
+    // The status as of the last evaluation or change of settings; it's only
+    // republished, under a new version, when it reads differently. Readers
+    // hold on to the snapshot they got, which stays as it was, so serving it
+    // never senses nor waits on the thermostat.
+    // NOTE: Snapshots may be taken from any thread.
+    std::shared_ptr<Snapshot const> snapshot() const;
+
     int update(Scheduler::Time const time);
     
     // The pin order is as follows by default: {FAN call, COOL call, HEAT call}
@@ -116,24 +351,194 @@ public:
     virtual ~Thermostat();
     
 protected:
+    // =========================================================================
+    // Collector: A Daemon awaiting the readings requested from all thermometers
+    // at once, which completes the control cycle as soon as every reading has
+    // arrived, or the acquisition timeout has elapsed, whichever's first.
+    // =========================================================================
+    class Collector : public Scheduler::Daemon
+    {
+    public:
+
+        bool collecting() const;
+        bool start(Scheduler::Time const time);
+
+        int execute(Scheduler::Time const time);
+        bool finished() const;
+
+        Collector(Thermostat &thermostat);
+        virtual ~Collector();
+
+    protected:
+
+        Thermostat &_thermostat;
+        Scheduler::Time _startTime;
+        bool _collecting;
+    };
+
+    // =========================================================================
+    // Programmer: A Daemon applying the program's setpoints as they come into
+    // effect, rescheduling itself for the next transition.
+    // =========================================================================
+    class Programmer : public Scheduler::Daemon
+    {
+    public:
+
+        bool start(Scheduler::Time const time);
+
+        int execute(Scheduler::Time const time);
+        bool finished() const;
+
+        Programmer(Thermostat &thermostat);
+        virtual ~Programmer();
+
+    protected:
+
+        // The longest the programmer sleeps for, in seconds.
+        static constexpr SetpointProgram::Time _SleepLimit = 3600;
+
+        Thermostat &_thermostat;
+        SetpointProgram::Setpoint _setpoint;    // The setpoint last applied.
+        bool _applied;
+    };
+
+    // =========================================================================
+    // Dispatcher: An Event applying the commands queued, scheduled as soon as
+    // the queue has any.
+    // =========================================================================
+    class Dispatcher : public Scheduler::Event
+    {
+    public:
+
+        bool start(Scheduler::Time const time);
+
+        int execute(Scheduler::Time const time);
+
+        Dispatcher(Thermostat &thermostat);
+        virtual ~Dispatcher();
+
+    protected:
+
+        Thermostat &_thermostat;
+    };
+
     Thermometer::TemperatureUnit _targetTemperature;
     TemperatureThreshold _targetTemperatureThreshold;
     PerceptionIndex _perceptionIndex;
     Status _status;
     Mode _mode;
+    ControlBand _band;
+
+    // =========================================================================
+    // Decision : What the thermostat does for a mode and band position; the
+    // signal lines to call, as an Actuator::Pattern, and the resulting status.
+    // Decisions are looked up in _Decisions, by [Mode][ControlBand::Position];
+    // more equipment stages are more SignalLines and rows, not more branches.
+    // =========================================================================
+    struct Decision
+    {
+        Actuator::Pattern pattern;
+        Status status;
+    };
+
+    static constexpr Actuator::Pattern _FanCall = Actuator::Pattern(1) << Thermostat::SignalLine::FanCall;
+    static constexpr Actuator::Pattern _CoolCall = Actuator::Pattern(1) << Thermostat::SignalLine::CoolCall;
+    static constexpr Actuator::Pattern _HeatCall = Actuator::Pattern(1) << Thermostat::SignalLine::HeatCall;
+
+    static constexpr Decision _Decisions[4][3] = {
+        // Below                             Within                   Above
+        {{0, Standby},                       {0, Standby},            {0, Standby}},                        // Off
+        {{_FanCall | _HeatCall, Heating},    {0, Standby},            {0, Standby}},                        // Heat
+        {{0, Standby},                       {0, Standby},            {_FanCall | _CoolCall, Cooling}},     // Cool
+        {{_FanCall | _HeatCall, Heating},    {0, Stasis},             {_FanCall | _CoolCall, Cooling}}      // Auto
+    };
+
+    // Unknown modes are decided as Off.
+    static Decision const &_Decide(Mode const mode, ControlBand::Position const position);
+
+    // Fleets decide their zones with the same table.
+    friend class ThermostatFleet;
 
     Actuator _controller;
 
     Scheduler _scheduler;
+
+    Scheduler::Time _acquisitionTimeout;
+    Collector _collector;
+
+    Scheduler::Time _readingAgeLimit;
+
+    Aggregation _aggregation;
+    Thermometer::TemperatureFilter _temperatureFilter;
+    Thermometer::TemperatureFilter _humitureFilter;
+
+    Evaluation _evaluation;
+    ControlBand::Position _position;    // As of the last evaluation.
+    bool _changed;                      // Settings changed since then.
+    bool _sampling;                     // Sampling thermometers for a cycle.
+
+    // The thermometers' sample sequences as of the last filtered round.
+    std::vector<uint32_t> _roundSequences;
+
+    CycleHistory _history;
+
+    std::shared_ptr<SetpointProgram const> _program;
+    SetpointProgram::Clock _programClock;
+    Programmer _programmer;
+
+    // The commands queued, in a ring, as kept in RAM on small devices.
+    static constexpr uint8_t _CommandsMax = 8;
+    Command _commands[_CommandsMax];
+    uint8_t _commandsFirst;
+    uint8_t _commandsCount;
+    uint32_t _submittedCommand;
+    uint32_t _appliedCommand;
+    Dispatcher _dispatcher;
+
+    std::shared_ptr<Snapshot const> _snapshot;
     
-    Status _standby(Status const status = Standby);
-    Status _setCooler(bool const cool);
-    Status _setHeater(bool const heat);
+    void _sampleThermometers(Scheduler::Time const time);
+
+    // Eligible thermometers have read, and not too long ago, per their health.
+    // Stale samples are only left out of averages if fresh ones are available.
+    bool _eligible(Thermometer const &thermometer) const;
+    bool _eligibleSamples() const;
+    bool _freshSamples() const;
+    bool _excluded(Thermometer const &thermometer, bool const freshSamples) const;
+
+    // Filtering takes in a round of samples, recording it as the last; a round
+    // is complete once every thermometer sampling itself has been since.
+    void _filter();
+    bool _roundComplete() const;
+    int _control(Scheduler::Time const updateTime);
+
+    // The temperature perceived, as of the latest samples, that is controlled.
+    Thermometer::KelvinUnit _perceived() const;
+    int _evaluate(Scheduler::Time const updateTime);
+
+    // Re-evaluates when evaluating on change, and something did; _reconsider
+    // does regardless of the evaluation, when it can act on the samples.
+    void _react(Scheduler::Time const time);
+    void _reconsider(Scheduler::Time const time);
+    void _settingsChanged();
+
+    // Serializes the status, replacing the snapshot if it reads differently.
+    void _publish();
+
+    // Transitions the signal lines to the decision's, returning its status.
+    Status _apply(Decision const &decision);
+    Status _standby();
     
     // ================================================================
     // Scheduler::Event Methods
     // ================================================================
     int execute(Scheduler::Time const updateTime);
+
+    // ================================================================
+    // ThermometerDelegate Methods
+    // ================================================================
+    void thermometerSampled(Thermometer * const thermometer,
+                            Thermometer::Sample const &sample);
 };
 
 #endif /* Thermostat_hpp */
@@ -28,6 +28,10 @@
 #include "DHT22.hpp"
 #include "Pin.hpp"
 
+#if defined(MJB_LINUX_EPOLL)
+#include "ControlServer.hpp"
+#endif
+
 
 #warning Remember to remove your access point data before commiting!
 #if defined(MJB_ARDUINO_LIB_API)
@@ -56,7 +60,13 @@ Thermostat thermostat(Pin::Arrangement({
 ESP8266WebServer server(80);
 
 String GetContentType(String const filename);
-String GetStatusData();
+String GetStatusData(uint32_t const submitted = 0);
+#endif
+
+#if defined(MJB_LINUX_EPOLL)
+// Hosts serve the thermostat, as zone 0, on an unprivileged port.
+uint16_t const controlServerPort = 8080;
+ControlServer controlServer;
 #endif
 
 void setup()
@@ -69,6 +79,16 @@ void setup()
     thermostat.setTargetTemperature(Thermometer::TemperatureUnit(72, Thermometer::TemperatureUnit::Scale::Fahrenheit));
     thermostat.setMode(Thermostat::Mode::Auto);
 
+#if defined(MJB_LINUX_EPOLL)
+    controlServer.add(0, thermostat);
+    
+    if (!controlServer.listen(controlServerPort))
+    {
+        MJB_DEBUG_LOG("[Server] Unable to listen on port ");
+        MJB_DEBUG_LOG_LINE(controlServerPort);
+    }
+#endif
+
 #if defined(MJB_ARDUINO_LIB_API)
     // Begin WiFi configuration and do not continue until we've connected successfully.
     MJB_DEBUG_LOG_LINE("[WIFI] Setting radio configuration, please wait...");
@@ -108,7 +128,16 @@ void setup()
     });
     
     server.on("/status", []() {
-        server.send(200, "application/json", GetStatusData());
+        // Served as published by the thermostat's last cycle; nothing is sensed.
+        std::shared_ptr<Thermostat::Snapshot const> const snapshot = thermostat.snapshot();
+        server.sendHeader("ETag", snapshot->etag());
+        
+        if (server.header("If-None-Match").equals(snapshot->etag()))
+        {
+            server.send(304); return;
+        }
+        
+        server.send_P(200, "application/json", snapshot->data(), snapshot->size());
     });
     
     server.on("/control", []() {
@@ -117,67 +146,27 @@ void setup()
             server.send(200, "text/plain", "Thermostat's controller interface."); return;
         }
         
-        String const modeArgument = server.arg("mode");
-        if (modeArgument.length())
-        {
-            if (modeArgument.equals("auto") || modeArgument.equals("3"))
-                thermostat.setMode(Thermostat::Mode::Auto);
-            else
-            if (modeArgument.equals("cool") || modeArgument.equals("2"))
-                thermostat.setMode(Thermostat::Mode::Cool);
-            else
-            if (modeArgument.equals("heat") || modeArgument.equals("1"))
-                thermostat.setMode(Thermostat::Mode::Heat);
-            else
-            if (modeArgument.equals("off") || modeArgument.equals("0"))
-                thermostat.setMode(Thermostat::Mode::Off);
-        }
-        
-        String tempArgument = server.arg("temp");
-        if (tempArgument.length())
-        {
-            // Get the unit from the passed in temperature.
-            short scalePosition = tempArgument.indexOf("K");
-            if (scalePosition < 0) scalePosition = tempArgument.indexOf("F");
-            if (scalePosition < 0) scalePosition = tempArgument.indexOf("C");
-            
-            if (scalePosition > 0) // Check if it was found after 0, otherwise it's malformed.
-            {
-                Thermometer::TemperatureUnit::Scale const scale =
-                    static_cast<Thermometer::TemperatureUnit::Scale>(tempArgument[scalePosition]);
-                
-                tempArgument.remove(scalePosition); // Remove scale to parse value.
-                float const value = tempArgument.toFloat(); // Parse value, 0 COULD be failure.
-                
-                // Check if it's a proper value meaning it must not be zero, however,
-                // if it is 0 we must check it indeed was set and isn't an issue with parsing.
-                if (value || (tempArgument.length() == 1 && tempArgument[0] == '0'))
-                {
-                    Thermometer::TemperatureUnit::value_type temperatureThreshold =
-                        (thermostat.mode() == Thermostat::Mode::Auto)? 1.0000 : 0.5000;
-                    thermostat.setTargetTemperature(Thermometer::TemperatureUnit(value, scale));
-                    thermostat.setTargetTemperatureThreshold(std::make_pair(temperatureThreshold, scale));
-                }
-            }
-        }
+        // Changes are queued, and applied together on the thermostat's next
+        // update; the client learns the command's id to watch for it.
+        Thermostat::Command const command =
+            Thermostat::Command::Parse(server.arg("mode").c_str(),
+                                       server.arg("temp").c_str(),
+                                       server.arg("type").c_str(),
+                                       thermostat.mode());
         
-        String const tempTypeArgument = server.arg("type");
-        if (tempTypeArgument.length())
+        uint32_t const submitted = thermostat.submit(command);
+        if (!submitted)
         {
-            if (tempTypeArgument.equals("HI") || tempTypeArgument.equals("1"))
-                thermostat.setPerceptionIndex(Thermostat::PerceptionIndex::HeatIndex);
-            else
-            if (tempTypeArgument.equals("T") || tempTypeArgument.equals("0"))
-                thermostat.setPerceptionIndex(Thermostat::PerceptionIndex::TemperatureIndex);
+            server.send(400, "text/plain", "Invalid or too many commands!"); return;
         }
         
-        // Push changes by manually updating the instance.
-        // This will reflect changes immediately which will be sent as JSON.
-        thermostat.update(micros());
-        
-        server.send(200, "application/json", GetStatusData());
+        server.send(200, "application/json", GetStatusData(submitted));
     });
     
+    // Headers are only kept if asked for, for conditional status requests.
+    char const *collectedHeaders[] = {"If-None-Match"};
+    server.collectHeaders(collectedHeaders, 1);
+    
     SPIFFS.begin();
     
     server.begin();
@@ -201,6 +190,11 @@ void loop()
     
     server.handleClient();
 #endif
+
+#if defined(MJB_LINUX_EPOLL)
+    // Requests are answered between updates, on the scheduler's thread.
+    controlServer.serve();
+#endif
     
 #ifdef MJB_DEBUG_LOGGING_CYCLE
     MJB_DEBUG_LOG("[Cycle] Completed at: ");
@@ -219,26 +213,14 @@ String GetContentType(String const filename)
     return "text/plain";
 }
 
-String GetStatusData()
+String GetStatusData(uint32_t const submitted)
 {
-    String statusData;
-    statusData += "{\"temperature\": {\"current\":";
-    statusData += thermostat.temperature().value();
-    statusData += ",\"target\":";
-    statusData += thermostat.targetTemperature().value();
-    statusData += ",\"scale\":\"K\",\"delay\":\"?\"}";
-    statusData += ",\"humiture\":";
-    statusData += thermostat.humiture().value();
-    statusData += ",\"measurement\":";
-    statusData += thermostat.perceptionIndex();
-    statusData += ",\"humidity\":{\"current\":";
-    statusData += thermometer->humidity();
-    statusData += "},\"mode\":";
-    statusData += thermostat.mode();
-    statusData += ",\"status\":";
-    statusData += thermostat.status();
-    statusData += "}";
-    return statusData;
+    std::shared_ptr<Thermostat::Snapshot const> const snapshot = thermostat.snapshot();
+    if (!submitted) return String(snapshot->data());
+    
+    char statusData[Thermostat::Snapshot::Capacity];
+    snapshot->write(statusData, sizeof(statusData), submitted);
+    return String(statusData);
 }
 #endif
 
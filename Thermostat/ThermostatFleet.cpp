@@ -0,0 +1,257 @@
+//
+//  ThermostatFleet.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "ThermostatFleet.hpp"
+
+// =============================================================================
+// ThermostatFleet::Zone : Implementation
+// =============================================================================
+ThermostatFleet::Index ThermostatFleet::Zone::index() const
+{
+    return _index;
+}
+
+Thermostat::Mode ThermostatFleet::Zone::mode() const
+{
+    return static_cast<Thermostat::Mode>(_fleet._modes[_index]);
+}
+
+void ThermostatFleet::Zone::setMode(Thermostat::Mode const mode)
+{
+    _fleet._modes[_index] = mode;
+    _fleet._compile(_index);
+}
+
+Thermostat::Status ThermostatFleet::Zone::status() const
+{
+    return static_cast<Thermostat::Status>(_fleet._outcomes[_index] >> ThermostatFleet::_OutcomeStatusShift);
+}
+
+Actuator::Pattern ThermostatFleet::Zone::pattern() const
+{
+    return _fleet._outcomes[_index] & ThermostatFleet::_OutcomePatternMask;
+}
+
+Thermometer::TemperatureUnit::value_type ThermostatFleet::Zone::humidity() const
+{
+    return _fleet._humidities[_index];
+}
+
+Thermometer::TemperatureUnit ThermostatFleet::Zone::humiture() const
+{
+    return Thermometer::TemperatureUnit(TemperatureKernels::Humiture(_fleet._temperatures[_index], _fleet._humidities[_index]));
+}
+
+Thermometer::TemperatureUnit ThermostatFleet::Zone::temperature() const
+{
+    return Thermometer::TemperatureUnit(_fleet._temperatures[_index]);
+}
+
+void ThermostatFleet::Zone::setReading(Thermometer::TemperatureUnit const &temperature,
+                                       Thermometer::TemperatureUnit::value_type const humidity)
+{
+    _fleet._temperatures[_index] = static_cast<float>(temperature.value());
+    _fleet._humidities[_index] = static_cast<float>(humidity);
+    _fleet._readings[_index] = true;
+}
+
+Thermometer::TemperatureUnit ThermostatFleet::Zone::targetTemperature() const
+{
+    return Thermometer::TemperatureUnit(_fleet._targets[_index]);
+}
+
+void ThermostatFleet::Zone::setTargetTemperature(Thermometer::TemperatureUnit const &targetTemperature)
+{
+    _fleet._targets[_index] = static_cast<float>(targetTemperature.value());
+    _fleet._compile(_index);
+}
+
+Thermostat::TemperatureThreshold ThermostatFleet::Zone::targetTemperatureThreshold() const
+{
+    return std::make_pair(Thermometer::TemperatureUnit::value_type(_fleet._thresholds[_index]),
+                          static_cast<Thermometer::TemperatureUnit::Scale>(_fleet._thresholdScales[_index]));
+}
+
+void ThermostatFleet::Zone::setTargetTemperatureThreshold(Thermostat::TemperatureThreshold const &targetTemperatureThreshold)
+{
+    _fleet._thresholds[_index] = static_cast<float>(targetTemperatureThreshold.first);
+    _fleet._thresholdScales[_index] = targetTemperatureThreshold.second;
+    _fleet._compile(_index);
+}
+
+Thermostat::PerceptionIndex ThermostatFleet::Zone::perceptionIndex() const
+{
+    return static_cast<Thermostat::PerceptionIndex>(_fleet._perceptions[_index]);
+}
+
+void ThermostatFleet::Zone::setPerceptionIndex(Thermostat::PerceptionIndex const perceptionIndex)
+{
+    bool const heatIndex = (perceptionIndex == Thermostat::PerceptionIndex::HeatIndex);
+
+    if (heatIndex == (_fleet._perceptions[_index] == Thermostat::PerceptionIndex::HeatIndex)) return;
+
+    _fleet._heatIndexZones += heatIndex? 1 : -1;
+    _fleet._perceptions[_index] = perceptionIndex;
+}
+
+Thermostat::ControlBand ThermostatFleet::Zone::controlBand() const
+{
+    return Thermostat::ControlBand::Compile(mode(), targetTemperature(), targetTemperatureThreshold());
+}
+
+ThermostatFleet::Zone::Zone(ThermostatFleet &fleet, ThermostatFleet::Index const index):
+_fleet(fleet),
+_index(index)
+{
+
+}
+
+// =============================================================================
+// ThermostatFleet : Implementation
+// =============================================================================
+ThermostatFleet::Index ThermostatFleet::size() const
+{
+    return static_cast<ThermostatFleet::Index>(_modes.size());
+}
+
+void ThermostatFleet::reserve(ThermostatFleet::Index const size)
+{
+    _targets.reserve(size);
+    _thresholds.reserve(size);
+    _thresholdScales.reserve(size);
+    _modes.reserve(size);
+    _perceptions.reserve(size);
+    _lowers.reserve(size);
+    _uppers.reserve(size);
+    _belowOutcomes.reserve(size);
+    _withinOutcomes.reserve(size);
+    _aboveOutcomes.reserve(size);
+    _temperatures.reserve(size);
+    _humidities.reserve(size);
+    _humitures.reserve(size);
+    _readings.reserve(size);
+    _outcomes.reserve(size);
+}
+
+ThermostatFleet::Zone ThermostatFleet::add()
+{
+    Thermometer::TemperatureUnit const target; // 72F, as a new Thermostat's.
+
+    _targets.push_back(static_cast<float>(target.value()));
+    _thresholds.push_back(1);
+    _thresholdScales.push_back(Thermometer::TemperatureUnit::Scale::Fahrenheit);
+    _modes.push_back(Thermostat::Mode::Off);
+    _perceptions.push_back(Thermostat::PerceptionIndex::TemperatureIndex);
+    _lowers.push_back(0);
+    _uppers.push_back(0);
+    _belowOutcomes.push_back(0);
+    _withinOutcomes.push_back(0);
+    _aboveOutcomes.push_back(0);
+    _temperatures.push_back(0);
+    _humidities.push_back(0);
+    _humitures.push_back(0);
+    _readings.push_back(false);
+    _outcomes.push_back(ThermostatFleet::_Outcome(Thermostat::_Decide(Thermostat::Mode::Off, Thermostat::ControlBand::Position::Within)));
+
+    ThermostatFleet::Index const index = size() - 1;
+    _compile(index);
+    return ThermostatFleet::Zone(*this, index);
+}
+
+ThermostatFleet::Zone ThermostatFleet::zone(ThermostatFleet::Index const index)
+{
+    return ThermostatFleet::Zone(*this, index);
+}
+
+void ThermostatFleet::setReadings(ThermostatFleet::Index const first,
+                                  ThermostatFleet::Index const count,
+                                  float const * const temperatures,
+                                  float const * const humidities)
+{
+    for (ThermostatFleet::Index index = 0; (index < count) && ((first + index) < size()); index++)
+    {
+        _temperatures[first + index] = temperatures[index];
+        _humidities[first + index] = humidities[index];
+        _readings[first + index] = true;
+    }
+}
+
+ThermostatFleet::Index ThermostatFleet::evaluate()
+{
+    ThermostatFleet::Index const count = size();
+
+    // Humitures are only worth computing if some zone perceives them.
+    if (_heatIndexZones) TemperatureKernels::Humiture(_temperatures.data(), _humidities.data(), _humitures.data(), count);
+
+    float const * const temperatures = _temperatures.data();
+    float const * const humitures = _humitures.data();
+    float const * const lowers = _lowers.data();
+    float const * const uppers = _uppers.data();
+    uint8_t const * const perceptions = _perceptions.data();
+    uint8_t const * const readings = _readings.data();
+    ThermostatFleet::Outcome const * const belowOutcomes = _belowOutcomes.data();
+    ThermostatFleet::Outcome const * const withinOutcomes = _withinOutcomes.data();
+    ThermostatFleet::Outcome const * const aboveOutcomes = _aboveOutcomes.data();
+    ThermostatFleet::Outcome * const outcomes = _outcomes.data();
+
+    ThermostatFleet::Outcome const standby = ThermostatFleet::_Outcome(Thermostat::_Decide(Thermostat::Mode::Off, Thermostat::ControlBand::Position::Within));
+
+    // The same decision as Thermostat's, without branches, so that zones are
+    // decided a vector at a time: the zone's band gives its position, and the
+    // position picks one of the outcomes compiled from the decision table.
+    for (ThermostatFleet::Index index = 0; index < count; index++)
+    {
+        // Everything's loaded up front, so that picking is a blend of values.
+        float const temperature = temperatures[index];
+        float const humiture = humitures[index];
+        float const lower = lowers[index];
+        float const upper = uppers[index];
+        ThermostatFleet::Outcome const below = belowOutcomes[index];
+        ThermostatFleet::Outcome const within = withinOutcomes[index];
+        ThermostatFleet::Outcome const above = aboveOutcomes[index];
+
+        float const current = perceptions[index]? humiture : temperature;
+        ThermostatFleet::Outcome const outcome = (current < lower)? below : ((current > upper)? above : within);
+
+        // Without a reading, don't act on made up (zero) temperatures.
+        outcomes[index] = readings[index]? outcome : standby;
+    }
+
+    return count;
+}
+
+void ThermostatFleet::_compile(ThermostatFleet::Index const index)
+{
+    Thermostat::Mode const mode = static_cast<Thermostat::Mode>(_modes[index]);
+    Thermostat::ControlBand const band = Thermostat::ControlBand::Compile(mode,
+                                                                          Thermometer::TemperatureUnit(_targets[index]),
+                                                                          Zone(*this, index).targetTemperatureThreshold());
+
+    _lowers[index] = static_cast<float>(band.lower().value());
+    _uppers[index] = static_cast<float>(band.upper().value());
+
+    _belowOutcomes[index] = ThermostatFleet::_Outcome(Thermostat::_Decide(mode, Thermostat::ControlBand::Position::Below));
+    _withinOutcomes[index] = ThermostatFleet::_Outcome(Thermostat::_Decide(mode, Thermostat::ControlBand::Position::Within));
+    _aboveOutcomes[index] = ThermostatFleet::_Outcome(Thermostat::_Decide(mode, Thermostat::ControlBand::Position::Above));
+}
+
+ThermostatFleet::Outcome ThermostatFleet::_Outcome(Thermostat::Decision const &decision)
+{
+    // NOTE: Fleets only cover signal lines that fit in an outcome's pattern.
+    return static_cast<ThermostatFleet::Outcome>((decision.pattern & ThermostatFleet::_OutcomePatternMask) |
+                                                 (decision.status << ThermostatFleet::_OutcomeStatusShift));
+}
+
+// =============================================================================
+// ThermostatFleet : Constructors & Destructor
+// =============================================================================
+ThermostatFleet::ThermostatFleet():
+_heatIndexZones(0)
+{
+
+}
@@ -0,0 +1,153 @@
+//
+//  ThermostatFleet.hpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef ThermostatFleet_hpp
+#define ThermostatFleet_hpp
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "Development.hpp"
+#include "Temperature.hpp"
+#include "TemperatureKernels.hpp"
+#include "Thermometer.hpp"
+#include "Thermostat.hpp"
+#include "Actuator.hpp"
+
+// =============================================================================
+// ThermostatFleet : This class runs the Thermostat's control law over many
+// zones at once, as a server managing a building's (or a city's) worth of
+// zones would. Zones keep no thermometers, pins, or schedulers; their state
+// is held in one array per field (a struct-of-arrays), readings are given to
+// them, and every evaluation decides all zones in a single pass, leaving each
+// zone's relay pattern (see Actuator::Pattern) for the caller to apply.
+// NOTE: Values are stored as floats, Kelvin, regardless of the TemperatureUnit
+// in use; humitures are those of TemperatureKernels, which match Thermometer's.
+// =============================================================================
+class ThermostatFleet
+{
+public:
+    typedef uint32_t Index;
+
+    // =========================================================================
+    // Zone : A zone of the fleet, with the interface of a Thermostat; zones are
+    // only references into the fleet, and are as cheap to make as to copy.
+    // NOTE: Adding zones to the fleet may move them, but never reindexes them.
+    // =========================================================================
+    class Zone
+    {
+    public:
+
+        Index index() const;
+
+        Thermostat::Mode mode() const;
+        void setMode(Thermostat::Mode const mode = Thermostat::Mode::Off);
+
+        // The status the last evaluation left the zone in.
+        Thermostat::Status status() const;
+
+        // The signal lines the last evaluation called, in pinout order.
+        Actuator::Pattern pattern() const;
+
+        Thermometer::TemperatureUnit::value_type humidity() const;
+        Thermometer::TemperatureUnit humiture() const;
+        Thermometer::TemperatureUnit temperature() const;
+
+        // Readings are taken into account by the next evaluation; until its
+        // first reading, a zone stands by.
+        void setReading(Thermometer::TemperatureUnit const &temperature,
+                        Thermometer::TemperatureUnit::value_type const humidity);
+
+        Thermometer::TemperatureUnit targetTemperature() const;
+        void setTargetTemperature(Thermometer::TemperatureUnit const &targetTemperature);
+
+        Thermostat::TemperatureThreshold targetTemperatureThreshold() const;
+        void setTargetTemperatureThreshold(Thermostat::TemperatureThreshold const &targetTemperatureThreshold);
+
+        Thermostat::PerceptionIndex perceptionIndex() const;
+        void setPerceptionIndex(Thermostat::PerceptionIndex const perceptionIndex = Thermostat::PerceptionIndex::TemperatureIndex);
+
+        Thermostat::ControlBand controlBand() const;
+
+        Zone(ThermostatFleet &fleet, Index const index);
+
+    protected:
+
+        ThermostatFleet &_fleet;
+        Index _index;
+    };
+
+    Index size() const;
+    void reserve(Index const size);
+
+    // New zones are set up like new Thermostats: off, targeting 72F +/- 1F.
+    Zone add();
+    Zone zone(Index const index);
+
+    // Sets the readings of count zones, starting at first, from buffers of
+    // temperatures (Kelvin) and humidities (percentages).
+    void setReadings(Index const first,
+                     Index const count,
+                     float const * const temperatures,
+                     float const * const humidities);
+
+    // Decides every zone with the control law of Thermostat, returning the
+    // number of zones evaluated.
+    Index evaluate();
+
+    // The memory a zone takes up in the fleet, in bytes.
+    static constexpr std::size_t ZoneSize();
+
+    ThermostatFleet();
+
+protected:
+
+    // An outcome is a decision of the Thermostat, packed in a byte; the pattern
+    // is held in the lower bits, the status in the upper two.
+    typedef uint8_t Outcome;
+
+    static constexpr unsigned _OutcomeStatusShift = 6;
+    static constexpr Outcome _OutcomePatternMask = (Outcome(1) << _OutcomeStatusShift) - 1;
+
+    // Settings, as given.
+    std::vector<float> _targets;            // Kelvin.
+    std::vector<float> _thresholds;         // In the threshold's scale.
+    std::vector<uint8_t> _thresholdScales;
+    std::vector<uint8_t> _modes;
+    std::vector<uint8_t> _perceptions;
+
+    // Settings, compiled; the zone's control band, in Kelvin, and the outcome
+    // for a temperature below, within, or above it.
+    std::vector<float> _lowers;
+    std::vector<float> _uppers;
+    std::vector<Outcome> _belowOutcomes;
+    std::vector<Outcome> _withinOutcomes;
+    std::vector<Outcome> _aboveOutcomes;
+
+    // Readings.
+    std::vector<float> _temperatures;       // Kelvin.
+    std::vector<float> _humidities;
+    std::vector<float> _humitures;          // Kelvin, computed by evaluations.
+    std::vector<uint8_t> _readings;         // Whether the zone has read at all.
+
+    // Results.
+    std::vector<Outcome> _outcomes;
+
+    Index _heatIndexZones;  // Zones perceiving heat index, needing humitures.
+
+    void _compile(Index const index);
+
+    static Outcome _Outcome(Thermostat::Decision const &decision);
+};
+
+constexpr std::size_t ThermostatFleet::ZoneSize()
+{
+    return (sizeof(float) * 7) + (sizeof(uint8_t) * 4) + (sizeof(ThermostatFleet::Outcome) * 4);
+}
+
+#endif /* ThermostatFleet_hpp */
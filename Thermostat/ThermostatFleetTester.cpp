@@ -0,0 +1,186 @@
+//
+//  ThermostatFleetTester.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "Development.hpp"
+
+#if ! defined(MJB_ARDUINO_LIB_API)
+
+#include <random>
+#include <vector>
+#include "ThermostatFleet.hpp"
+#include "Testing.hpp"
+
+static Scheduler::Time now = 0;
+
+Scheduler::Time micros()
+{
+    return now;
+}
+
+typedef Thermometer::TemperatureUnit TemperatureUnit;
+
+// Reads whatever it's been set to.
+class Fixed : public Thermometer
+{
+public:
+
+    void set(TemperatureUnit const &temperature, TemperatureUnit::value_type const humidity)
+    {
+        _reading = temperature;
+        _relativeHumidity = humidity;
+    }
+
+    Sensor::Data sense()
+    {
+        _temperature = _reading;
+        _humidity = _relativeHumidity;
+        _recordReading();
+        return Sensor::Data();
+    }
+
+    Fixed():
+    Thermometer({})
+    {
+
+    }
+
+protected:
+
+    TemperatureUnit _reading;
+    TemperatureUnit::value_type _relativeHumidity;
+};
+
+static Thermostat::Mode const Modes[] = {
+    Thermostat::Mode::Off,
+    Thermostat::Mode::Heat,
+    Thermostat::Mode::Cool,
+    Thermostat::Mode::Auto
+};
+
+static TemperatureUnit::Scale const Scales[] = {
+    TemperatureUnit::Scale::Celsius,
+    TemperatureUnit::Scale::Fahrenheit,
+    TemperatureUnit::Scale::Kelvin
+};
+
+int main(int argc, const char * argv[])
+{
+    std::mt19937 random(41);
+    std::uniform_real_distribution<float> fahrenheit(40, 110);
+    std::uniform_real_distribution<float> humidity(0, 100);
+    std::uniform_real_distribution<float> threshold(0.1f, 5);
+
+    // Zones decide as a Thermostat set up, and reading, alike does.
+    std::shared_ptr<Fixed> const thermometer = std::make_shared<Fixed>();
+    Thermostat thermostat({1, 2, 3}, {thermometer});
+
+    ThermostatFleet fleet;
+    ThermostatFleet::Zone zone = fleet.add();
+    MJB_CHECK(zone.status() == Thermostat::Status::Standby);
+
+    unsigned mismatches = 0;
+    for (std::size_t cycle = 0; cycle < 20000; cycle++)
+    {
+        Thermostat::Mode const mode = Modes[random() % 4];
+        Thermostat::PerceptionIndex const perception = (random() % 2)? Thermostat::PerceptionIndex::HeatIndex :
+                                                                       Thermostat::PerceptionIndex::TemperatureIndex;
+        TemperatureUnit const target(fahrenheit(random), TemperatureUnit::Scale::Fahrenheit);
+        Thermostat::TemperatureThreshold const band(threshold(random), Scales[random() % 3]);
+        TemperatureUnit const reading(fahrenheit(random), TemperatureUnit::Scale::Fahrenheit);
+        TemperatureUnit::value_type const relativeHumidity = humidity(random);
+
+        thermostat.setMode(mode);
+        thermostat.setPerceptionIndex(perception);
+        thermostat.setTargetTemperature(target);
+        thermostat.setTargetTemperatureThreshold(band);
+        thermometer->set(reading, relativeHumidity);
+        thermostat.update(now += 300000000);
+
+        zone.setMode(mode);
+        zone.setPerceptionIndex(perception);
+        zone.setTargetTemperature(target);
+        zone.setTargetTemperatureThreshold(band);
+        zone.setReading(reading, relativeHumidity);
+        fleet.evaluate();
+
+        if (zone.status() != thermostat.status()) mismatches++;
+    }
+
+    MJB_CHECK(!mismatches);
+
+    // Zones are independent of each other, and patterns call the lines.
+    ThermostatFleet::Zone heating = fleet.add();
+    ThermostatFleet::Zone cooling = fleet.add();
+    heating.setMode(Thermostat::Mode::Heat);
+    cooling.setMode(Thermostat::Mode::Cool);
+    heating.setReading(TemperatureUnit(60, TemperatureUnit::Scale::Fahrenheit), 40);
+    cooling.setReading(TemperatureUnit(80, TemperatureUnit::Scale::Fahrenheit), 40);
+    MJB_CHECK(fleet.evaluate() == 3);
+    MJB_CHECK(heating.status() == Thermostat::Status::Heating);
+    MJB_CHECK(cooling.status() == Thermostat::Status::Cooling);
+    MJB_CHECK(heating.pattern() & (Actuator::Pattern(1) << Thermostat::SignalLine::HeatCall));
+    MJB_CHECK(cooling.pattern() & (Actuator::Pattern(1) << Thermostat::SignalLine::CoolCall));
+
+    // Zones that never read stand by, whatever their mode.
+    ThermostatFleet::Zone unread = fleet.add();
+    unread.setMode(Thermostat::Mode::Auto);
+    fleet.evaluate();
+    MJB_CHECK(unread.status() == Thermostat::Status::Standby);
+
+    if (Testing::Benchmarking(argc, argv))
+    {
+        ThermostatFleet::Index const zones = 1000000;
+        std::size_t const rounds = 100;
+
+        for (Thermostat::PerceptionIndex const perception : {Thermostat::PerceptionIndex::TemperatureIndex,
+                                                             Thermostat::PerceptionIndex::HeatIndex})
+        {
+            ThermostatFleet large;
+            large.reserve(zones);
+
+            std::vector<float> temperatures(zones), humidities(zones);
+            for (ThermostatFleet::Index index = 0; index < zones; index++)
+            {
+                ThermostatFleet::Zone zone = large.add();
+                zone.setMode(Modes[index % 4]);
+                zone.setPerceptionIndex(perception);
+                temperatures[index] = static_cast<float>(TemperatureUnit(fahrenheit(random), TemperatureUnit::Scale::Fahrenheit).value());
+                humidities[index] = humidity(random);
+            }
+
+            large.setReadings(0, zones, temperatures.data(), humidities.data());
+
+            std::size_t evaluated = 0;
+            std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+            for (std::size_t round = 0; round < rounds; round++) evaluated += large.evaluate();
+            double const seconds = Testing::Seconds(start);
+
+            MJB_CHECK(evaluated == rounds * zones);
+
+            std::fprintf(stderr, "ThermostatFleet::evaluate (%s): %.0fM zones/s, %zu bytes/zone\n",
+                         (perception == Thermostat::PerceptionIndex::HeatIndex)? "heat index" : "temperature index",
+                         evaluated / seconds / 1e6,
+                         ThermostatFleet::ZoneSize());
+        }
+
+        // For comparison, a Thermostat per zone takes this much, before its
+        // thermometers, pins and scheduling are counted.
+        std::fprintf(stderr, "Thermostat: %zu bytes/zone\n", sizeof(Thermostat));
+    }
+
+    return Testing::Result("ThermostatFleetTester");
+}
+
+#else
+
+int main()
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,580 @@
+//
+//  ThermostatTester.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "Development.hpp"
+
+#if ! defined(MJB_ARDUINO_LIB_API)
+
+#include <cmath>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Thermostat.hpp"
+#include "Testing.hpp"
+
+static Scheduler::Time now = 1000;
+
+Scheduler::Time micros()
+{
+    return now;
+}
+
+typedef Thermometer::TemperatureUnit TemperatureUnit;
+
+// Reads 70F every time it's sensed, counting the times.
+class Fixed : public Thermometer
+{
+public:
+
+    std::size_t senses = 0;
+
+    Sensor::Data sense()
+    {
+        senses++;
+        _temperature = TemperatureUnit(70, TemperatureUnit::Scale::Fahrenheit);
+        _humidity = 40;
+        _recordReading();
+        return Sensor::Data();
+    }
+
+    Fixed():
+    Thermometer({})
+    {
+
+    }
+};
+
+// Reads 70F only once requested, its reply arriving after its delay, as the
+// test delivers it; silent ones never reply.
+class Delayed : public Thermometer
+{
+public:
+
+    Scheduler::Time const delay;
+    bool const silent;
+    std::size_t requests = 0;
+    Scheduler::Time requested = 0;
+
+    Sensor::Data sense()
+    {
+        return Sensor::Data();
+    }
+
+    void request()
+    {
+        requests++;
+        requested = now;
+        _awaiting = true;
+    }
+
+    bool pending() const
+    {
+        return _awaiting;
+    }
+
+    void deliver()
+    {
+        if (!_awaiting || silent || ((now - requested) < delay)) return;
+
+        _awaiting = false;
+        _temperature = TemperatureUnit(70, TemperatureUnit::Scale::Fahrenheit);
+        _humidity = 40;
+        _recordReading();
+    }
+
+    Delayed(Scheduler::Time const delay, bool const silent = false):
+    Thermometer({}),
+    delay(delay),
+    silent(silent)
+    {
+
+    }
+
+protected:
+
+    bool _awaiting = false;
+};
+
+// Delivers the replies due by the time, then updates the schedulers at it.
+static void Step(std::initializer_list<std::shared_ptr<Delayed>> const thermometers, Scheduler::Time const time)
+{
+    now = time;
+    for (std::shared_ptr<Delayed> const &thermometer : thermometers) thermometer->deliver();
+    Scheduler::UpdateInstances(now);
+}
+
+// Reads a temperature following the wave, in Fahrenheit, as of the time.
+class Wave : public Thermometer
+{
+public:
+
+    std::function<float(Scheduler::Time)> fahrenheit;
+
+    Sensor::Data sense()
+    {
+        _temperature = TemperatureUnit(fahrenheit(now), TemperatureUnit::Scale::Fahrenheit);
+        _humidity = 40;
+        _recordReading();
+        return Sensor::Data();
+    }
+
+    Wave(std::function<float(Scheduler::Time)> const &fahrenheit):
+    Thermometer({}),
+    fahrenheit(fahrenheit)
+    {
+
+    }
+};
+
+// A status, and when the thermostat took it on.
+typedef std::pair<Scheduler::Time, Thermostat::Status> Change;
+
+// Runs the thermostat a second at a time, for an hour of readings swinging 2.5F
+// across a 70F auto band every ten minutes, noise and all, as its thermometer
+// samples itself every five seconds; returns the evaluations, by the history.
+static std::size_t Simulate(Thermostat &thermostat, Wave &thermometer, std::vector<Change> &changes)
+{
+    thermostat.setMode(Thermostat::Mode::Auto);
+    thermostat.setTargetTemperature(TemperatureUnit(70, TemperatureUnit::Scale::Fahrenheit));
+    thermometer.setSamplingInterval(5000000);
+
+    Scheduler::Time const start = now;
+    Scheduler::Time first = 0; // The second of the first evaluation, which history times count from.
+    std::size_t evaluations = 0;
+    Thermostat::Status status = thermostat.status();
+
+    for (Scheduler::Time second = 0; second < 3600; second++)
+    {
+        Scheduler::UpdateInstances(now = start + (second * 1000000));
+
+        if (!evaluations && !thermostat.history().empty()) first = second;
+        for (Thermostat::CycleHistory::Entry const &entry : thermostat.history())
+        {
+            evaluations += entry.time == (second - first);
+        }
+
+        if (thermostat.status() == status) continue;
+        status = thermostat.status();
+        changes.push_back(std::make_pair(now - start, status));
+    }
+
+    thermometer.setSamplingInterval(0);
+    return evaluations;
+}
+
+// Exposes the decision table, and how thermostats look it up.
+struct Decisions : Thermostat
+{
+    using Thermostat::Decision;
+    using Thermostat::_Decisions;
+    using Thermostat::_Decide;
+};
+
+// Exposes the actuator's pins, so the test may drive them behind its back.
+struct Outputs : Actuator
+{
+    using Actuator::_outputs;
+
+    Outputs(Pin::Arrangement const &pins, Scheduler::Time const actuateTimeout):
+    Actuator(pins, actuateTimeout)
+    {
+
+    }
+};
+
+static Thermostat::TemperatureThreshold const Threshold = std::make_pair(1, TemperatureUnit::Scale::Fahrenheit);
+
+int main(int argc, const char * argv[])
+{
+    // The following done to suppress unused variable warnings.
+    (void) argc;
+    (void) argv;
+
+    std::shared_ptr<Fixed> const thermometer = std::make_shared<Fixed>();
+    Thermostat thermostat({14, 12, 13}, {thermometer}, 5000000);
+    thermostat.setEvaluation(Thermostat::Evaluation::OnChange);
+    thermostat.setMode(Thermostat::Mode::Heat);
+    thermostat.setTargetTemperature(TemperatureUnit(60, TemperatureUnit::Scale::Fahrenheit));
+
+    for (unsigned second = 0; second < 20; second++) Scheduler::UpdateInstances(now += 1000000);
+    MJB_CHECK(thermostat.status() == Thermostat::Status::Standby);
+
+    // Commands are queued, and applied on the next update, all at once; the
+    // thermostat evaluates, and publishes, only once they all are, without
+    // sensing anew. Cooling to 60F, as a half applied command would have it,
+    // is never published.
+    Thermostat::Command command;
+    command.setMode(Thermostat::Mode::Cool);
+    command.setTargetTemperature(TemperatureUnit(80, TemperatureUnit::Scale::Fahrenheit), Threshold);
+
+    uint32_t const version = thermostat.snapshot()->version();
+    std::size_t const senses = thermometer->senses;
+
+    uint32_t const id = thermostat.submit(command);
+    MJB_CHECK(id == 1);
+    MJB_CHECK(thermostat.mode() == Thermostat::Mode::Heat);
+    MJB_CHECK(thermostat.appliedCommand() == 0);
+
+    Scheduler::UpdateInstances(now += 1000);
+    MJB_CHECK(thermostat.appliedCommand() == id);
+    MJB_CHECK(thermostat.mode() == Thermostat::Mode::Cool);
+    MJB_CHECK(thermostat.status() == Thermostat::Status::Standby);
+    MJB_CHECK(thermostat.snapshot()->version() == (version + 1));
+    MJB_CHECK(thermometer->senses == senses);
+
+    // Statuses written for a command just submitted name it in their command
+    // object, and are otherwise the snapshot's; short buffers truncate them.
+    std::shared_ptr<Thermostat::Snapshot const> const snapshot = thermostat.snapshot();
+    std::string const status(snapshot->data(), snapshot->size());
+    std::string const submitted = status.substr(0, status.size() - 2) + ",\"submitted\":4294967295}}";
+
+    std::string const applied = "\"command\":{\"applied\":1}}";
+    MJB_CHECK(!status.compare(status.size() - applied.size(), applied.size(), applied));
+
+    char buffer[Thermostat::Snapshot::Capacity];
+    MJB_CHECK(snapshot->write(buffer, sizeof(buffer), 4294967295u) == submitted.size());
+    MJB_CHECK(buffer == submitted);
+    MJB_CHECK(snapshot->write(buffer, 12, 1) == 11);
+    MJB_CHECK(buffer == status.substr(0, 11));
+
+    // Commands settling on a new target are evaluated against it.
+    Thermostat::Command lower;
+    lower.setTargetTemperature(TemperatureUnit(65, TemperatureUnit::Scale::Fahrenheit), Threshold);
+    MJB_CHECK(thermostat.submit(lower) == 2);
+    Scheduler::UpdateInstances(now += 1000);
+    MJB_CHECK(thermostat.status() == Thermostat::Status::Cooling);
+
+    // Empty and invalid commands are turned away, as are those past a full
+    // queue; those queued are applied in turn.
+    MJB_CHECK(!thermostat.submit(Thermostat::Command()));
+
+    Thermostat::Command hot;
+    hot.setTargetTemperature(TemperatureUnit(120, TemperatureUnit::Scale::Fahrenheit), Threshold);
+    MJB_CHECK(!thermostat.submit(hot));
+
+    Thermostat::Command unbounded;
+    unbounded.setTargetTemperature(TemperatureUnit(70, TemperatureUnit::Scale::Fahrenheit),
+                                   std::make_pair(0, TemperatureUnit::Scale::Fahrenheit));
+    MJB_CHECK(!thermostat.submit(unbounded));
+
+    uint32_t last = 0;
+    unsigned queued = 0;
+    for (unsigned index = 0; index < 10; index++)
+    {
+        Thermostat::Command perception;
+        perception.setPerceptionIndex((index % 2)? Thermostat::PerceptionIndex::HeatIndex :
+                                                   Thermostat::PerceptionIndex::TemperatureIndex);
+        if (uint32_t const queuedId = thermostat.submit(perception))
+        {
+            last = queuedId;
+            queued++;
+        }
+    }
+
+    MJB_CHECK(queued == 8);
+    Scheduler::UpdateInstances(now += 1000);
+    MJB_CHECK(thermostat.appliedCommand() == last);
+    MJB_CHECK(thermostat.perceptionIndex() == Thermostat::PerceptionIndex::HeatIndex);
+
+    // Arguments parse as /control's handlers take them; those missing, or
+    // malformed, leave their settings unset.
+    MJB_CHECK(Thermostat::Command::Parse(nullptr, "", nullptr, Thermostat::Mode::Off).empty());
+    MJB_CHECK(Thermostat::Command::Parse(nullptr, "72", nullptr, Thermostat::Mode::Off).empty());
+    MJB_CHECK(Thermostat::Command::Parse(nullptr, "F", nullptr, Thermostat::Mode::Off).empty());
+    MJB_CHECK(Thermostat::Command::Parse(nullptr, "7x2F", nullptr, Thermostat::Mode::Off).empty());
+    MJB_CHECK(Thermostat::Command::Parse(nullptr, nullptr, "warm", Thermostat::Mode::Off).empty());
+
+    MJB_CHECK(thermostat.submit(Thermostat::Command::Parse("auto", "22.5C", "T", thermostat.mode())));
+    Scheduler::UpdateInstances(now += 1000);
+    MJB_CHECK(thermostat.mode() == Thermostat::Mode::Auto);
+    MJB_CHECK(thermostat.targetTemperature().value() == TemperatureUnit(22.5, TemperatureUnit::Scale::Celsius).value());
+    MJB_CHECK(thermostat.targetTemperatureThreshold() == std::make_pair(TemperatureUnit::value_type(1), TemperatureUnit::Scale::Celsius));
+    MJB_CHECK(thermostat.perceptionIndex() == Thermostat::PerceptionIndex::TemperatureIndex);
+
+    // Unknown modes, out of range numbers among them, are left unset, the
+    // target's threshold following the current mode.
+    MJB_CHECK(Thermostat::Command::Parse("warm", nullptr, nullptr, Thermostat::Mode::Auto).empty());
+    MJB_CHECK(Thermostat::Command::Parse("9", nullptr, nullptr, Thermostat::Mode::Auto).empty());
+    MJB_CHECK(Thermostat::Command::Parse("-1", nullptr, nullptr, Thermostat::Mode::Auto).empty());
+
+    MJB_CHECK(thermostat.submit(Thermostat::Command::Parse("warm", "300K", "1", thermostat.mode())));
+    Scheduler::UpdateInstances(now += 1000);
+    MJB_CHECK(thermostat.mode() == Thermostat::Mode::Auto);
+    MJB_CHECK(thermostat.targetTemperatureThreshold() == std::make_pair(TemperatureUnit::value_type(1), TemperatureUnit::Scale::Kelvin));
+    MJB_CHECK(thermostat.perceptionIndex() == Thermostat::PerceptionIndex::HeatIndex);
+
+    MJB_CHECK(thermostat.submit(Thermostat::Command::Parse("1", "72F", nullptr, thermostat.mode())));
+    Scheduler::UpdateInstances(now += 1000);
+    MJB_CHECK(thermostat.mode() == Thermostat::Mode::Heat);
+    MJB_CHECK(thermostat.targetTemperatureThreshold() == std::make_pair(TemperatureUnit::value_type(0.5), TemperatureUnit::Scale::Fahrenheit));
+
+    MJB_CHECK(thermostat.submit(Thermostat::Command::Parse("warm", "300K", nullptr, thermostat.mode())));
+    Scheduler::UpdateInstances(now += 1000);
+    MJB_CHECK(thermostat.mode() == Thermostat::Mode::Heat);
+    MJB_CHECK(thermostat.targetTemperatureThreshold() == std::make_pair(TemperatureUnit::value_type(0.5), TemperatureUnit::Scale::Kelvin));
+
+    // Acquiring concurrently, a cycle requests every reading at once, then
+    // completes once they're all in, or the acquisition timeout's elapsed,
+    // the readings yet to arrive collected as stale, and left out.
+    std::shared_ptr<Delayed> const slow = std::make_shared<Delayed>(30000);
+    std::shared_ptr<Delayed> const silent = std::make_shared<Delayed>(0, true);
+
+    Thermostat concurrent({4, 5, 6}, {slow, silent}, 5000000);
+    concurrent.setAcquisitionTimeout(100000);
+    concurrent.setMode(Thermostat::Mode::Heat);
+    concurrent.setTargetTemperature(TemperatureUnit(75, TemperatureUnit::Scale::Fahrenheit));
+
+    while (!slow->requests) Step({slow, silent}, now + 10000);
+    Scheduler::Time const cycle = now;
+    MJB_CHECK((silent->requests == 1) && (silent->requested == cycle));
+
+    while (slow->pending()) Step({slow, silent}, now + 10000);
+    MJB_CHECK(now == (cycle + 30000));
+    MJB_CHECK(!slow->sample().sequence);
+    MJB_CHECK(concurrent.status() == Thermostat::Status::Standby);
+
+    while (!slow->sample().sequence) Step({slow, silent}, now + 10000);
+    MJB_CHECK(now == (cycle + 110000));
+    MJB_CHECK((slow->requests == 1) && (silent->requests == 1));
+    MJB_CHECK(!slow->sample().stale && (slow->sample().time == now));
+    MJB_CHECK(silent->sample().stale && (silent->sample().sequence == 1));
+    MJB_CHECK(concurrent.status() == Thermostat::Status::Heating);
+
+    // Cycles wait no longer than their readings take, and readings arriving
+    // past the timeout are stale, though fresh on the next cycle.
+    std::shared_ptr<Delayed> const late = std::make_shared<Delayed>(150000);
+    concurrent.thermometers = {slow, late};
+
+    while (slow->requests == 1) Step({slow, late}, now + 10000);
+    Scheduler::Time const next = now;
+    while (slow->sample().sequence == 1) Step({slow, late}, now + 10000);
+    MJB_CHECK(now == (next + 110000));
+    MJB_CHECK(!slow->sample().stale && late->sample().stale);
+
+    while (slow->requests == 2) Step({slow, late}, now + 10000);
+    MJB_CHECK((late->requests == 2) && (late->health().readings == 1));
+    while (slow->sample().sequence == 2) Step({slow, late}, now + 10000);
+    MJB_CHECK(!late->sample().stale);
+
+    concurrent.thermometers = {slow};
+    while (slow->requests == 3) Step({slow}, now + 10000);
+    Scheduler::Time const alone = now;
+    while (slow->sample().sequence == 3) Step({slow}, now + 10000);
+    MJB_CHECK(now == (alone + 30000));
+
+    // Evaluating on change, the thermostat acts on the samples its
+    // thermometer takes, as they cross the band, and otherwise only every
+    // five minutes; it changes status when evaluating every five seconds
+    // would, but evaluates a fraction as often.
+    std::function<float(Scheduler::Time)> const swing = [](Scheduler::Time const time) -> float
+    {
+        uint32_t const second = time / 1000000;
+        float const noise = (((second * 2654435761u) >> 16) % 1000) / 5000.0f - 0.1f;
+        return 70 + 2.5f * std::sin(second * 2 * 3.14159265f / 600) + noise;
+    };
+
+    std::vector<Change> periodicChanges, changedChanges;
+    std::size_t periodicEvaluations = 0, changedEvaluations = 0;
+    Scheduler::Time const simulated = now += 10000000;
+
+    {
+        std::shared_ptr<Wave> const wave = std::make_shared<Wave>(swing);
+        Thermostat periodic({30, 31, 32}, {wave}, 5000000);
+        periodicEvaluations = Simulate(periodic, *wave, periodicChanges);
+    }
+
+    now = simulated;
+    {
+        std::shared_ptr<Wave> const wave = std::make_shared<Wave>(swing);
+        Thermostat changed({30, 31, 32}, {wave}, 300000000);
+        changed.setEvaluation(Thermostat::Evaluation::OnChange);
+        changedEvaluations = Simulate(changed, *wave, changedChanges);
+    }
+
+    MJB_CHECK(periodicEvaluations == 720);
+    MJB_CHECK(changedEvaluations < (periodicEvaluations / 10));
+    MJB_CHECK(periodicChanges.size() > 10);
+    MJB_CHECK(changedChanges == periodicChanges);
+    std::fprintf(stderr, "Evaluations over an hour: %zu periodic, %zu on change, %zu status changes\n",
+                 periodicEvaluations, changedEvaluations, changedChanges.size());
+
+    // Samples are followed only while evaluating on change; those within the
+    // band's part evaluate nothing, and settings changed evaluate at once.
+    {
+        float fahrenheit = 70;
+        std::shared_ptr<Wave> const wave = std::make_shared<Wave>([&fahrenheit](Scheduler::Time) { return fahrenheit; });
+        Thermostat followed({30, 31, 32}, {wave}, 300000000);
+        followed.setMode(Thermostat::Mode::Auto);
+        followed.setTargetTemperature(TemperatureUnit(70, TemperatureUnit::Scale::Fahrenheit));
+        wave->setSamplingInterval(1000000);
+
+        Scheduler::UpdateInstances(now += 1000000);
+        std::size_t const evaluated = followed.history().size();
+        MJB_CHECK(evaluated == 1);
+
+        fahrenheit = 75;
+        Scheduler::UpdateInstances(now += 1000000);
+        MJB_CHECK(followed.status() == Thermostat::Status::Stasis);
+        MJB_CHECK(followed.history().size() == evaluated);
+
+        followed.setEvaluation(Thermostat::Evaluation::OnChange);
+        Scheduler::UpdateInstances(now += 1000000);
+        MJB_CHECK(followed.status() == Thermostat::Status::Cooling);
+        MJB_CHECK(followed.history().size() == (evaluated + 1));
+
+        for (unsigned second = 0; second < 10; second++) Scheduler::UpdateInstances(now += 1000000);
+        MJB_CHECK(followed.history().size() == (evaluated + 1));
+
+        followed.setTargetTemperature(TemperatureUnit(75, TemperatureUnit::Scale::Fahrenheit));
+        MJB_CHECK(followed.status() == Thermostat::Status::Stasis);
+        MJB_CHECK(followed.history().size() == (evaluated + 2));
+
+        followed.setEvaluation(Thermostat::Evaluation::Periodic);
+        fahrenheit = 90;
+        for (unsigned second = 0; second < 10; second++) Scheduler::UpdateInstances(now += 1000000);
+        MJB_CHECK(followed.status() == Thermostat::Status::Stasis);
+        MJB_CHECK(followed.history().size() == (evaluated + 2));
+        wave->setSamplingInterval(0);
+    }
+
+    // Thermometers sampling at their own pace are filtered a round at a time,
+    // once each has sampled anew, though reactions needn't wait on the round.
+    {
+        float quick = 70, slow = 70;
+        std::shared_ptr<Wave> const first = std::make_shared<Wave>([&quick](Scheduler::Time) { return quick; });
+        std::shared_ptr<Wave> const second = std::make_shared<Wave>([&slow](Scheduler::Time) { return slow; });
+        Thermostat rounds({30, 31, 32}, {first, second}, 300000000);
+        rounds.setMode(Thermostat::Mode::Auto);
+        rounds.setTargetTemperature(TemperatureUnit(69.3f, TemperatureUnit::Scale::Fahrenheit));
+        rounds.setEvaluation(Thermostat::Evaluation::OnChange);
+        first->setSamplingInterval(1000000);
+        second->setSamplingInterval(3000000);
+
+        for (unsigned tick = 0; tick < 30; tick++) Scheduler::UpdateInstances(now += 1000000);
+        float const smoothed = static_cast<float>(rounds.smoothedTemperature().value(TemperatureUnit::Scale::Fahrenheit));
+        MJB_CHECK(std::fabs(smoothed - 70) < 0.01f);
+
+        // Both thermometers sampled this second; the next two seconds' samples
+        // are the quick one's alone, and move the mean above the band's 70.3F.
+        while ((second->sample().time != now) || (first->sample().time != now)) Scheduler::UpdateInstances(now += 1000000);
+        MJB_CHECK(rounds.status() == Thermostat::Status::Stasis);
+        quick = 70.8f;
+        Scheduler::UpdateInstances(now += 1000000);
+        MJB_CHECK(rounds.status() == Thermostat::Status::Cooling);
+        Scheduler::UpdateInstances(now += 1000000);
+        MJB_CHECK(std::fabs(static_cast<float>(rounds.smoothedTemperature().value(TemperatureUnit::Scale::Fahrenheit)) - 70) < 0.01f);
+
+        Scheduler::UpdateInstances(now += 1000000);
+        MJB_CHECK(second->sample().time == now);
+        MJB_CHECK(static_cast<float>(rounds.smoothedTemperature().value(TemperatureUnit::Scale::Fahrenheit)) > 70.1f);
+
+        first->setSamplingInterval(0);
+        second->setSamplingInterval(0);
+    }
+
+    // Every mode and band position decides as the table has it; a 70F target
+    // with a 1F threshold compiles to a 71F band heating, a 69F band cooling,
+    // and 69F to 71F in auto, its bounds being within it.
+    Actuator::Pattern const fan = Actuator::Pattern(1) << Thermostat::SignalLine::FanCall;
+    Actuator::Pattern const cool = Actuator::Pattern(1) << Thermostat::SignalLine::CoolCall;
+    Actuator::Pattern const heat = Actuator::Pattern(1) << Thermostat::SignalLine::HeatCall;
+
+    // Temperatures are read, or at one of the band's bounds.
+    enum At
+    {
+        Reading,
+        Lower,
+        Upper
+    };
+
+    struct Case
+    {
+        Thermostat::Mode mode;
+        At at;
+        float fahrenheit;
+        Thermostat::ControlBand::Position position;
+        Actuator::Pattern pattern;
+        Thermostat::Status status;
+    };
+
+    Case const cases[] = {
+        {Thermostat::Mode::Off,  Reading, 69,   Thermostat::ControlBand::Position::Below,  0,          Thermostat::Status::Standby},
+        {Thermostat::Mode::Off,  Lower,   70,   Thermostat::ControlBand::Position::Within, 0,          Thermostat::Status::Standby},
+        {Thermostat::Mode::Off,  Reading, 71,   Thermostat::ControlBand::Position::Above,  0,          Thermostat::Status::Standby},
+        {Thermostat::Mode::Heat, Reading, 70,   Thermostat::ControlBand::Position::Below,  fan | heat, Thermostat::Status::Heating},
+        {Thermostat::Mode::Heat, Upper,   71,   Thermostat::ControlBand::Position::Within, 0,          Thermostat::Status::Standby},
+        {Thermostat::Mode::Heat, Reading, 72,   Thermostat::ControlBand::Position::Above,  0,          Thermostat::Status::Standby},
+        {Thermostat::Mode::Cool, Reading, 68,   Thermostat::ControlBand::Position::Below,  0,          Thermostat::Status::Standby},
+        {Thermostat::Mode::Cool, Lower,   69,   Thermostat::ControlBand::Position::Within, 0,          Thermostat::Status::Standby},
+        {Thermostat::Mode::Cool, Reading, 70,   Thermostat::ControlBand::Position::Above,  fan | cool, Thermostat::Status::Cooling},
+        {Thermostat::Mode::Auto, Reading, 68.5, Thermostat::ControlBand::Position::Below,  fan | heat, Thermostat::Status::Heating},
+        {Thermostat::Mode::Auto, Lower,   69,   Thermostat::ControlBand::Position::Within, 0,          Thermostat::Status::Stasis},
+        {Thermostat::Mode::Auto, Reading, 70,   Thermostat::ControlBand::Position::Within, 0,          Thermostat::Status::Stasis},
+        {Thermostat::Mode::Auto, Upper,   71,   Thermostat::ControlBand::Position::Within, 0,          Thermostat::Status::Stasis},
+        {Thermostat::Mode::Auto, Reading, 71.5, Thermostat::ControlBand::Position::Above,  fan | cool, Thermostat::Status::Cooling}
+    };
+
+    TemperatureUnit const target(70, TemperatureUnit::Scale::Fahrenheit);
+    for (Case const &test : cases)
+    {
+        Thermostat::ControlBand const band = Thermostat::ControlBand::Compile(test.mode, target, Threshold);
+        Thermometer::KelvinUnit const reading(TemperatureUnit(test.fahrenheit, TemperatureUnit::Scale::Fahrenheit));
+        Thermometer::KelvinUnit const temperature = (test.at == Lower)? band.lower() : ((test.at == Upper)? band.upper() : reading);
+        Thermostat::ControlBand::Position const position = band.position(temperature);
+        Decisions::Decision const &decision = Decisions::_Decide(band.mode(), position);
+
+        MJB_CHECK(band.mode() == test.mode);
+        MJB_CHECK(std::fabs(static_cast<float>(temperature.value() - reading.value())) <= 0.01f);
+        MJB_CHECK(position == test.position);
+        MJB_CHECK(&decision == &Decisions::_Decisions[test.mode][position]);
+        MJB_CHECK((decision.pattern == test.pattern) && (decision.status == test.status));
+    }
+
+    // Thresholds are intervals; 1K is 1.8F either side of the target.
+    Thermostat::ControlBand const kelvin = Thermostat::ControlBand::Compile(Thermostat::Mode::Auto, target,
+                                                                            std::make_pair(1, TemperatureUnit::Scale::Kelvin));
+    MJB_CHECK(std::fabs(static_cast<float>(Thermometer::KelvinUnit(target).value() - kelvin.lower().value()) - 1) < 0.01f);
+    MJB_CHECK(std::fabs(static_cast<float>(kelvin.upper().value() - Thermometer::KelvinUnit(target).value()) - 1) < 0.01f);
+
+    // Transitions write only the lines that change, and nothing at all when
+    // the pattern's already in effect, leaving the actuation timeout be; the
+    // test drives the pins behind the actuator's back to tell.
+    {
+        now += 10000000;
+        Outputs outputs({20, 21, 22}, 1000000);
+        MJB_CHECK(outputs.transition(0x5));
+        MJB_CHECK((outputs._outputs[0]->value() == 1) && (outputs._outputs[1]->value() == 0) && (outputs._outputs[2]->value() == 1));
+        now += 1;
+        MJB_CHECK(outputs.status() == Actuator::Status::WaitingOnTimeout);
+
+        now += 2000000;
+        MJB_CHECK(outputs.status() == Actuator::Status::Ready);
+        outputs._outputs[0]->setConfiguration({Pin::Mode::Output, 0});
+        MJB_CHECK(!outputs.transition(0x5));
+        MJB_CHECK(outputs._outputs[0]->value() == 0);
+        MJB_CHECK(outputs.status() == Actuator::Status::Ready);
+
+        outputs._outputs[2]->setConfiguration({Pin::Mode::Output, 0});
+        MJB_CHECK(outputs.transition(0x6));
+        MJB_CHECK((outputs._outputs[1]->value() == 1) && (outputs._outputs[2]->value() == 0));
+        MJB_CHECK(outputs.pattern() == 0x6);
+        now += 1;
+        MJB_CHECK(outputs.status() == Actuator::Status::WaitingOnTimeout);
+    }
+
+    return Testing::Result("ThermostatTester");
+}
+
+#else
+
+int main()
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,495 @@
+//
+//  TimeSeriesStore.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "TimeSeriesStore.hpp"
+
+#if defined(MJB_POSIX_API)
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    uint32_t const BlockMagic = 0x54535331; // "TSS1"
+
+    // The most a sample can take; a 64 bit delta-of-delta, and a value XORed
+    // outside of the last window of meaningful bits.
+    unsigned const SampleBitsLimit = (4 + 64) + (2 + 5 + 5 + 32);
+
+    uint8_t const NoWindow = 0xFF;
+}
+
+constexpr std::size_t TimeSeriesStore::BlockSize;
+
+
+// =============================================================================
+// TimeSeriesStore : Implementation
+// =============================================================================
+bool TimeSeriesStore::isOpen() const
+{
+    return _descriptor >= 0;
+}
+
+TimeSeriesStore::Series TimeSeriesStore::series(TimeSeriesStore::Zone const zone,
+                                                TimeSeriesStore::Field const field)
+{
+    uint64_t const key = TimeSeriesStore::_Key(zone, field);
+    std::unordered_map<uint64_t, TimeSeriesStore::Series>::const_iterator const found = _seriesIndex.find(key);
+
+    if (found != _seriesIndex.end()) return found->second;
+
+    TimeSeriesStore::Series const series = static_cast<TimeSeriesStore::Series>(_series.size());
+    _series.emplace_back();
+    _series.back().zone = zone;
+    _series.back().field = field;
+    _reset(_series.back());
+    _seriesIndex[key] = series;
+
+    return series;
+}
+
+bool TimeSeriesStore::append(TimeSeriesStore::Series const series,
+                             TimeSeriesStore::Time const time,
+                             float const value)
+{
+    if (series >= _series.size()) return false;
+
+    TimeSeriesStore::SeriesState &state = _series[series];
+    TimeSeriesStore::BlockHeader &header = state.block.header;
+    TimeSeriesStore::Cursor &cursor = state.cursor;
+
+    // The cursor's time outlives the blocks written, as series only go forward.
+    if ((header.count || !state.extents.empty()) && (time < cursor.time)) return false;
+
+    // Blocks are written out once they may not hold another sample.
+    if (header.count && ((header.bits + SampleBitsLimit) > (_PayloadSize * 8)) && !_write(state)) return false;
+
+    uint32_t const bits = TimeSeriesStore::_Bits(value);
+    uint8_t * const payload = state.block.payload;
+
+    if (!header.count)
+    {
+        // Blocks start from the time in the header, and the value in full.
+        header.first = time;
+        TimeSeriesStore::_Write(payload, header.bits, bits, 32);
+
+        cursor.time = time;
+        cursor.delta = 0;
+        cursor.value = bits;
+        cursor.leading = NoWindow;
+    }
+    else
+    {
+        int64_t const delta = time - cursor.time;
+        int64_t const deltaOfDelta = delta - cursor.delta;
+
+        if (!deltaOfDelta)
+        {
+            TimeSeriesStore::_Write(payload, header.bits, 0x0, 1);
+        }
+        else if ((deltaOfDelta >= -64) && (deltaOfDelta < 64))
+        {
+            TimeSeriesStore::_Write(payload, header.bits, 0x2, 2);
+            TimeSeriesStore::_Write(payload, header.bits, static_cast<uint64_t>(deltaOfDelta), 7);
+        }
+        else if ((deltaOfDelta >= -256) && (deltaOfDelta < 256))
+        {
+            TimeSeriesStore::_Write(payload, header.bits, 0x6, 3);
+            TimeSeriesStore::_Write(payload, header.bits, static_cast<uint64_t>(deltaOfDelta), 9);
+        }
+        else if ((deltaOfDelta >= -2048) && (deltaOfDelta < 2048))
+        {
+            TimeSeriesStore::_Write(payload, header.bits, 0xE, 4);
+            TimeSeriesStore::_Write(payload, header.bits, static_cast<uint64_t>(deltaOfDelta), 12);
+        }
+        else
+        {
+            TimeSeriesStore::_Write(payload, header.bits, 0xF, 4);
+            TimeSeriesStore::_Write(payload, header.bits, static_cast<uint64_t>(deltaOfDelta), 64);
+        }
+
+        uint32_t const difference = bits ^ cursor.value;
+
+        if (!difference)
+        {
+            TimeSeriesStore::_Write(payload, header.bits, 0x0, 1);
+        }
+        else
+        {
+            uint8_t const leading = static_cast<uint8_t>(__builtin_clz(difference));
+            uint8_t const trailing = static_cast<uint8_t>(__builtin_ctz(difference));
+
+            if ((cursor.leading != NoWindow) && (leading >= cursor.leading) && (trailing >= cursor.trailing))
+            {
+                // The difference fits in the last window, which is reused.
+                TimeSeriesStore::_Write(payload, header.bits, 0x2, 2);
+                TimeSeriesStore::_Write(payload, header.bits, difference >> cursor.trailing,
+                                        32 - cursor.leading - cursor.trailing);
+            }
+            else
+            {
+                unsigned const length = 32 - leading - trailing;
+
+                TimeSeriesStore::_Write(payload, header.bits, 0x3, 2);
+                TimeSeriesStore::_Write(payload, header.bits, leading, 5);
+                TimeSeriesStore::_Write(payload, header.bits, length - 1, 5);
+                TimeSeriesStore::_Write(payload, header.bits, difference >> trailing, length);
+
+                cursor.leading = leading;
+                cursor.trailing = trailing;
+            }
+        }
+
+        cursor.delta = delta;
+        cursor.time = time;
+        cursor.value = bits;
+    }
+
+    header.last = time;
+    header.count++;
+    _samples++;
+
+    return true;
+}
+
+bool TimeSeriesStore::append(TimeSeriesStore::Zone const zone,
+                             TimeSeriesStore::Field const field,
+                             TimeSeriesStore::Time const time,
+                             float const value)
+{
+    return append(series(zone, field), time, value);
+}
+
+bool TimeSeriesStore::append(TimeSeriesStore::Zone const zone,
+                             TimeSeriesStore::Time const time,
+                             Thermometer::Sample const &sample)
+{
+    bool appended = append(zone, TimeSeriesStore::Field::Temperature, time, static_cast<float>(sample.temperature.value()));
+    appended = append(zone, TimeSeriesStore::Field::Humiture, time, static_cast<float>(sample.humiture.value())) && appended;
+    appended = append(zone, TimeSeriesStore::Field::Humidity, time, static_cast<float>(sample.humidity)) && appended;
+    return appended;
+}
+
+bool TimeSeriesStore::append(TimeSeriesStore::Zone const zone,
+                             TimeSeriesStore::Time const time,
+                             Thermostat::CycleHistory::Entry const &entry)
+{
+    bool appended = append(zone, TimeSeriesStore::Field::Temperature, time, static_cast<float>(entry.temperature.value()));
+    appended = append(zone, TimeSeriesStore::Field::Humiture, time, static_cast<float>(entry.humiture.value())) && appended;
+    appended = append(zone, TimeSeriesStore::Field::Humidity, time, static_cast<float>(entry.humidity)) && appended;
+    appended = append(zone, TimeSeriesStore::Field::TargetTemperature, time, static_cast<float>(entry.target.value())) && appended;
+    return appended;
+}
+
+std::size_t TimeSeriesStore::query(TimeSeriesStore::Zone const zone,
+                                   TimeSeriesStore::Field const field,
+                                   TimeSeriesStore::Time const from,
+                                   TimeSeriesStore::Time const to,
+                                   TimeSeriesStore::Visitor const &visitor)
+{
+    std::unordered_map<uint64_t, TimeSeriesStore::Series>::const_iterator const found = _seriesIndex.find(TimeSeriesStore::_Key(zone, field));
+
+    if ((found == _seriesIndex.end()) || (from > to)) return 0;
+
+    TimeSeriesStore::SeriesState const &state = _series[found->second];
+    std::size_t visited = 0;
+
+    if (!state.extents.empty() && !_remap()) return 0;
+
+    // Extents are in time order, as series are only ever appended to, so the
+    // first one reaching the range is found by binary search.
+    std::vector<TimeSeriesStore::Extent>::const_iterator extent =
+        std::lower_bound(state.extents.begin(), state.extents.end(), from,
+                         [](TimeSeriesStore::Extent const &extent, TimeSeriesStore::Time const time) -> bool
+                         {
+                             return extent.last < time;
+                         });
+
+    for (; extent != state.extents.end(); ++extent)
+    {
+        if (extent->first > to) return visited;
+
+        TimeSeriesStore::Block const &block = *reinterpret_cast<TimeSeriesStore::Block const *>(_map + extent->offset);
+        if (!TimeSeriesStore::_Decode(block, from, to, visitor, visited)) return visited;
+    }
+
+    if (state.block.header.count)
+    {
+        TimeSeriesStore::_Decode(state.block, from, to, visitor, visited);
+    }
+
+    return visited;
+}
+
+bool TimeSeriesStore::flush()
+{
+    bool flushed = true;
+
+    for (TimeSeriesStore::SeriesState &state : _series)
+    {
+        if (state.block.header.count) flushed = _write(state) && flushed;
+    }
+
+    return flushed;
+}
+
+uint64_t TimeSeriesStore::samples() const
+{
+    return _samples;
+}
+
+uint64_t TimeSeriesStore::size() const
+{
+    uint64_t size = _size;
+
+    for (TimeSeriesStore::SeriesState const &state : _series)
+    {
+        if (state.block.header.count) size += sizeof(TimeSeriesStore::BlockHeader) + ((state.block.header.bits + 7) / 8);
+    }
+
+    return size;
+}
+
+void TimeSeriesStore::_load()
+{
+    struct stat status;
+    if (fstat(_descriptor, &status)) return;
+
+    // A block torn by a crash is dropped, so that appends stay aligned.
+    _size = static_cast<uint64_t>(status.st_size) - (static_cast<uint64_t>(status.st_size) % BlockSize);
+    if (static_cast<uint64_t>(status.st_size) != _size) (void) ftruncate(_descriptor, static_cast<off_t>(_size));
+
+    if (!_size || !_remap()) return;
+
+    for (uint64_t offset = 0; offset < _size; offset += BlockSize)
+    {
+        TimeSeriesStore::BlockHeader const &header = *reinterpret_cast<TimeSeriesStore::BlockHeader const *>(_map + offset);
+
+        // Blocks that couldn't have been written by the store are skipped.
+        if ((header.magic != BlockMagic) || !header.count) continue;
+        if ((header.bits > (_PayloadSize * 8)) || (header.field > TimeSeriesStore::Field::TargetTemperature)) continue;
+        if (header.first > header.last) continue;
+
+        TimeSeriesStore::SeriesState &state = _series[series(header.zone, static_cast<TimeSeriesStore::Field>(header.field))];
+        state.extents.push_back({offset, header.first, header.last});
+        state.cursor.time = header.last;
+        _samples += header.count;
+    }
+}
+
+bool TimeSeriesStore::_remap()
+{
+    if (_mapped == _size) return true;
+
+    if (_map) munmap(const_cast<uint8_t *>(_map), _mapped);
+
+    _map = nullptr;
+    _mapped = 0;
+
+    void * const map = mmap(nullptr, _size, PROT_READ, MAP_SHARED, _descriptor, 0);
+    if (map == MAP_FAILED) return false;
+
+    _map = static_cast<uint8_t const *>(map);
+    _mapped = _size;
+
+    return true;
+}
+
+bool TimeSeriesStore::_write(TimeSeriesStore::SeriesState &state)
+{
+    TimeSeriesStore::BlockHeader const &header = state.block.header;
+
+    // The file is opened for appending, so whole blocks land at its end.
+    if (!isOpen()) return false;
+
+    ssize_t const written = write(_descriptor, &state.block, sizeof(state.block));
+
+    if (written != static_cast<ssize_t>(BlockSize))
+    {
+        // A short write leaves a torn block, which is cut off to stay aligned.
+        if (written > 0) (void) ftruncate(_descriptor, static_cast<off_t>(_size));
+        return false;
+    }
+
+    state.extents.push_back({_size, header.first, header.last});
+    _size += BlockSize;
+
+    _reset(state);
+    return true;
+}
+
+void TimeSeriesStore::_reset(TimeSeriesStore::SeriesState &state)
+{
+    std::memset(&state.block, 0, sizeof(state.block));
+    state.block.header.magic = BlockMagic;
+    state.block.header.zone = state.zone;
+    state.block.header.field = static_cast<uint8_t>(state.field);
+
+    state.cursor.leading = NoWindow;
+}
+
+bool TimeSeriesStore::_Decode(TimeSeriesStore::Block const &block,
+                              TimeSeriesStore::Time const from,
+                              TimeSeriesStore::Time const to,
+                              TimeSeriesStore::Visitor const &visitor,
+                              std::size_t &visited)
+{
+    TimeSeriesStore::BlockHeader const &header = block.header;
+
+    if ((header.last < from) || (header.first > to)) return true;
+
+    uint32_t position = 0;
+    TimeSeriesStore::Cursor cursor = {header.first, 0, 0, NoWindow, 0};
+    cursor.value = static_cast<uint32_t>(TimeSeriesStore::_Read(block.payload, position, header.bits, 32));
+
+    for (uint16_t sample = 0; sample < header.count; sample++)
+    {
+        if (sample)
+        {
+            int64_t deltaOfDelta = 0;
+
+            if (TimeSeriesStore::_Read(block.payload, position, header.bits, 1))
+            {
+                unsigned bits = 7;
+                if (TimeSeriesStore::_Read(block.payload, position, header.bits, 1))
+                {
+                    bits = 9;
+                    if (TimeSeriesStore::_Read(block.payload, position, header.bits, 1))
+                    {
+                        bits = TimeSeriesStore::_Read(block.payload, position, header.bits, 1)? 64 : 12;
+                    }
+                }
+
+                uint64_t const field = TimeSeriesStore::_Read(block.payload, position, header.bits, bits);
+
+                // Sign-extend the field.
+                deltaOfDelta = (bits == 64)? static_cast<int64_t>(field) :
+                               (static_cast<int64_t>(field << (64 - bits)) >> (64 - bits));
+            }
+
+            cursor.delta += deltaOfDelta;
+            cursor.time += cursor.delta;
+
+            if (TimeSeriesStore::_Read(block.payload, position, header.bits, 1))
+            {
+                if (TimeSeriesStore::_Read(block.payload, position, header.bits, 1))
+                {
+                    cursor.leading = static_cast<uint8_t>(TimeSeriesStore::_Read(block.payload, position, header.bits, 5));
+                    unsigned const length = static_cast<unsigned>(TimeSeriesStore::_Read(block.payload, position, header.bits, 5)) + 1;
+                    if ((cursor.leading + length) > 32) return true; // Corrupt.
+                    cursor.trailing = static_cast<uint8_t>(32 - cursor.leading - length);
+                }
+                else if (cursor.leading == NoWindow) return true; // Corrupt; there's no window yet.
+
+                unsigned const length = 32 - cursor.leading - cursor.trailing;
+                cursor.value ^= static_cast<uint32_t>(TimeSeriesStore::_Read(block.payload, position, header.bits, length)) << cursor.trailing;
+            }
+        }
+
+        // A corrupt count, or payload, runs past the bits in use.
+        if (position > header.bits) return true;
+
+        if (cursor.time > to) return false;
+        if (cursor.time < from) continue;
+
+        visited++;
+        if (!visitor({cursor.time, TimeSeriesStore::_Float(cursor.value)})) return false;
+    }
+
+    return true;
+}
+
+uint64_t TimeSeriesStore::_Key(TimeSeriesStore::Zone const zone, TimeSeriesStore::Field const field)
+{
+    return (static_cast<uint64_t>(zone) << 8) | static_cast<uint64_t>(field);
+}
+
+void TimeSeriesStore::_Write(uint8_t * const payload, uint16_t &position, uint64_t const value, unsigned const bits)
+{
+    // Bits are written most significant first, a byte's worth at a time.
+    unsigned remaining = bits;
+
+    while (remaining)
+    {
+        unsigned const room = 8 - (position & 0x7);
+        unsigned const taken = (remaining < room)? remaining : room;
+        uint8_t const chunk = static_cast<uint8_t>((value >> (remaining - taken)) & ((1u << taken) - 1));
+
+        payload[position >> 3] |= static_cast<uint8_t>(chunk << (room - taken));
+        position += taken;
+        remaining -= taken;
+    }
+}
+
+uint64_t TimeSeriesStore::_Read(uint8_t const * const payload, uint32_t &position, uint32_t const limit, unsigned const bits)
+{
+    uint64_t value = 0;
+    unsigned remaining = bits;
+
+    while (remaining)
+    {
+        if (position >= limit)
+        {
+            value <<= (remaining < 64)? remaining : 0;
+            position += remaining;
+            break;
+        }
+
+        unsigned const room = 8 - (position & 0x7);
+        unsigned const taken = (remaining < room)? remaining : room;
+        uint8_t const chunk = static_cast<uint8_t>((payload[position >> 3] >> (room - taken)) & ((1u << taken) - 1));
+
+        value = (value << taken) | chunk;
+        position += taken;
+        remaining -= taken;
+    }
+
+    return value;
+}
+
+uint32_t TimeSeriesStore::_Bits(float const value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+float TimeSeriesStore::_Float(uint32_t const bits)
+{
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+
+// =============================================================================
+// TimeSeriesStore : Constructors & Destructor
+// =============================================================================
+TimeSeriesStore::TimeSeriesStore(char const * const path):
+_descriptor(open(path, O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644)),
+_size(0),
+_samples(0),
+_map(nullptr),
+_mapped(0)
+{
+    if (isOpen()) _load();
+}
+
+TimeSeriesStore::~TimeSeriesStore()
+{
+    flush();
+
+    if (_map) munmap(const_cast<uint8_t *>(_map), _mapped);
+    if (isOpen()) close(_descriptor);
+}
+
+#endif
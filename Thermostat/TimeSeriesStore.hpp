@@ -0,0 +1,192 @@
+//
+//  TimeSeriesStore.hpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef TimeSeriesStore_hpp
+#define TimeSeriesStore_hpp
+
+#include "Development.hpp"
+
+#if defined(MJB_POSIX_API)
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include "Thermometer.hpp"
+#include "Thermostat.hpp"
+
+// =============================================================================
+// TimeSeriesStore : This class keeps zones' samples on disk, in an append-only
+// file of fixed-size blocks, each holding a run of one series (a zone's field)
+// compressed as in Facebook's Gorilla: timestamps as their delta-of-deltas,
+// values XORed against the previous one. Regular, slowly varying samples take
+// a bit or two each, and rarely more than a couple of bytes.
+// Every series fills a block in memory, which is appended to the file with a
+// single write once full (or flushed); the file is read back through mmap, so
+// queries decode blocks in place. The blocks of a series are indexed by their
+// time range, which is rebuilt from the block headers when the file is opened.
+// NOTE: Times are whatever the caller makes of them, Unix seconds being best;
+// samples must be appended to a series in time order.
+// =============================================================================
+class TimeSeriesStore
+{
+public:
+    typedef int64_t Time;
+    typedef uint32_t Zone;
+    typedef uint32_t Series;    // A handle, for appending without lookups.
+
+    enum Field
+    {
+        Temperature,        // Kelvin, as are all temperatures.
+        Humiture,
+        Humidity,           // Percentage.
+        TargetTemperature
+    };
+
+    struct Point
+    {
+        Time time;
+        float value;
+    };
+
+    // Visitors return whether the query should go on.
+    typedef std::function<bool(Point const &point)> Visitor;
+
+    static constexpr std::size_t BlockSize = 512;
+
+    bool isOpen() const;
+
+    // Series are made as they're first asked for.
+    Series series(Zone const zone, Field const field);
+
+    // Returns false, storing nothing, if the sample is older than the series'
+    // latest one, or the full block before it could not be written; such a
+    // block is kept, and written out by the next append or flush instead.
+    bool append(Series const series, Time const time, float const value);
+    bool append(Zone const zone, Field const field, Time const time, float const value);
+
+    // Appends the sample's temperature, humiture and humidity.
+    bool append(Zone const zone, Time const time, Thermometer::Sample const &sample);
+
+    // Appends the cycle's temperature, humiture, humidity and target.
+    bool append(Zone const zone, Time const time, Thermostat::CycleHistory::Entry const &entry);
+
+    // Visits the series' points from the given time, up to (and including)
+    // the given time, in order; returns the number of points visited.
+    std::size_t query(Zone const zone,
+                      Field const field,
+                      Time const from,
+                      Time const to,
+                      Visitor const &visitor);
+
+    // Writes out the blocks being filled, however full; the store carries on
+    // in new blocks. Blocks that could not be written are kept, as above.
+    bool flush();
+
+    uint64_t samples() const;
+
+    // The bytes written, and those waiting in blocks being filled.
+    uint64_t size() const;
+
+    TimeSeriesStore(char const * const path);
+    ~TimeSeriesStore();
+
+protected:
+
+    struct BlockHeader
+    {
+        uint32_t magic;
+        uint32_t zone;
+        uint8_t field;
+        uint8_t reserved;
+        uint16_t count;     // Samples in the block.
+        uint16_t bits;      // Bits of the payload in use.
+        uint16_t padding;
+        Time first;         // The time of the first sample.
+        Time last;          // The time of the last sample.
+    };
+
+    static_assert(sizeof(BlockHeader) == 32, "Block headers must keep their layout on disk.");
+
+    static constexpr std::size_t _PayloadSize = BlockSize - sizeof(BlockHeader);
+
+    struct Block
+    {
+        BlockHeader header;
+        uint8_t payload[_PayloadSize];
+    };
+
+    static_assert(sizeof(Block) == BlockSize, "Blocks are written whole, as they're laid out on disk.");
+
+    // A block written out, by where it is and when it covers.
+    struct Extent
+    {
+        uint64_t offset;
+        Time first;
+        Time last;
+    };
+
+    // The encoder's state, as of the last sample in the block being filled;
+    // the decoder's is the same, as of the last sample decoded.
+    struct Cursor
+    {
+        Time time;
+        int64_t delta;
+        uint32_t value;
+        uint8_t leading;    // The window of meaningful XORed bits.
+        uint8_t trailing;
+    };
+
+    struct SeriesState
+    {
+        Zone zone;
+        Field field;
+        std::vector<Extent> extents;
+        Block block;
+        Cursor cursor;
+    };
+
+    int _descriptor;
+    uint64_t _size;             // The bytes written to the file.
+    uint64_t _samples;
+
+    uint8_t const *_map;
+    uint64_t _mapped;
+
+    std::vector<SeriesState> _series;
+    std::unordered_map<uint64_t, Series> _seriesIndex;
+
+    void _load();
+    bool _remap();
+
+    // Writes out the series' block, starting a new one only if it was.
+    bool _write(SeriesState &state);
+    void _reset(SeriesState &state);
+
+    // Decodes the block, visiting the points within range, as query does;
+    // returns false once the visitor asks to stop. Decoding stops at the end
+    // of the payload in use, should the block's count claim more samples.
+    static bool _Decode(Block const &block,
+                        Time const from,
+                        Time const to,
+                        Visitor const &visitor,
+                        std::size_t &visited);
+
+    static uint64_t _Key(Zone const zone, Field const field);
+
+    static void _Write(uint8_t * const payload, uint16_t &position, uint64_t const value, unsigned const bits);
+    // Reads past the limit read as zeros, never touching the payload there.
+    static uint64_t _Read(uint8_t const * const payload, uint32_t &position, uint32_t const limit, unsigned const bits);
+    static uint32_t _Bits(float const value);
+    static float _Float(uint32_t const bits);
+};
+
+#endif
+
+#endif /* TimeSeriesStore_hpp */
@@ -0,0 +1,256 @@
+//
+//  TimeSeriesStoreTester.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "Development.hpp"
+
+#if defined(MJB_POSIX_API)
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "TimeSeriesStore.hpp"
+#include "Testing.hpp"
+
+Scheduler::Time micros()
+{
+    return 0;
+}
+
+// Temperatures as a DHT22 reads them, to a tenth of a degree, in Kelvin.
+static float Reading(float const celsius)
+{
+    return (std::round(celsius * 10) / 10) + 273.15f;
+}
+
+// Makes samples a minute apart, now and then a second off, of a temperature
+// drifting by a tenth of a degree every few samples, as rooms do.
+static std::vector<TimeSeriesStore::Point> Samples(std::size_t const count, std::mt19937 &random)
+{
+    std::vector<TimeSeriesStore::Point> points(count);
+    TimeSeriesStore::Time time = 1700000000; // Unix seconds, as is best.
+    float celsius = 21;
+
+    for (TimeSeriesStore::Point &point : points)
+    {
+        time += 60 + ((random() % 4)? 0 : ((random() % 2)? 1 : -1));
+        celsius += (random() % 4)? 0 : ((random() % 2)? 0.1f : -0.1f);
+        point = {time, Reading(celsius)};
+    }
+
+    return points;
+}
+
+// Whether querying from and to visits just the samples expected, in order.
+static bool Matches(TimeSeriesStore &store,
+                    TimeSeriesStore::Zone const zone,
+                    std::vector<TimeSeriesStore::Point> const &expected,
+                    TimeSeriesStore::Time const from,
+                    TimeSeriesStore::Time const to)
+{
+    std::size_t index = 0;
+    bool matched = true;
+
+    std::size_t const visited = store.query(zone, TimeSeriesStore::Field::Temperature, from, to,
+                                            [&](TimeSeriesStore::Point const &point) -> bool {
+        matched = matched && (index < expected.size()) &&
+                  (point.time == expected[index].time) && (point.value == expected[index].value);
+        index++;
+        return true;
+    });
+
+    return matched && (visited == expected.size()) && (index == expected.size());
+}
+
+static bool Matches(TimeSeriesStore &store,
+                    TimeSeriesStore::Zone const zone,
+                    std::vector<TimeSeriesStore::Point> const &expected)
+{
+    return Matches(store, zone, expected, expected.front().time, expected.back().time);
+}
+
+// Copies the file, with its first block's header changed by the editor.
+template<typename Editor>
+static void Corrupt(std::string const &source, std::string const &destination, Editor const &editor)
+{
+    FILE * const input = std::fopen(source.c_str(), "rb");
+    std::vector<uint8_t> data(TimeSeriesStore::BlockSize);
+    std::size_t const read = std::fread(data.data(), 1, data.size(), input);
+    std::fclose(input);
+
+    editor(data.data());
+
+    FILE * const output = std::fopen(destination.c_str(), "wb");
+    std::fwrite(data.data(), 1, read, output);
+    std::fclose(output);
+}
+
+int main(int argc, const char * argv[])
+{
+    std::mt19937 random(45);
+
+    char root[] = "/tmp/TimeSeriesStoreTester.XXXXXX";
+    std::string const directory = mkdtemp(root);
+    std::string const path = directory + "/store";
+
+    std::size_t const zones = 100;
+    std::vector<std::vector<TimeSeriesStore::Point>> series;
+    for (std::size_t zone = 0; zone < zones; zone++) series.push_back(Samples(2000, random));
+
+    // Samples are stored as given, compactly, and read back the same, before
+    // and after the store's reopened.
+    {
+        TimeSeriesStore store(path.c_str());
+        MJB_CHECK(store.isOpen());
+
+        bool appended = true;
+        for (std::size_t zone = 0; zone < zones; zone++)
+        {
+            TimeSeriesStore::Series const handle = store.series(static_cast<TimeSeriesStore::Zone>(zone), TimeSeriesStore::Field::Temperature);
+            for (TimeSeriesStore::Point const &point : series[zone]) appended = store.append(handle, point.time, point.value) && appended;
+        }
+        MJB_CHECK(appended);
+
+        // Series only go forward.
+        MJB_CHECK(!store.append(0, TimeSeriesStore::Field::Temperature, series[0].front().time, 0));
+
+        MJB_CHECK(store.flush());
+        MJB_CHECK(store.samples() == zones * 2000);
+
+        double const bytesPerSample = static_cast<double>(store.size()) / store.samples();
+        MJB_CHECK(bytesPerSample < 2);
+        std::fprintf(stderr, "TimeSeriesStore: %.2f bytes/sample\n", bytesPerSample);
+
+        MJB_CHECK(Matches(store, 0, series[0]));
+        MJB_CHECK(Matches(store, 57, series[57]));
+    }
+
+    {
+        TimeSeriesStore store(path.c_str());
+        MJB_CHECK(store.samples() == zones * 2000);
+        MJB_CHECK(Matches(store, 0, series[0]));
+        MJB_CHECK(Matches(store, 99, series[99]));
+
+        // Ranges starting and ending anywhere, on samples or between them,
+        // within blocks or across them, visit just the samples within them.
+        bool ranged = true;
+        for (std::size_t query = 0; query < 1000; query++)
+        {
+            std::vector<TimeSeriesStore::Point> const &points = series[query % zones];
+            TimeSeriesStore::Time const span = points.back().time - points.front().time;
+            TimeSeriesStore::Time const from = points.front().time - 60 + static_cast<TimeSeriesStore::Time>(random() % (span + 120));
+            TimeSeriesStore::Time const to = from + static_cast<TimeSeriesStore::Time>(random() % ((query % 2)? 600 : span));
+
+            std::vector<TimeSeriesStore::Point> within;
+            for (TimeSeriesStore::Point const &point : points)
+            {
+                if ((point.time >= from) && (point.time <= to)) within.push_back(point);
+            }
+
+            ranged = ranged && Matches(store, static_cast<TimeSeriesStore::Zone>(query % zones), within, from, to);
+        }
+
+        // Every sample is found by its own time, those ending blocks included.
+        for (TimeSeriesStore::Point const &point : series[7])
+        {
+            ranged = ranged && Matches(store, 7, {point}, point.time, point.time);
+        }
+        MJB_CHECK(ranged);
+    }
+
+    // Blocks claiming more payload than they hold are skipped on opening;
+    // those claiming more samples than their payload does stop decoding there.
+    std::string const oversized = directory + "/oversized";
+    Corrupt(path, oversized, [](uint8_t * const block) {
+        uint16_t const bits = 0xFFFF;
+        std::memcpy(block + 12, &bits, sizeof(bits)); // BlockHeader::bits
+    });
+    {
+        TimeSeriesStore store(oversized.c_str());
+        MJB_CHECK(store.samples() == 0);
+    }
+
+    std::string const overcounted = directory + "/overcounted";
+    Corrupt(path, overcounted, [](uint8_t * const block) {
+        uint16_t const count = 60000;
+        std::memcpy(block + 10, &count, sizeof(count)); // BlockHeader::count
+    });
+    {
+        TimeSeriesStore store(overcounted.c_str());
+        std::size_t const visited = store.query(0, TimeSeriesStore::Field::Temperature,
+                                                series[0].front().time, series[0].back().time,
+                                                [](TimeSeriesStore::Point const &) -> bool { return true; });
+        MJB_CHECK(visited > 0);
+        MJB_CHECK(visited < series[0].size());
+    }
+
+    // A block that can't be written is kept, along with its samples, and the
+    // sample that found it full isn't stored; retrying duplicates nothing.
+    {
+        TimeSeriesStore store((directory + "/missing/store").c_str());
+        MJB_CHECK(!store.isOpen());
+
+        std::size_t index = 0;
+        while ((index < series[1].size()) && store.append(1, TimeSeriesStore::Field::Temperature, series[1][index].time, series[1][index].value)) index++;
+        MJB_CHECK(index < series[1].size());
+
+        uint64_t const samples = store.samples();
+        MJB_CHECK(samples == index);
+        MJB_CHECK(!store.append(1, TimeSeriesStore::Field::Temperature, series[1][index].time, series[1][index].value));
+        MJB_CHECK(!store.flush());
+        MJB_CHECK(store.samples() == samples);
+
+        std::vector<TimeSeriesStore::Point> const kept(series[1].begin(), series[1].begin() + index);
+        MJB_CHECK(Matches(store, 1, kept));
+    }
+
+    if (Testing::Benchmarking(argc, argv))
+    {
+        std::size_t const benchmarkZones = 1000;
+        std::size_t const samples = 10000;
+        std::vector<TimeSeriesStore::Point> const points = Samples(samples, random);
+        std::string const benchmarkPath = directory + "/benchmark";
+
+        TimeSeriesStore store(benchmarkPath.c_str());
+        std::vector<TimeSeriesStore::Series> handles;
+        for (std::size_t zone = 0; zone < benchmarkZones; zone++)
+        {
+            handles.push_back(store.series(static_cast<TimeSeriesStore::Zone>(zone), TimeSeriesStore::Field::Temperature));
+        }
+
+        // Zones are appended to in turn, as cycles would.
+        std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+        for (TimeSeriesStore::Point const &point : points)
+        {
+            for (TimeSeriesStore::Series const handle : handles) store.append(handle, point.time, point.value);
+        }
+        store.flush();
+        double const seconds = Testing::Seconds(start);
+
+        MJB_CHECK(store.samples() == benchmarkZones * samples);
+        std::fprintf(stderr, "TimeSeriesStore::append: %.1fM samples/s, %.2f bytes/sample\n",
+                     store.samples() / seconds / 1e6,
+                     static_cast<double>(store.size()) / store.samples());
+    }
+
+    for (char const * const file : {"/store", "/oversized", "/overcounted", "/benchmark"}) unlink((directory + file).c_str());
+    MJB_CHECK(!rmdir(directory.c_str()));
+
+    return Testing::Result("TimeSeriesStoreTester");
+}
+
+#else
+
+int main()
+{
+    return 0;
+}
+
+#endif
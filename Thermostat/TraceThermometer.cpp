@@ -0,0 +1,186 @@
+//
+//  TraceThermometer.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "TraceThermometer.hpp"
+
+#if defined(MJB_POSIX_API)
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// =============================================================================
+// TraceThermometer::Trace : Implementation
+// =============================================================================
+uint32_t TraceThermometer::Trace::count() const
+{
+    return _header->count;
+}
+
+Scheduler::Time TraceThermometer::Trace::interval() const
+{
+    return _header->interval;
+}
+
+TraceThermometer::Trace::Record const &TraceThermometer::Trace::record(uint32_t const index) const
+{
+    return _records[index];
+}
+
+std::shared_ptr<TraceThermometer::Trace const> TraceThermometer::Trace::Open(char const * const path)
+{
+    int const descriptor = open(path, O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0) return nullptr;
+
+    struct stat status;
+    if ((fstat(descriptor, &status) < 0) ||
+        (static_cast<std::size_t>(status.st_size) < sizeof(TraceThermometer::Trace::Header)))
+    {
+        close(descriptor);
+        return nullptr;
+    }
+
+    std::size_t const size = status.st_size;
+    void * const mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, descriptor, 0);
+    close(descriptor); // The mapping remains valid on its own.
+
+    if (mapping == MAP_FAILED) return nullptr;
+
+    // Hand the mapping over right away so it's released on any failure below.
+    std::shared_ptr<TraceThermometer::Trace const> const trace(new TraceThermometer::Trace(mapping, size));
+
+    TraceThermometer::Trace::Header const &header = *(trace->_header);
+    if ((std::memcmp(header.magic, "MJBT", sizeof(header.magic)) != 0) ||
+        (header.version != TraceThermometer::Trace::Version) ||
+        (header.count == 0) || (header.interval == 0) ||
+        ((size - sizeof(header)) / sizeof(TraceThermometer::Trace::Record) < header.count))
+    {
+        return nullptr;
+    }
+
+    return trace;
+}
+
+bool TraceThermometer::Trace::Convert(char const * const csvPath,
+                                      char const * const tracePath,
+                                      Scheduler::Time const interval)
+{
+    std::FILE * const csv = std::fopen(csvPath, "r");
+    if (!csv) return false;
+
+    std::FILE * const trace = std::fopen(tracePath, "wb");
+    if (!trace)
+    {
+        std::fclose(csv);
+        return false;
+    }
+
+    TraceThermometer::Trace::Header header = {{'M', 'J', 'B', 'T'}, TraceThermometer::Trace::Version, 0, interval};
+
+    // Reserve the header's space; it's rewritten once the count is known.
+    bool success = std::fwrite(&header, sizeof(header), 1, trace) == 1;
+
+    char line[128];
+    while (success && std::fgets(line, sizeof(line), csv))
+    {
+        char *end = nullptr;
+        double const temperature = std::strtod(line, &end);
+        if (end == line) continue; // Not a reading.
+
+        char * const separator = std::strchr(end, ',');
+        double const humidity = separator? std::strtod(separator + 1, nullptr) : 0;
+
+        // Readings the records can't hold fail the conversion; dropping them
+        // would shift every reading after them in time.
+        if (!(std::fabs(temperature) <= (INT16_MAX / 100.0)) || !((humidity >= 0) && (humidity <= 100)))
+        {
+            success = false;
+            break;
+        }
+
+        TraceThermometer::Trace::Record const record = {
+            static_cast<int16_t>(std::lround(temperature * 100)),
+            static_cast<uint16_t>(std::lround(humidity * 100))
+        };
+
+        success = std::fwrite(&record, sizeof(record), 1, trace) == 1;
+        header.count++;
+    }
+
+    success = success && (header.count > 0) &&
+              (std::fseek(trace, 0, SEEK_SET) == 0) &&
+              (std::fwrite(&header, sizeof(header), 1, trace) == 1);
+
+    std::fclose(csv);
+    return (std::fclose(trace) == 0) && success;
+}
+
+TraceThermometer::Trace::Trace(void * const mapping, std::size_t const size):
+_mapping(mapping),
+_size(size),
+_header(static_cast<TraceThermometer::Trace::Header const *>(mapping)),
+_records(reinterpret_cast<TraceThermometer::Trace::Record const *>(_header + 1))
+{
+    
+}
+
+TraceThermometer::Trace::~Trace()
+{
+    munmap(_mapping, _size);
+}
+
+
+// =============================================================================
+// TraceThermometer : Implementation
+// =============================================================================
+Sensor::Data TraceThermometer::sense()
+{
+    Scheduler::Time const time = micros();
+    _elapsedTime += static_cast<Scheduler::Time>(time - _lastTime); // Wrap-safe.
+    _lastTime = time;
+
+    // The sample served is the one recorded at the current time, wrapping
+    // around to the start of the trace once its end has been reached.
+    uint32_t const index = ((_elapsedTime / _trace->interval()) + _offset) % _trace->count();
+
+    if (index != _index)
+    {
+        TraceThermometer::Trace::Record const &record = _trace->record(index);
+
+        _temperature = Thermometer::TemperatureUnit(static_cast<float>(record.temperature) / 100,
+                                                    Thermometer::TemperatureUnit::Scale::Celsius);
+        _humidity = static_cast<float>(record.humidity) / 100;
+        _index = index;
+        _recordReading();
+    }
+
+    return Sensor::Data();
+}
+
+TraceThermometer::TraceThermometer(std::shared_ptr<Trace const> const &trace, uint32_t const offset):
+Thermometer({}),
+_trace(trace),
+_offset(offset),
+_index(trace->count()), // Out of range, forcing the first read to update.
+_lastTime(micros()),
+_elapsedTime(_lastTime)
+{
+    
+}
+
+TraceThermometer::~TraceThermometer()
+{
+    
+}
+
+#endif
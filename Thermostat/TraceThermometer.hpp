@@ -0,0 +1,107 @@
+//
+//  TraceThermometer.hpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#ifndef TraceThermometer_hpp
+#define TraceThermometer_hpp
+
+#include "Development.hpp"
+
+#if defined(MJB_POSIX_API)
+
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include "Sensor.hpp"
+#include "Scheduler.hpp"
+#include "Thermometer.hpp"
+
+// =============================================================================
+// TraceThermometer : This class replays recorded readings rather than sensing,
+// serving the trace's sample that corresponds to the current scheduler time.
+// Any number of instances may share a single trace, which is memory-mapped
+// and read in place, so instances carry no sample buffers of their own.
+// =============================================================================
+class TraceThermometer : public Thermometer
+{
+public:
+
+    // =========================================================================
+    // Trace: A read-only recording of evenly spaced readings, stored as:
+    // [Header][Record 0][Record 1]...[Record count - 1], in host byte order.
+    // =========================================================================
+    class Trace
+    {
+    public:
+
+        struct Header
+        {
+            char magic[4];      // Always "MJBT".
+            uint32_t version;
+            uint32_t count;     // Number of records following the header.
+            uint32_t interval;  // Microseconds between consecutive records.
+        };
+
+        struct Record
+        {
+            int16_t temperature; // Celsius, x100 scaled.
+            uint16_t humidity;   // Percentage, x100 scaled.
+        };
+
+        static uint32_t const Version = 1;
+
+        uint32_t count() const;
+        Scheduler::Time interval() const;
+
+        Record const &record(uint32_t const index) const;
+
+        // Maps the trace at path, returning null if it's missing or malformed.
+        static std::shared_ptr<Trace const> Open(char const * const path);
+
+        // Converts CSV lines of "temperature,humidity" (Celsius, percentage),
+        // recorded interval microseconds apart, into a trace. Lines that don't
+        // begin with a number, such as column titles, are skipped; those the
+        // records can't hold (past ±327.67C, or 0 to 100%) fail the conversion.
+        static bool Convert(char const * const csvPath,
+                            char const * const tracePath,
+                            Scheduler::Time const interval);
+
+        ~Trace();
+
+    protected:
+
+        void *_mapping;
+        std::size_t _size;
+
+        Header const *_header;
+        Record const *_records;
+
+        Trace(void * const mapping, std::size_t const size);
+    };
+
+    Sensor::Data sense();
+
+    // The offset shifts the instance along the trace, so that instances
+    // sharing a trace don't all report identical readings at once.
+    TraceThermometer(std::shared_ptr<Trace const> const &trace, uint32_t const offset = 0);
+    virtual ~TraceThermometer();
+
+protected:
+
+    std::shared_ptr<Trace const> const _trace;
+    uint32_t const _offset;
+    uint32_t _index;
+
+    // Scheduler time wraps every ~71 minutes, traces may span much longer;
+    // elapsed time is therefore accumulated from the scheduler time deltas.
+    Scheduler::Time _lastTime;
+    uint64_t _elapsedTime;
+};
+
+#endif
+
+#endif /* TraceThermometer_hpp */
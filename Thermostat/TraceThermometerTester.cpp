@@ -0,0 +1,189 @@
+//
+//  TraceThermometerTester.cpp
+//  Thermostat
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 agent. All rights reserved.
+//
+
+#include "Development.hpp"
+
+#if defined(MJB_POSIX_API)
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "TraceThermometer.hpp"
+#include "Testing.hpp"
+
+static Scheduler::Time now = 0;
+
+Scheduler::Time micros()
+{
+    return now;
+}
+
+typedef TraceThermometer::Trace Trace;
+
+// Writes the text to the path, whole.
+static bool Write(std::string const &path, std::string const &text)
+{
+    std::FILE * const file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+
+    bool const written = std::fwrite(text.data(), 1, text.size(), file) == text.size();
+    return (std::fclose(file) == 0) && written;
+}
+
+static bool Near(float const value, float const expected)
+{
+    return std::fabs(value - expected) < 0.006f;
+}
+
+int main(int argc, const char * argv[])
+{
+    char root[] = "/tmp/TraceThermometerTester.XXXXXX";
+    std::string const directory = mkdtemp(root);
+    std::string const csv = directory + "/trace.csv";
+    std::string const path = directory + "/trace";
+
+    // Readings converted from CSV, titles and all, are read back as recorded,
+    // to the hundredth.
+    std::mt19937 random(31);
+    std::vector<std::pair<float, float>> readings;
+    std::string text = "temperature,humidity\n";
+
+    for (std::size_t index = 0; index < 500; index++)
+    {
+        float const celsius = -40.0f + ((random() % 12000) / 100.0f);
+        float const humidity = (random() % 10001) / 100.0f;
+        readings.push_back(std::make_pair(celsius, humidity));
+
+        char line[64];
+        std::snprintf(line, sizeof(line), "%.2f,%.2f\n", celsius, humidity);
+        text += line;
+    }
+
+    MJB_CHECK(Write(csv, text));
+    MJB_CHECK(Trace::Convert(csv.c_str(), path.c_str(), 1000000));
+
+    std::shared_ptr<Trace const> const trace = Trace::Open(path.c_str());
+    MJB_CHECK(trace && (trace->count() == readings.size()) && (trace->interval() == 1000000));
+    if (!trace) return Testing::Result("TraceThermometerTester");
+
+    bool recorded = true;
+    for (uint32_t index = 0; index < trace->count(); index++)
+    {
+        recorded = recorded && Near(trace->record(index).temperature / 100.0f, readings[index].first) &&
+                               Near(trace->record(index).humidity / 100.0f, readings[index].second);
+    }
+    MJB_CHECK(recorded);
+
+    // Thermometers replay the reading recorded at the time, offset along the
+    // trace, wrapping around past its end, and past the clock's overflow;
+    // every new reading is counted as one.
+    std::size_t const first = (~static_cast<Scheduler::Time>(0) / 1000000) - 100;
+    now = first * 1000000;
+
+    TraceThermometer thermometer(trace);
+    TraceThermometer shifted(trace, 7);
+    bool replayed = true;
+
+    for (std::size_t second = first; second < (first + (3 * readings.size())); second++)
+    {
+        thermometer.sense();
+        shifted.sense();
+
+        std::pair<float, float> const &reading = readings[second % readings.size()];
+        std::pair<float, float> const &offset = readings[(second + 7) % readings.size()];
+
+        replayed = replayed &&
+                   Near(static_cast<float>(thermometer.temperature().value(Thermometer::TemperatureUnit::Scale::Celsius)), reading.first) &&
+                   Near(static_cast<float>(thermometer.humidity()), reading.second) &&
+                   Near(static_cast<float>(shifted.temperature().value(Thermometer::TemperatureUnit::Scale::Celsius)), offset.first);
+
+        now += 1000000;
+    }
+
+    MJB_CHECK(replayed);
+    MJB_CHECK(thermometer.health().readings == (3 * readings.size()));
+
+    // Sensing again within an interval reads nothing new.
+    thermometer.sense();
+    now += 500000;
+    thermometer.sense();
+    MJB_CHECK(thermometer.health().readings == ((3 * readings.size()) + 1));
+
+    // Traces that are missing, not traces, or shorter than they claim, are
+    // turned away.
+    MJB_CHECK(!Trace::Open((directory + "/missing").c_str()));
+    MJB_CHECK(!Trace::Open(csv.c_str()));
+
+    std::string const truncated = directory + "/truncated";
+    std::FILE * const source = std::fopen(path.c_str(), "rb");
+    std::vector<char> bytes(sizeof(Trace::Header) + (10 * sizeof(Trace::Record)));
+    MJB_CHECK(source && (std::fread(bytes.data(), 1, bytes.size(), source) == bytes.size()));
+    if (source) std::fclose(source);
+    MJB_CHECK(Write(truncated, std::string(bytes.data(), bytes.size())));
+    MJB_CHECK(!Trace::Open(truncated.c_str()));
+
+    // Readings the records can't hold fail the conversion, as do CSVs with no
+    // readings at all.
+    std::string const rejected = directory + "/rejected";
+    for (char const * const rows : {"21.5,40\n400,40\n", "21.5,40\n-330,40\n", "21.5,700\n",
+                                    "21.5,-1\n", "nan,40\n", "title\n"})
+    {
+        MJB_CHECK(Write(csv, rows));
+        MJB_CHECK(!Trace::Convert(csv.c_str(), rejected.c_str(), 1000000));
+        MJB_CHECK(!Trace::Open(rejected.c_str()));
+    }
+
+    MJB_CHECK(Write(csv, "-327.67,0\n327.67,100\n"));
+    MJB_CHECK(Trace::Convert(csv.c_str(), rejected.c_str(), 1000000));
+
+    // Replay rate for a fleet of thermometers sharing a trace.
+    if (Testing::Benchmarking(argc, argv))
+    {
+        std::size_t const thermometers = 10000;
+        std::size_t const rounds = 1000;
+
+        std::vector<std::shared_ptr<TraceThermometer>> fleet;
+        for (std::size_t index = 0; index < thermometers; index++)
+        {
+            fleet.push_back(std::make_shared<TraceThermometer>(trace, static_cast<uint32_t>(index)));
+        }
+
+        float checksum = 0;
+        std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+        for (std::size_t round = 0; round < rounds; round++)
+        {
+            now += 1000000;
+            for (std::shared_ptr<TraceThermometer> const &member : fleet)
+            {
+                member->sense();
+                checksum += static_cast<float>(member->humidity());
+            }
+        }
+        double const seconds = Testing::Seconds(start);
+
+        std::fprintf(stderr, "TraceThermometer::sense: %.1f M samples/s, %zu thermometers (%g)\n",
+                     (thermometers * rounds) / seconds / 1e6, thermometers, checksum);
+    }
+
+    for (std::string const &file : {csv, path, truncated, rejected}) unlink(file.c_str());
+    rmdir(directory.c_str());
+
+    return Testing::Result("TraceThermometerTester");
+}
+
+#else
+
+int main()
+{
+    return 0;
+}
+
+#endif